@@ -0,0 +1,819 @@
+/* glslcommon_bench: microbenchmarks for layout queries, struct layout, member ordering, packing, layout conversion, vertex streams, quantization, uniform ring allocation and storage array appends
+ *
+ * $ glslcommon_bench [--filter <substring>] [--output <file>] [--baseline <file>] [--tolerance <percent>]
+ *
+ * Results are written as CSV (to stdout, and to --output if given):
+ *   benchmark,ns_per_item,items_per_iteration,iterations
+ * A file written by --output can later be passed as --baseline; every benchmark which got slower than its baseline
+ * by more than --tolerance percent (10 by default) is reported and the exit code is 1, so it can gate CI runs.
+ * Run a release build (-DGLSLCOM_RELEASE), debug builds bounds check every table lookup. */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#endif
+
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_layout_cache.h>
+#include <glslcommon/glsl_member_order.h>
+#include <glslcommon/glsl_pack.h>
+#include <glslcommon/glsl_copy_plan.h>
+#include <glslcommon/glsl_layout_convert.h>
+#include <glslcommon/glsl_vertex_stream.h>
+#include <glslcommon/glsl_quantize.h>
+#include <glslcommon/glsl_uniform_ring.h>
+#include <glslcommon/glsl_storage_array.h>
+#include <glslcommon/glsl_layout_migration.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <time.h>
+#endif
+
+/* each benchmark is sampled this many times and the fastest sample is reported, which filters out scheduling noise */
+#define BENCH_SAMPLE_COUNT 7
+/* iterations of a sample are doubled until one sample takes at least this long */
+#define BENCH_MIN_SAMPLE_NS 20000000ull
+#define BENCH_MAX_RESULTS 128
+
+#define QUERY_COUNT 4096
+#define PACK_ELEMENT_COUNT 4096
+#define PACK_MATRIX_COUNT 1024
+#define CONVERT_INSTANCE_COUNT 64
+#define VERTEX_COUNT 65536
+#define QUANTIZE_COMPONENT_COUNT 65536
+#define RING_ALLOC_COUNT 4096
+#define STORAGE_ARRAY_ELEMENT_COUNT 65536
+#define MIGRATION_MEMBER_COUNT 32
+#define MIGRATION_INSTANCE_COUNT 1024
+
+static u64 get_time_ns(void)
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = { 0 };
+	LARGE_INTEGER counter;
+	if(frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (u64)((f64)counter.QuadPart * 1e9 / (f64)frequency.QuadPart);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+/* results of the benchmarked calls are folded into this so that the compiler can't drop them */
+static volatile u32 bench_sink;
+
+typedef void (*bench_fn_t)(void* user_data, u32 iterations);
+
+typedef struct bench_result_t
+{
+	char name[64];
+	f64 ns_per_item;
+	u32 items_per_iteration;
+	u32 iterations;
+} bench_result_t;
+
+typedef struct bench_context_t
+{
+	const char* filter;
+	FILE* output;
+	bench_result_t results[BENCH_MAX_RESULTS];
+	u32 result_count;
+} bench_context_t;
+
+static void bench_run(bench_context_t* context, const char* name, bench_fn_t fn, void* user_data, u32 items_per_iteration)
+{
+	if((context->filter != NULL) && (strstr(name, context->filter) == NULL))
+		return;
+
+	/* warm up the caches and find how many iterations make a sample long enough to time reliably */
+	u32 iterations = 1;
+	for(;;)
+	{
+		u64 start = get_time_ns();
+		fn(user_data, iterations);
+		if(((get_time_ns() - start) >= BENCH_MIN_SAMPLE_NS) || (iterations >= (1u << 30)))
+			break;
+		iterations *= 2;
+	}
+
+	u64 best_ns = ~0ull;
+	for(u32 i = 0; i < BENCH_SAMPLE_COUNT; i++)
+	{
+		u64 start = get_time_ns();
+		fn(user_data, iterations);
+		u64 elapsed = get_time_ns() - start;
+		if(elapsed < best_ns)
+			best_ns = elapsed;
+	}
+
+	if(context->result_count >= BENCH_MAX_RESULTS)
+	{
+		fprintf(stderr, "[GLSLCommon] Too many benchmarks, increase BENCH_MAX_RESULTS\n");
+		exit(2);
+	}
+	bench_result_t* result = &context->results[context->result_count++];
+	snprintf(result->name, sizeof(result->name), "%s", name);
+	result->ns_per_item = (f64)best_ns / ((f64)iterations * items_per_iteration);
+	result->items_per_iteration = items_per_iteration;
+	result->iterations = iterations;
+
+	printf("%s,%.4f,%u,%u\n", result->name, result->ns_per_item, items_per_iteration, iterations);
+	fflush(stdout);
+	if(context->output != NULL)
+		fprintf(context->output, "%s,%.4f,%u,%u\n", result->name, result->ns_per_item, items_per_iteration, iterations);
+}
+
+/* deterministic pseudo random numbers, so every run (and every machine) benchmarks the same inputs */
+static u32 random_next(u32* state)
+{
+	*state = *state * 1664525u + 1013904223u;
+	return *state >> 8;
+}
+
+/* member types weighted roughly like real uniform and storage blocks */
+static const glsl_type_t block_member_types[] =
+{
+	GLSL_TYPE_FLOAT, GLSL_TYPE_FLOAT, GLSL_TYPE_FLOAT, GLSL_TYPE_INT, GLSL_TYPE_UINT,
+	GLSL_TYPE_VEC2, GLSL_TYPE_VEC3, GLSL_TYPE_VEC3, GLSL_TYPE_VEC4, GLSL_TYPE_VEC4, GLSL_TYPE_VEC4,
+	GLSL_TYPE_IVEC2, GLSL_TYPE_IVEC4, GLSL_TYPE_UVEC4, GLSL_TYPE_MAT3, GLSL_TYPE_MAT4, GLSL_TYPE_MAT4
+};
+
+#define BLOCK_MEMBER_TYPE_COUNT (sizeof(block_member_types) / sizeof(block_member_types[0]))
+
+/* every 8th member (on average) is an array of 2 to 8 elements */
+static void generate_block(glsl_type_layout_traits_t* out_traits, u32 count, u32 seed)
+{
+	u32 state = seed;
+	for(u32 i = 0; i < count; i++)
+	{
+		glsl_type_layout_traits_t* traits = &out_traits[i];
+		memset(traits, 0, sizeof(glsl_type_layout_traits_t));
+		traits->type = block_member_types[random_next(&state) % BLOCK_MEMBER_TYPE_COUNT];
+		traits->is_array = (random_next(&state) % 8) == 0;
+		traits->array_length = traits->is_array ? (2 + random_next(&state) % 7) : 0;
+	}
+}
+
+/* ---------------------- type queries ---------------------- */
+
+typedef struct query_data_t
+{
+	glsl_type_t types[QUERY_COUNT];
+	glsl_memory_layout_t layouts[QUERY_COUNT];
+	bool is_arrays[QUERY_COUNT];
+	u32 out_values[QUERY_COUNT];
+} query_data_t;
+
+static void bench_alignof_glsl_type(void* user_data, u32 iterations)
+{
+	query_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+		for(u32 j = 0; j < QUERY_COUNT; j++)
+			sum += data->is_arrays[j] ? alignof_glsl_type_array(data->types[j], data->layouts[j]) : alignof_glsl_type(data->types[j], data->layouts[j]);
+	bench_sink += sum;
+}
+
+static void bench_sizeof_glsl_type(void* user_data, u32 iterations)
+{
+	query_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+		for(u32 j = 0; j < QUERY_COUNT; j++)
+			sum += sizeof_glsl_type(data->types[j], data->layouts[j]);
+	bench_sink += sum;
+}
+
+static void bench_vkformatof_glsl_type(void* user_data, u32 iterations)
+{
+	query_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+		for(u32 j = 0; j < QUERY_COUNT; j++)
+			sum += vkformatof_glsl_type(data->types[j]);
+	bench_sink += sum;
+}
+
+static void bench_alignof_glsl_types(void* user_data, u32 iterations)
+{
+	query_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		alignof_glsl_types(data->types, QUERY_COUNT, GLSL_STD140, data->out_values);
+	bench_sink += data->out_values[QUERY_COUNT - 1];
+}
+
+static void bench_sizeof_glsl_types(void* user_data, u32 iterations)
+{
+	query_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		sizeof_glsl_types(data->types, QUERY_COUNT, GLSL_STD140, data->out_values);
+	bench_sink += data->out_values[QUERY_COUNT - 1];
+}
+
+static void bench_vkformatof_glsl_types(void* user_data, u32 iterations)
+{
+	query_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		vkformatof_glsl_types(data->types, QUERY_COUNT, data->out_values);
+	bench_sink += data->out_values[QUERY_COUNT - 1];
+}
+
+/* ---------------------- struct layout ---------------------- */
+
+typedef struct block_data_t
+{
+	glsl_memory_layout_t layout;
+	u32 member_count;
+	glsl_type_layout_traits_t* traits;
+	glsl_member_layout_t* members;
+	glsl_struct_layout_t struct_layout;
+	/* output of glsl_optimize_member_order() */
+	u32* order;
+	glsl_layout_cache_t* cache;
+	glsl_copy_plan_t* plan;
+	glsl_layout_converter_t* converter;
+	/* tightly packed source data, and laid out destination data */
+	u8* src;
+	u8* dst;
+	u8* converted;
+} block_data_t;
+
+static void bench_layoutof_glsl_type_struct(void* user_data, u32 iterations)
+{
+	block_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+		sum += layoutof_glsl_type_struct(data->traits, data->member_count, data->layout, data->members).size;
+	bench_sink += sum;
+}
+
+static void bench_glsl_layout_cache_get(void* user_data, u32 iterations)
+{
+	block_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+		sum += glsl_layout_cache_get(data->cache, data->traits, data->member_count, data->layout)->struct_layout.size;
+	bench_sink += sum;
+}
+
+static void bench_glsl_optimize_member_order(void* user_data, u32 iterations)
+{
+	block_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+		sum += glsl_optimize_member_order(data->traits, data->member_count, data->layout, data->order, NULL).size;
+	bench_sink += sum;
+}
+
+static void bench_glsl_pack_struct(void* user_data, u32 iterations)
+{
+	block_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+		sum += glsl_pack_struct(data->dst, data->traits, data->members, data->member_count, &data->struct_layout, data->src);
+	bench_sink += sum;
+}
+
+static void bench_glsl_copy_plan_execute(void* user_data, u32 iterations)
+{
+	block_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_copy_plan_execute(data->plan, data->dst, data->src);
+	bench_sink += data->dst[0];
+}
+
+static void bench_glsl_layout_converter_convert(void* user_data, u32 iterations)
+{
+	block_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		bench_sink += ((const u8*)glsl_layout_converter_convert(data->converter, data->converted, data->dst, CONVERT_INSTANCE_COUNT))[0];
+}
+
+/* the block is laid out with 'layout', packing/copying reads it tightly packed and conversion converts it into 'convert_layout' */
+static block_data_t* block_data_create(u32 member_count, u32 seed, glsl_memory_layout_t layout, glsl_memory_layout_t convert_layout)
+{
+	block_data_t* data = calloc(1, sizeof(block_data_t));
+	data->layout = layout;
+	data->member_count = member_count;
+	data->traits = malloc(sizeof(glsl_type_layout_traits_t) * member_count);
+	data->members = malloc(sizeof(glsl_member_layout_t) * member_count);
+	data->order = malloc(sizeof(u32) * member_count);
+	generate_block(data->traits, member_count, seed);
+	data->struct_layout = layoutof_glsl_type_struct(data->traits, member_count, layout, data->members);
+
+	glsl_copy_source_member_t* src_members = malloc(sizeof(glsl_copy_source_member_t) * member_count);
+	u32 src_size = 0;
+	for(u32 i = 0; i < member_count; i++)
+	{
+		u32 element_count = data->traits[i].is_array ? data->traits[i].array_length : 1;
+		src_members[i].offset = src_size;
+		src_members[i].row_stride = 0;
+		src_size += sizeof_glsl_type(data->traits[i].type, GLSL_SCALAR) * element_count;
+	}
+	data->plan = glsl_copy_plan_create(data->traits, data->members, src_members, member_count, NULL);
+	free(src_members);
+
+	data->cache = glsl_layout_cache_create(16, NULL);
+	glsl_layout_cache_get(data->cache, data->traits, member_count, layout);
+	data->converter = glsl_layout_converter_create(data->traits, member_count, layout, convert_layout, NULL);
+
+	data->src = malloc(src_size);
+	for(u32 i = 0; i < src_size; i++)
+		data->src[i] = (u8)i;
+	data->dst = calloc(CONVERT_INSTANCE_COUNT, data->struct_layout.array_stride);
+	data->converted = calloc(CONVERT_INSTANCE_COUNT, data->converter->dst_struct_layout.array_stride);
+	for(u32 i = 0; i < CONVERT_INSTANCE_COUNT; i++)
+		glsl_copy_plan_execute(data->plan, data->dst + i * data->struct_layout.array_stride, data->src);
+	return data;
+}
+
+static void block_data_destroy(block_data_t* data)
+{
+	glsl_layout_converter_destroy(data->converter);
+	glsl_layout_cache_destroy(data->cache);
+	glsl_copy_plan_destroy(data->plan);
+	free(data->converted);
+	free(data->dst);
+	free(data->src);
+	free(data->order);
+	free(data->members);
+	free(data->traits);
+	free(data);
+}
+
+/* ---------------------- strided packing ---------------------- */
+
+typedef struct strided_data_t
+{
+	u32 element_size;
+	u8* tight;
+	u8* strided;
+} strided_data_t;
+
+static void bench_glsl_pack_strided(void* user_data, u32 iterations)
+{
+	strided_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_pack_strided(data->strided, 16, data->tight, data->element_size, PACK_ELEMENT_COUNT);
+	bench_sink += data->strided[0];
+}
+
+static void bench_glsl_unpack_strided(void* user_data, u32 iterations)
+{
+	strided_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_unpack_strided(data->tight, data->strided, 16, data->element_size, PACK_ELEMENT_COUNT);
+	bench_sink += data->tight[0];
+}
+
+typedef struct matrix_data_t
+{
+	glsl_type_t type;
+	bool is_row_major;
+	u32 stride;
+	f32* src;
+	u8* dst;
+} matrix_data_t;
+
+/* a skinning palette of row major CPU matrices into a std140 array */
+static void bench_glsl_pack_matrices(void* user_data, u32 iterations)
+{
+	matrix_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_pack_matrices(data->dst, data->stride, data->src, data->type, data->is_row_major, GLSL_STD140, PACK_MATRIX_COUNT);
+	bench_sink += data->dst[0];
+}
+
+/* ---------------------- vertex streams ---------------------- */
+
+typedef struct vertex_data_t
+{
+	glsl_vertex_stream_t streams[3];
+	u32 stride;
+	u8* vertices;
+} vertex_data_t;
+
+static void bench_glsl_vertex_interleave(void* user_data, u32 iterations)
+{
+	vertex_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_vertex_interleave(data->vertices, data->stride, data->streams, 3, VERTEX_COUNT, NULL);
+	bench_sink += data->vertices[0];
+}
+
+static void bench_glsl_vertex_deinterleave(void* user_data, u32 iterations)
+{
+	vertex_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_vertex_deinterleave(data->vertices, data->stride, data->streams, 3, VERTEX_COUNT, NULL);
+	bench_sink += ((const u8*)data->streams[0].data)[0];
+}
+
+/* ---------------------- quantization ---------------------- */
+
+typedef struct quantize_data_t
+{
+	glsl_component_encoding_t encoding;
+	f32* floats;
+	u8* encoded;
+} quantize_data_t;
+
+static void bench_glsl_quantize(void* user_data, u32 iterations)
+{
+	quantize_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_quantize(data->encoded, data->floats, QUANTIZE_COMPONENT_COUNT, data->encoding);
+	bench_sink += data->encoded[0];
+}
+
+static void bench_glsl_dequantize(void* user_data, u32 iterations)
+{
+	quantize_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_dequantize(data->floats, data->encoded, QUANTIZE_COMPONENT_COUNT, data->encoding);
+	bench_sink += (u32)data->floats[0];
+}
+
+/* ---------------------- uniform ring ---------------------- */
+
+typedef struct ring_data_t
+{
+	glsl_uniform_ring_t* ring;
+	glsl_uniform_block_alloc_t block_alloc;
+	u32 frame;
+} ring_data_t;
+
+/* one frame of per-draw blocks on one thread */
+static void bench_glsl_uniform_ring_alloc(void* user_data, u32 iterations)
+{
+	ring_data_t* data = user_data;
+	u32 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+	{
+		glsl_uniform_ring_begin_frame(data->ring, data->frame++ % 3);
+		glsl_uniform_ring_chunk_t chunk;
+		glsl_uniform_ring_chunk_reset(&chunk, data->ring);
+		for(u32 j = 0; j < RING_ALLOC_COUNT; j++)
+		{
+			u32 offset;
+			glsl_uniform_ring_alloc_block(&chunk, data->block_alloc, &offset);
+			sum += offset;
+		}
+	}
+	bench_sink += sum;
+}
+
+/* ---------------------- storage arrays ---------------------- */
+
+typedef struct storage_array_data_t
+{
+	glsl_storage_array_layout_t layout;
+	void* buffer;
+	u64 buffer_size;
+	const void* src;
+	u32 src_stride;
+} storage_array_data_t;
+
+/* one frame of elements appended in batches of 1024 */
+static void bench_glsl_storage_array_append(void* user_data, u32 iterations)
+{
+	storage_array_data_t* data = user_data;
+	u64 sum = 0;
+	for(u32 i = 0; i < iterations; i++)
+	{
+		glsl_storage_array_writer_t writer;
+		glsl_storage_array_writer_init(&writer, &data->layout, data->buffer, data->buffer_size, NULL);
+		for(u32 j = 0; j < STORAGE_ARRAY_ELEMENT_COUNT; j += 1024)
+			sum += glsl_storage_array_append(&writer, (const u8*)data->src + (u64)j * data->src_stride, data->src_stride, 1024);
+	}
+	bench_sink += (u32)sum;
+}
+
+/* ---------------------- layout migration ---------------------- */
+
+typedef struct migration_data_t
+{
+	glsl_layout_migration_t* migration;
+	/* migrates back from the new layout to the old one */
+	glsl_layout_migration_t* reverse_migration;
+	void* src;
+	void* dst;
+	u32 stride;
+} migration_data_t;
+
+static void bench_glsl_layout_migration_execute(void* user_data, u32 iterations)
+{
+	migration_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_layout_migration_execute(data->migration, data->dst, data->stride, data->src, data->stride, MIGRATION_INSTANCE_COUNT);
+	bench_sink += ((const u8*)data->dst)[0];
+}
+
+/* migrates back and forth, so the instances are in the layout each iteration expects */
+static void bench_glsl_layout_migration_execute_in_place(void* user_data, u32 iterations)
+{
+	migration_data_t* data = user_data;
+	for(u32 i = 0; i < iterations; i++)
+		glsl_layout_migration_execute_in_place((i & 1) ? data->reverse_migration : data->migration, data->src, data->stride, data->stride, MIGRATION_INSTANCE_COUNT);
+	bench_sink += ((const u8*)data->src)[0];
+}
+
+/* ---------------------- baseline comparison ---------------------- */
+
+/* returns the number of regressions, or -1 if the baseline couldn't be read */
+static s32 compare_with_baseline(const bench_context_t* context, const char* baseline_path, f64 tolerance_percent)
+{
+	FILE* file = fopen(baseline_path, "r");
+	if(file == NULL)
+	{
+		fprintf(stderr, "[GLSLCommon] Failed to open baseline file %s\n", baseline_path);
+		return -1;
+	}
+
+	s32 regression_count = 0;
+	char line[256];
+	fprintf(stderr, "\n%-48s %12s %12s %9s\n", "benchmark", "baseline ns", "current ns", "change");
+	while(fgets(line, sizeof(line), file) != NULL)
+	{
+		char* comma = strchr(line, ',');
+		if(comma == NULL)
+			continue;
+		*comma = 0;
+		char* end = NULL;
+		f64 baseline_ns = strtod(comma + 1, &end);
+		/* skips the header and malformed lines */
+		if((end == (comma + 1)) || (baseline_ns <= 0))
+			continue;
+
+		for(u32 i = 0; i < context->result_count; i++)
+		{
+			const bench_result_t* result = &context->results[i];
+			if(strcmp(result->name, line) != 0)
+				continue;
+			f64 change_percent = (result->ns_per_item - baseline_ns) * 100.0 / baseline_ns;
+			bool is_regression = change_percent > tolerance_percent;
+			fprintf(stderr, "%-48s %12.4f %12.4f %+8.1f%%%s\n", result->name, baseline_ns, result->ns_per_item, change_percent, is_regression ? "  REGRESSION" : "");
+			if(is_regression)
+				regression_count++;
+			break;
+		}
+	}
+	fclose(file);
+	fprintf(stderr, "%d regression(s) beyond %.1f%%\n", regression_count, tolerance_percent);
+	return regression_count;
+}
+
+int main(int argc, char** argv)
+{
+	static bench_context_t context;
+	const char* output_path = NULL;
+	const char* baseline_path = NULL;
+	f64 tolerance_percent = 10.0;
+	for(int i = 1; i < argc; i++)
+	{
+		if((strcmp(argv[i], "--filter") == 0) && ((i + 1) < argc))
+			context.filter = argv[++i];
+		else if((strcmp(argv[i], "--output") == 0) && ((i + 1) < argc))
+			output_path = argv[++i];
+		else if((strcmp(argv[i], "--baseline") == 0) && ((i + 1) < argc))
+			baseline_path = argv[++i];
+		else if((strcmp(argv[i], "--tolerance") == 0) && ((i + 1) < argc))
+			tolerance_percent = atof(argv[++i]);
+		else
+		{
+			fprintf(stderr, "usage: %s [--filter <substring>] [--output <file>] [--baseline <file>] [--tolerance <percent>]\n", argv[0]);
+			return 2;
+		}
+	}
+	if(output_path != NULL)
+	{
+		context.output = fopen(output_path, "w");
+		if(context.output == NULL)
+		{
+			fprintf(stderr, "[GLSLCommon] Failed to open output file %s\n", output_path);
+			return 2;
+		}
+		fprintf(context.output, "benchmark,ns_per_item,items_per_iteration,iterations\n");
+	}
+	printf("benchmark,ns_per_item,items_per_iteration,iterations\n");
+
+	/* type queries over a random mix of types, layouts and arrayness */
+	query_data_t* query_data = malloc(sizeof(query_data_t));
+	u32 state = 1;
+	for(u32 i = 0; i < QUERY_COUNT; i++)
+	{
+		query_data->types[i] = block_member_types[random_next(&state) % BLOCK_MEMBER_TYPE_COUNT];
+		query_data->layouts[i] = (glsl_memory_layout_t)(random_next(&state) % GLSL_MEMORY_LAYOUT_MAX);
+		query_data->is_arrays[i] = (random_next(&state) % 4) == 0;
+	}
+	bench_run(&context, "alignof_glsl_type", bench_alignof_glsl_type, query_data, QUERY_COUNT);
+	bench_run(&context, "sizeof_glsl_type", bench_sizeof_glsl_type, query_data, QUERY_COUNT);
+	bench_run(&context, "vkformatof_glsl_type", bench_vkformatof_glsl_type, query_data, QUERY_COUNT);
+	bench_run(&context, "alignof_glsl_types", bench_alignof_glsl_types, query_data, QUERY_COUNT);
+	bench_run(&context, "sizeof_glsl_types", bench_sizeof_glsl_types, query_data, QUERY_COUNT);
+	bench_run(&context, "vkformatof_glsl_types", bench_vkformatof_glsl_types, query_data, QUERY_COUNT);
+	free(query_data);
+
+	/* a per-draw UBO, a light list sized block and a large material block; items are members */
+	static const struct { const char* name; u32 member_count; } block_sets[] = { { "ubo8", 8 }, { "lights32", 32 }, { "material200", 200 } };
+	static const struct { const char* name; glsl_memory_layout_t layout; glsl_memory_layout_t convert_layout; } layouts[] =
+	{
+		{ "std140", GLSL_STD140, GLSL_STD430 },
+		{ "std430", GLSL_STD430, GLSL_STD140 },
+		{ "scalar", GLSL_SCALAR, GLSL_STD430 }
+	};
+	char name[64];
+	for(u32 i = 0; i < (sizeof(block_sets) / sizeof(block_sets[0])); i++)
+	{
+		for(u32 j = 0; j < (sizeof(layouts) / sizeof(layouts[0])); j++)
+		{
+			block_data_t* data = block_data_create(block_sets[i].member_count, 17 + i, layouts[j].layout, layouts[j].convert_layout);
+			snprintf(name, sizeof(name), "layoutof_glsl_type_struct/%s/%s", block_sets[i].name, layouts[j].name);
+			bench_run(&context, name, bench_layoutof_glsl_type_struct, data, data->member_count);
+			snprintf(name, sizeof(name), "glsl_layout_cache_get/%s/%s", block_sets[i].name, layouts[j].name);
+			bench_run(&context, name, bench_glsl_layout_cache_get, data, data->member_count);
+			snprintf(name, sizeof(name), "glsl_optimize_member_order/%s/%s", block_sets[i].name, layouts[j].name);
+			bench_run(&context, name, bench_glsl_optimize_member_order, data, data->member_count);
+			snprintf(name, sizeof(name), "glsl_pack_struct/%s/%s", block_sets[i].name, layouts[j].name);
+			bench_run(&context, name, bench_glsl_pack_struct, data, data->member_count);
+			snprintf(name, sizeof(name), "glsl_copy_plan_execute/%s/%s", block_sets[i].name, layouts[j].name);
+			bench_run(&context, name, bench_glsl_copy_plan_execute, data, data->member_count);
+			/* a block laid out identically in both layouts converts nothing, such a row would only measure the identity check */
+			if(!data->converter->is_identity)
+			{
+				snprintf(name, sizeof(name), "glsl_layout_converter_convert/%s/%s", block_sets[i].name, layouts[j].name);
+				bench_run(&context, name, bench_glsl_layout_converter_convert, data, data->member_count * CONVERT_INSTANCE_COUNT);
+			}
+			block_data_destroy(data);
+		}
+	}
+
+	/* float[], vec2[] and vec3[] into (and out of) 16 byte strides, std140 arrays and matrix columns; items are elements */
+	static const struct { const char* name; u32 element_size; } strided_sets[] = { { "float", 4 }, { "vec2", 8 }, { "vec3", 12 } };
+	for(u32 i = 0; i < (sizeof(strided_sets) / sizeof(strided_sets[0])); i++)
+	{
+		strided_data_t data = { strided_sets[i].element_size, calloc(PACK_ELEMENT_COUNT, 16), calloc(PACK_ELEMENT_COUNT, 16) };
+		snprintf(name, sizeof(name), "glsl_pack_strided/%s", strided_sets[i].name);
+		bench_run(&context, name, bench_glsl_pack_strided, &data, PACK_ELEMENT_COUNT);
+		snprintf(name, sizeof(name), "glsl_unpack_strided/%s", strided_sets[i].name);
+		bench_run(&context, name, bench_glsl_unpack_strided, &data, PACK_ELEMENT_COUNT);
+		free(data.tight);
+		free(data.strided);
+	}
+
+	/* mat4 and mat3x4 palettes transposed into column major, and written into row_major members; items are matrices */
+	static const struct { const char* name; glsl_type_t type; bool is_row_major; } matrix_sets[] =
+	{
+		{ "mat4", GLSL_TYPE_MAT4, false }, { "mat3x4", GLSL_TYPE_MAT3X4, false }, { "row_major_mat3x4", GLSL_TYPE_MAT3X4, true }
+	};
+	for(u32 i = 0; i < (sizeof(matrix_sets) / sizeof(matrix_sets[0])); i++)
+	{
+		matrix_data_t data = { matrix_sets[i].type, matrix_sets[i].is_row_major, 0, calloc(PACK_MATRIX_COUNT, 64), calloc(PACK_MATRIX_COUNT, 64) };
+		data.stride = strideof_glsl_type_array(layout_typeof_glsl_type(data.type, data.is_row_major), GLSL_STD140);
+		snprintf(name, sizeof(name), "glsl_pack_matrices/%s", matrix_sets[i].name);
+		bench_run(&context, name, bench_glsl_pack_matrices, &data, PACK_MATRIX_COUNT);
+		free(data.src);
+		free(data.dst);
+	}
+
+	/* position, normal and uv streams into 32 byte vertices (the SSE2 kernel), and into 40 byte vertices (the blocked copy); items are vertices */
+	static const u32 vertex_strides[] = { 32, 40 };
+	for(u32 i = 0; i < (sizeof(vertex_strides) / sizeof(vertex_strides[0])); i++)
+	{
+		vertex_data_t data =
+		{
+			{
+				{ GLSL_TYPE_VEC3, 0, calloc(VERTEX_COUNT, 12), GLSL_COMPONENT_ENCODING_NATIVE },
+				{ GLSL_TYPE_VEC3, 12, calloc(VERTEX_COUNT, 12), GLSL_COMPONENT_ENCODING_NATIVE },
+				{ GLSL_TYPE_VEC2, 24, calloc(VERTEX_COUNT, 8), GLSL_COMPONENT_ENCODING_NATIVE }
+			},
+			vertex_strides[i],
+			calloc(VERTEX_COUNT, vertex_strides[i])
+		};
+		snprintf(name, sizeof(name), "glsl_vertex_interleave/p3n3t2/%u", vertex_strides[i]);
+		bench_run(&context, name, bench_glsl_vertex_interleave, &data, VERTEX_COUNT);
+		snprintf(name, sizeof(name), "glsl_vertex_deinterleave/p3n3t2/%u", vertex_strides[i]);
+		bench_run(&context, name, bench_glsl_vertex_deinterleave, &data, VERTEX_COUNT);
+		for(u32 j = 0; j < 3; j++)
+			free(data.streams[j].data);
+		free(data.vertices);
+	}
+
+	/* floats in [-1, 1] into (and out of) each encoding; items are components */
+	static const struct { const char* name; glsl_component_encoding_t encoding; } quantize_sets[] =
+	{
+		{ "half", GLSL_COMPONENT_ENCODING_HALF },
+		{ "snorm16", GLSL_COMPONENT_ENCODING_SNORM16 },
+		{ "snorm8", GLSL_COMPONENT_ENCODING_SNORM8 },
+		{ "unorm16", GLSL_COMPONENT_ENCODING_UNORM16 },
+		{ "unorm8", GLSL_COMPONENT_ENCODING_UNORM8 }
+	};
+	for(u32 i = 0; i < (sizeof(quantize_sets) / sizeof(quantize_sets[0])); i++)
+	{
+		quantize_data_t data = { quantize_sets[i].encoding, malloc(sizeof(f32) * QUANTIZE_COMPONENT_COUNT), calloc(QUANTIZE_COMPONENT_COUNT, sizeof(f32)) };
+		u32 seed = 0x9e3779b9u;
+		for(u32 j = 0; j < QUANTIZE_COMPONENT_COUNT; j++)
+			data.floats[j] = (f32)(random_next(&seed) & 0xffff) / 32767.5f - 1.0f;
+		snprintf(name, sizeof(name), "glsl_quantize/%s", quantize_sets[i].name);
+		bench_run(&context, name, bench_glsl_quantize, &data, QUANTIZE_COMPONENT_COUNT);
+		snprintf(name, sizeof(name), "glsl_dequantize/%s", quantize_sets[i].name);
+		bench_run(&context, name, bench_glsl_dequantize, &data, QUANTIZE_COMPONENT_COUNT);
+		free(data.encoded);
+		free(data.floats);
+	}
+
+	/* 208 byte std140 blocks with a 256 byte minimum offset alignment, three frames in flight; items are allocations */
+	{
+		ring_data_t data = { 0 };
+		u32 size = RING_ALLOC_COUNT * 256 * 4;
+		void* buffer = malloc(size);
+		data.ring = glsl_uniform_ring_create(buffer, size, 256, 64 * 1024, 3);
+		data.block_alloc = glsl_uniform_ring_get_block_alloc(data.ring, (glsl_struct_layout_t) { 16, 208, 208 }, 1);
+		bench_run(&context, "glsl_uniform_ring_alloc", bench_glsl_uniform_ring_alloc, &data, RING_ALLOC_COUNT);
+		glsl_uniform_ring_destroy(data.ring);
+		free(buffer);
+	}
+
+	/* std430 buffer { uint count; vec3 particles[]; } fed with tightly packed vec3s (padded to 16 bytes), and with vec4s (copied as is); items are elements */
+	{
+		glsl_type_layout_traits_t header_traits = { .type = GLSL_TYPE_UINT };
+		storage_array_data_t data = { 0 };
+		data.layout = glsl_storage_array_layout(&header_traits, 1, (glsl_type_layout_traits_t) { .type = GLSL_TYPE_VEC3 }, GLSL_STD430, NULL);
+		data.buffer_size = glsl_storage_array_get_buffer_size(&data.layout, STORAGE_ARRAY_ELEMENT_COUNT);
+		data.buffer = malloc(data.buffer_size);
+		void* src = calloc(STORAGE_ARRAY_ELEMENT_COUNT, 16);
+		data.src = src;
+		data.src_stride = 12;
+		bench_run(&context, "glsl_storage_array_append/vec3", bench_glsl_storage_array_append, &data, STORAGE_ARRAY_ELEMENT_COUNT);
+		data.src_stride = 16;
+		bench_run(&context, "glsl_storage_array_append/vec4", bench_glsl_storage_array_append, &data, STORAGE_ARRAY_ELEMENT_COUNT);
+		free(src);
+		free(data.buffer);
+	}
+
+	/* std430 blocks of 32 generated members edited by removing one member and adding a vec4 (in place) or inserting it in the middle; items are instances */
+	{
+		static char names[MIGRATION_MEMBER_COUNT + 1][8];
+		glsl_type_layout_traits_t traits[MIGRATION_MEMBER_COUNT];
+		glsl_member_desc_t old_members[MIGRATION_MEMBER_COUNT];
+		glsl_member_desc_t new_members[MIGRATION_MEMBER_COUNT + 1];
+		generate_block(traits, MIGRATION_MEMBER_COUNT, 0x1234u);
+		for(u32 i = 0; i <= MIGRATION_MEMBER_COUNT; i++)
+			snprintf(names[i], sizeof(names[i]), "m%u", i);
+		for(u32 i = 0; i < MIGRATION_MEMBER_COUNT; i++)
+			old_members[i] = (glsl_member_desc_t) { .name = names[i], .type = traits[i].type, .array_dimension_count = traits[i].is_array ? 1 : 0, .array_lengths = { traits[i].array_length } };
+		const char* bench_names[] = { "execute", "execute_in_place" };
+		for(u32 is_in_place = 0; is_in_place < 2; is_in_place++)
+		{
+			/* in place: member 5 is removed and the vec4 appended, otherwise the vec4 is inserted before member 5 and the members after it move up */
+			u32 new_count = 0;
+			for(u32 i = 0; i < MIGRATION_MEMBER_COUNT; i++)
+			{
+				if((i == 5) && !is_in_place)
+					new_members[new_count++] = (glsl_member_desc_t) { .name = names[MIGRATION_MEMBER_COUNT], .type = GLSL_TYPE_VEC4 };
+				if((i != 5) || !is_in_place)
+					new_members[new_count++] = old_members[i];
+			}
+			if(is_in_place)
+				new_members[new_count++] = (glsl_member_desc_t) { .name = names[MIGRATION_MEMBER_COUNT], .type = GLSL_TYPE_VEC4 };
+			glsl_struct_desc_t old_desc = { "Old", MIGRATION_MEMBER_COUNT, old_members };
+			glsl_struct_desc_t new_desc = { "New", new_count, new_members };
+			glsl_layout_tree_t* old_tree = glsl_layout_tree_create(&old_desc, GLSL_STD430, NULL);
+			glsl_layout_tree_t* new_tree = glsl_layout_tree_create(&new_desc, GLSL_STD430, NULL);
+			migration_data_t data = { 0 };
+			data.migration = glsl_layout_migration_create(old_tree, new_tree, NULL);
+			data.reverse_migration = glsl_layout_migration_create(new_tree, old_tree, NULL);
+			data.stride = (old_tree->root.size > new_tree->root.size) ? old_tree->root.size : new_tree->root.size;
+			data.src = calloc(MIGRATION_INSTANCE_COUNT, data.stride);
+			data.dst = calloc(MIGRATION_INSTANCE_COUNT, data.stride);
+			char name[64];
+			snprintf(name, sizeof(name), "glsl_layout_migration_%s", bench_names[is_in_place]);
+			bench_run(&context, name, is_in_place ? bench_glsl_layout_migration_execute_in_place : bench_glsl_layout_migration_execute, &data, MIGRATION_INSTANCE_COUNT);
+			free(data.src);
+			free(data.dst);
+			glsl_layout_migration_destroy(data.migration);
+			glsl_layout_migration_destroy(data.reverse_migration);
+			glsl_layout_tree_destroy(old_tree);
+			glsl_layout_tree_destroy(new_tree);
+		}
+	}
+
+	if(context.output != NULL)
+		fclose(context.output);
+
+	if(baseline_path != NULL)
+	{
+		s32 regression_count = compare_with_baseline(&context, baseline_path, tolerance_percent);
+		if(regression_count != 0)
+			return (regression_count < 0) ? 2 : 1;
+	}
+	return 0;
+}
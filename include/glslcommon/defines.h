@@ -3,3 +3,13 @@
 
 #include <common/defines.h>
 #include <glslcommon/api_defines.h>
+
+#ifndef BEGIN_CPP_COMPATIBLE
+#	ifdef __cplusplus
+#		define BEGIN_CPP_COMPATIBLE extern "C" {
+#		define END_CPP_COMPATIBLE }
+#	else
+#		define BEGIN_CPP_COMPATIBLE
+#		define END_CPP_COMPATIBLE
+#	endif
+#endif
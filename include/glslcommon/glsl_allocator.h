@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+
+/* Every function which creates a layout object (layout trees, member indices, copy plans, converters, vertex and push constant layouts,
+ * layout caches) takes a 'const glsl_allocator_t* allocator', NULL allocates from the heap (malloc/free).
+ * The object remembers its allocator (by value), so it is destroyed with its usual *_destroy() function whichever allocator created it.
+ * Temporary memory used while building an object is still taken from (and returned to) the heap. */
+
+typedef struct glsl_allocator_t
+{
+	/* returns 'size' bytes aligned to 'align' (a power of two), NULL on failure */
+	void* (*allocate)(void* user_data, u64 size, u32 align);
+	/* returns memory obtained from 'allocate' ('size' is the requested size),
+	 * NULL if the memory is only released all at once, like a glsl_arena_t does */
+	void (*release)(void* user_data, void* memory, u64 size);
+	void* user_data;
+} glsl_allocator_t;
+
+/* bump allocator over a chain of memory blocks, everything allocated from it is released at once by glsl_arena_reset() (or glsl_arena_destroy()),
+ * e.g. one arena per shader holds all of its reflection; not thread safe */
+typedef struct glsl_arena_t glsl_arena_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* allocates 'size' bytes for an object which glsl_allocator_free_object() releases, 'allocator' (NULL for the heap) is stored in front of it;
+ * the object is aligned to 16 bytes (to the alignment of malloc for the heap); returns NULL on failure */
+GLSLCOM_API void* glsl_allocator_alloc_object(const glsl_allocator_t* allocator, u64 size);
+/* releases an object of glsl_allocator_alloc_object() to the allocator it was allocated from, does nothing for NULL;
+ * objects of an arena must not be released after the arena has been reset */
+GLSLCOM_API void glsl_allocator_free_object(void* object);
+
+/* block_size: size of the memory blocks the arena takes from the heap, larger allocations get a block of their own */
+GLSLCOM_API glsl_arena_t* glsl_arena_create(u64 block_size);
+GLSLCOM_API void glsl_arena_destroy(glsl_arena_t* arena);
+/* releases everything allocated from the arena, keeps its first block for the next allocations */
+GLSLCOM_API void glsl_arena_reset(glsl_arena_t* arena);
+/* returns 'size' bytes aligned to 'align' (a power of two) */
+GLSLCOM_API void* glsl_arena_alloc(glsl_arena_t* arena, u64 size, u32 align);
+/* returns the number of bytes allocated from the arena since it was created or reset (without alignment padding) */
+GLSLCOM_API u64 glsl_arena_get_used_size(const glsl_arena_t* arena);
+/* returns an allocator which allocates from 'arena', to be passed to the *_create() functions */
+GLSLCOM_API glsl_allocator_t glsl_arena_get_allocator(glsl_arena_t* arena);
+
+END_CPP_COMPATIBLE
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_allocator.h>
+
+/* where a member lives in the source (CPU side) struct */
+typedef struct glsl_copy_source_member_t
+{
+	/* offset (in bytes) of the member in the source struct */
+	u32 offset;
+	/* stride (in bytes) between consecutive rows (array elements, or matrix columns) in the source, 0 means tightly packed */
+	u32 row_stride;
+} glsl_copy_source_member_t;
+
+/* one run of the plan: copies 'row_count' rows of 'row_size' bytes, consecutive rows being 'dst_stride' and 'src_stride' bytes apart */
+typedef struct glsl_copy_op_t
+{
+	u32 dst_offset;
+	u32 src_offset;
+	u32 row_size;
+	u32 row_count;
+	u32 dst_stride;
+	u32 src_stride;
+} glsl_copy_op_t;
+
+/* immutable list of copy runs which writes a source struct into a glsl laid out buffer */
+typedef struct glsl_copy_plan_t
+{
+	u32 op_count;
+	/* number of bytes (starting at offset 0) the plan may write in the destination */
+	u32 dst_size;
+	const glsl_copy_op_t* ops;
+} glsl_copy_plan_t;
+
+/* runs closer than this (in bytes) are merged into one copy if both the source and the destination have the same gap between them,
+ * the gap in the destination is padding, so copying the source bytes over it is harmless */
+#define GLSL_COPY_PLAN_MAX_MERGE_GAP 32
+
+BEGIN_CPP_COMPATIBLE
+
+/* compiles a copy plan from the member traits and their resolved layouts 'members' (the output of layoutof_glsl_type_struct()) and the source struct description 'src_members';
+ * adjacent members which are contiguous (or identically strided) in both the source and the destination are merged into single runs;
+ * allocator: [optional] see glsl_allocator.h */
+GLSLCOM_API glsl_copy_plan_t* glsl_copy_plan_create(const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, const glsl_copy_source_member_t* src_members, u32 type_traits_count, const glsl_allocator_t* allocator);
+/* compiles a copy plan from explicit runs 'ops' ('op_count' of them, may be 0), consecutive runs are merged as in glsl_copy_plan_create(),
+ * so they should be ordered by destination offset; allocator: [optional] see glsl_allocator.h */
+GLSLCOM_API glsl_copy_plan_t* glsl_copy_plan_create_from_ops(const glsl_copy_op_t* ops, u32 op_count, const glsl_allocator_t* allocator);
+GLSLCOM_API void glsl_copy_plan_destroy(glsl_copy_plan_t* plan);
+/* copies one source struct 'src' into 'dst' as described by the plan, padding bytes in 'dst' are left untouched (or overwritten by merged runs) */
+GLSLCOM_API void glsl_copy_plan_execute(const glsl_copy_plan_t* plan, void* dst, const void* src);
+/* copies 'count' source structs 'src_stride' bytes apart into 'count' destination structs 'dst_stride' bytes apart */
+GLSLCOM_API void glsl_copy_plan_execute_array(const glsl_copy_plan_t* plan, void* dst, u32 dst_stride, const void* src, u32 src_stride, u32 count);
+
+END_CPP_COMPATIBLE
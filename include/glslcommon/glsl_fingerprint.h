@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+
+/* Fingerprints: 64-bit hashes of resolved layouts, equal for layouts which place the same types at the same offsets with the same strides.
+ * Two blocks with equal fingerprints are layout compatible (barring a 64-bit collision), so caches compare them in O(1).
+ * Member names don't take part, neither does the name of the block.
+ *
+ * Fingerprints are stable across runs, compilers and platforms: every value is hashed (64-bit FNV-1a) as its little endian bytes,
+ * so they can key on-disk caches; GLSL_FINGERPRINT_VERSION is hashed in as well and changes whenever the hashed values do
+ * (e.g. the numbering of glsl_type_t), so such caches miss rather than match stale entries.
+ *
+ * A struct is fingerprinted incrementally while its layout is built:
+ *	u64 fingerprint = glsl_fingerprint_struct_begin(layout, member_count);
+ *	for each member, in declaration order:
+ *		fingerprint = glsl_fingerprint_struct_add(fingerprint, offset, glsl_fingerprint_member(...));
+ *	fingerprint = glsl_fingerprint_struct_end(fingerprint, align, size);
+ * glsl_layout_tree_create() fills in the fingerprint of every node this way, glsl_fingerprint_struct_layout() does it for the output of layoutof_glsl_type_struct(),
+ * and both agree for blocks without nested structs. */
+
+#define GLSL_FINGERPRINT_VERSION 1
+
+BEGIN_CPP_COMPATIBLE
+
+/* returns the fingerprint of a member, regardless of its offset: its type (and whether it is a row_major matrix), or 'struct_fingerprint' if it is a struct,
+ * its size and array dimensions (array_lengths and array_strides have 'array_dimension_count' elements, outermost first) */
+GLSLCOM_API u64 glsl_fingerprint_member(glsl_type_t type, bool is_row_major, u64 struct_fingerprint, u32 size, u32 array_dimension_count, const u32* array_lengths, const u32* array_strides);
+/* starts the fingerprint of a struct with 'member_count' members laid out under 'layout' */
+GLSLCOM_API u64 glsl_fingerprint_struct_begin(glsl_memory_layout_t layout, u32 member_count);
+/* adds the next member (in declaration order) at 'offset' with fingerprint 'member_fingerprint' (from glsl_fingerprint_member()) */
+GLSLCOM_API u64 glsl_fingerprint_struct_add(u64 fingerprint, u32 offset, u64 member_fingerprint);
+/* finishes the fingerprint of a struct whose alignment and size are 'align' and 'size' */
+GLSLCOM_API u64 glsl_fingerprint_struct_end(u64 fingerprint, u32 align, u32 size);
+/* returns the fingerprint of a struct laid out by layoutof_glsl_type_struct() ('members' and 'struct_layout' are its outputs),
+ * members of GLSL_TYPE_UNDEFINED type are opaque, only their alignment and size are hashed */
+GLSLCOM_API u64 glsl_fingerprint_struct_layout(const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, u32 type_traits_count, glsl_struct_layout_t struct_layout, glsl_memory_layout_t layout);
+
+END_CPP_COMPATIBLE
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+
+/* Instrumentation: call counts, cumulative time and byte counts of the layout and packing entry points, for frame profilers and telemetry.
+ * It is compiled into debug builds, and into release builds only when GLSLCOM_INSTRUMENTATION is defined (e.g. -DGLSLCOM_INSTRUMENTATION),
+ * otherwise the GLSL_INSTRUMENT_* macros expand to nothing and the functions below only report zeros.
+ *
+ * Calls made by the library itself (e.g. the copy plan a converter executes) are attributed to the outermost call of the thread,
+ * so the times of all the entry points add up to the time spent in the library. Counters are updated atomically (relaxed),
+ * a snapshot taken while other threads call into the library may mix counters from before and after a call. */
+
+#if defined(GLSLCOM_DEBUG) && !defined(GLSLCOM_INSTRUMENTATION)
+#	define GLSLCOM_INSTRUMENTATION
+#endif
+
+typedef enum glsl_instrument_api_t
+{
+	/* layoutof_glsl_type_struct() */
+	GLSL_INSTRUMENT_API_LAYOUTOF_STRUCT = 0,
+	/* glsl_layout_tree_create() */
+	GLSL_INSTRUMENT_API_LAYOUT_TREE_CREATE,
+	/* glsl_layout_cache_get() */
+	GLSL_INSTRUMENT_API_LAYOUT_CACHE_GET,
+	/* glsl_pack_strided() */
+	GLSL_INSTRUMENT_API_PACK_STRIDED,
+	/* glsl_unpack_strided() */
+	GLSL_INSTRUMENT_API_UNPACK_STRIDED,
+	/* glsl_pack_member() */
+	GLSL_INSTRUMENT_API_PACK_MEMBER,
+	/* glsl_pack_struct() */
+	GLSL_INSTRUMENT_API_PACK_STRUCT,
+	/* glsl_pack_matrices() */
+	GLSL_INSTRUMENT_API_PACK_MATRICES,
+	/* glsl_copy_plan_execute() and glsl_copy_plan_execute_array() */
+	GLSL_INSTRUMENT_API_COPY_PLAN_EXECUTE,
+	/* glsl_quantize() */
+	GLSL_INSTRUMENT_API_QUANTIZE,
+	/* glsl_dequantize() */
+	GLSL_INSTRUMENT_API_DEQUANTIZE,
+	/* glsl_vertex_interleave() */
+	GLSL_INSTRUMENT_API_VERTEX_INTERLEAVE,
+	/* glsl_vertex_deinterleave() */
+	GLSL_INSTRUMENT_API_VERTEX_DEINTERLEAVE,
+	/* glsl_storage_array_append() */
+	GLSL_INSTRUMENT_API_STORAGE_ARRAY_APPEND,
+	/* glsl_layout_converter_convert() */
+	GLSL_INSTRUMENT_API_LAYOUT_CONVERT,
+	/* glsl_layout_migration_execute() and glsl_layout_migration_execute_in_place() */
+	GLSL_INSTRUMENT_API_LAYOUT_MIGRATION,
+	GLSL_INSTRUMENT_API_MAX
+} glsl_instrument_api_t;
+
+typedef struct glsl_instrument_api_stats_t
+{
+	/* number of (outermost) calls */
+	u64 call_count;
+	/* cumulative wall clock time of those calls, in nanoseconds */
+	u64 time_ns;
+	/* bytes written to the destination, 0 for the layout computations */
+	u64 bytes;
+} glsl_instrument_api_stats_t;
+
+typedef struct glsl_instrument_snapshot_t
+{
+	glsl_instrument_api_stats_t apis[GLSL_INSTRUMENT_API_MAX];
+	/* bytes written by the pack, unpack, copy plan, quantize, vertex stream and storage array entry points */
+	u64 bytes_packed;
+	/* bytes written by layout converters and migrations */
+	u64 bytes_converted;
+	/* bytes zero-filled by the pack entry points (in between and after elements, members and matrices) and by migrations (see glsl_layout_migration_t::zero_ranges) */
+	u64 padding_bytes_written;
+	/* lookups of every glsl_layout_cache_t, the hit rate is hit_count / (hit_count + miss_count) */
+	u64 cache_hit_count;
+	u64 cache_miss_count;
+} glsl_instrument_snapshot_t;
+
+/* called at the end of every outermost instrumented call, on the thread which made it; 'bytes' is what that call adds to glsl_instrument_api_stats_t::bytes */
+typedef void (*glsl_instrument_callback_t)(void* user_data, glsl_instrument_api_t api, u64 time_ns, u64 bytes);
+
+BEGIN_CPP_COMPATIBLE
+
+/* returns true if the library has been built with instrumentation */
+GLSLCOM_API bool glsl_instrument_is_enabled(void);
+/* copies the current counters into 'out_snapshot' (all zeros if instrumentation is compiled out) */
+GLSLCOM_API void glsl_instrument_get_snapshot(glsl_instrument_snapshot_t* out_snapshot);
+/* resets all counters to zero, e.g. at the start of every frame */
+GLSLCOM_API void glsl_instrument_reset(void);
+/* returns the name of the entry point 'api' stands for, e.g. "glsl_pack_struct" */
+GLSLCOM_API const char* glsl_instrument_api_name(glsl_instrument_api_t api);
+/* installs 'callback' (NULL removes it), it must not be changed while other threads call into the library */
+GLSLCOM_API void glsl_instrument_set_callback(glsl_instrument_callback_t callback, void* user_data);
+
+/* used by the GLSL_INSTRUMENT_* macros */
+GLSLCOM_API u64 glsl_instrument_begin(void);
+GLSLCOM_API void glsl_instrument_end(glsl_instrument_api_t api, u64 start_ns, u64 bytes);
+GLSLCOM_API void glsl_instrument_add_padding(u64 bytes);
+GLSLCOM_API void glsl_instrument_add_cache_lookup(bool is_hit);
+
+END_CPP_COMPATIBLE
+
+/* brackets the body of an entry point, 'bytes' is only evaluated if instrumentation is compiled in:
+ *	GLSL_INSTRUMENT_BEGIN();
+ *	...
+ *	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_PACK_STRIDED, (u64)dst_stride * count); */
+#ifdef GLSLCOM_INSTRUMENTATION
+#	define GLSL_INSTRUMENT_BEGIN() u64 glsl_instrument_start_ns__ = glsl_instrument_begin()
+#	define GLSL_INSTRUMENT_END(api, bytes) glsl_instrument_end(api, glsl_instrument_start_ns__, bytes)
+#	define GLSL_INSTRUMENT_PADDING(bytes) glsl_instrument_add_padding(bytes)
+#	define GLSL_INSTRUMENT_CACHE_LOOKUP(is_hit) glsl_instrument_add_cache_lookup(is_hit)
+#else
+#	define GLSL_INSTRUMENT_BEGIN() ((void)0)
+#	define GLSL_INSTRUMENT_END(api, bytes) ((void)0)
+#	define GLSL_INSTRUMENT_PADDING(bytes) ((void)0)
+#	define GLSL_INSTRUMENT_CACHE_LOOKUP(is_hit) ((void)0)
+#endif /* GLSLCOM_INSTRUMENTATION */
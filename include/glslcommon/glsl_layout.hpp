@@ -0,0 +1,254 @@
+#pragma once
+
+#include <glslcommon/glsl_types.h>
+
+#include <array> /* std::array */
+#include <cstddef> /* std::size_t */
+#include <initializer_list> /* std::initializer_list */
+#include <type_traits> /* std::integral_constant */
+
+/* Compile time counterpart of layoutof_glsl_type_struct()
+
+	struct Light
+	{
+		float position[3];
+		float intensity;
+		float viewProj[4][16];
+	};
+	using LightLayout = glsl::layout_of<glsl::std140, glsl::vec3, float, glsl::mat4[4]>;
+	static_assert(LightLayout::offsets[2] == 16);
+	static_assert(LightLayout::matches(sizeof(Light), { offsetof(Light, position), offsetof(Light, intensity), offsetof(Light, viewProj) }));
+ */
+namespace glsl
+{
+	/* memory layout tags */
+	template<glsl_memory_layout_t Layout>
+	struct memory_layout : std::integral_constant<glsl_memory_layout_t, Layout> { };
+	using scalar = memory_layout<GLSL_MEMORY_LAYOUT_SCALAR>;
+	using std430 = memory_layout<GLSL_MEMORY_LAYOUT_BASE>;
+	using std140 = memory_layout<GLSL_MEMORY_LAYOUT_EXTENDED>;
+
+	/* glsl type tags, meant to be used only as template arguments;
+	 * float, double and the sized integers (s8 ... u64) map to their glsl counterparts directly, float16_t has no C++ counterpart */
+	template<glsl_type_t Type>
+	struct type_tag : std::integral_constant<glsl_type_t, Type> { };
+	using vec2 = type_tag<GLSL_TYPE_VEC2>;
+	using vec3 = type_tag<GLSL_TYPE_VEC3>;
+	using vec4 = type_tag<GLSL_TYPE_VEC4>;
+	using ivec2 = type_tag<GLSL_TYPE_IVEC2>;
+	using ivec3 = type_tag<GLSL_TYPE_IVEC3>;
+	using ivec4 = type_tag<GLSL_TYPE_IVEC4>;
+	using uvec2 = type_tag<GLSL_TYPE_UVEC2>;
+	using uvec3 = type_tag<GLSL_TYPE_UVEC3>;
+	using uvec4 = type_tag<GLSL_TYPE_UVEC4>;
+	using dvec2 = type_tag<GLSL_TYPE_DVEC2>;
+	using dvec3 = type_tag<GLSL_TYPE_DVEC3>;
+	using dvec4 = type_tag<GLSL_TYPE_DVEC4>;
+	using mat2 = type_tag<GLSL_TYPE_MAT2>;
+	using mat3 = type_tag<GLSL_TYPE_MAT3>;
+	using mat4 = type_tag<GLSL_TYPE_MAT4>;
+	using dmat2 = type_tag<GLSL_TYPE_DMAT2>;
+	using dmat3 = type_tag<GLSL_TYPE_DMAT3>;
+	using dmat4 = type_tag<GLSL_TYPE_DMAT4>;
+	using mat2x3 = type_tag<GLSL_TYPE_MAT2X3>;
+	using mat2x4 = type_tag<GLSL_TYPE_MAT2X4>;
+	using mat3x2 = type_tag<GLSL_TYPE_MAT3X2>;
+	using mat3x4 = type_tag<GLSL_TYPE_MAT3X4>;
+	using mat4x2 = type_tag<GLSL_TYPE_MAT4X2>;
+	using mat4x3 = type_tag<GLSL_TYPE_MAT4X3>;
+	using float16_t = type_tag<GLSL_TYPE_F16>;
+	using f16vec2 = type_tag<GLSL_TYPE_F16VEC2>;
+	using f16vec3 = type_tag<GLSL_TYPE_F16VEC3>;
+	using f16vec4 = type_tag<GLSL_TYPE_F16VEC4>;
+	using i16vec2 = type_tag<GLSL_TYPE_I16VEC2>;
+	using i16vec3 = type_tag<GLSL_TYPE_I16VEC3>;
+	using i16vec4 = type_tag<GLSL_TYPE_I16VEC4>;
+	using u16vec2 = type_tag<GLSL_TYPE_U16VEC2>;
+	using u16vec3 = type_tag<GLSL_TYPE_U16VEC3>;
+	using u16vec4 = type_tag<GLSL_TYPE_U16VEC4>;
+	using i8vec2 = type_tag<GLSL_TYPE_I8VEC2>;
+	using i8vec3 = type_tag<GLSL_TYPE_I8VEC3>;
+	using i8vec4 = type_tag<GLSL_TYPE_I8VEC4>;
+	using u8vec2 = type_tag<GLSL_TYPE_U8VEC2>;
+	using u8vec3 = type_tag<GLSL_TYPE_U8VEC3>;
+	using u8vec4 = type_tag<GLSL_TYPE_U8VEC4>;
+
+	/* maps a C++ type (or a type tag) to glsl_type_t */
+	template<typename T>
+	struct type_of;
+	template<glsl_type_t Type>
+	struct type_of<type_tag<Type>> : std::integral_constant<glsl_type_t, Type> { };
+	template<> struct type_of<float> : std::integral_constant<glsl_type_t, GLSL_TYPE_FLOAT> { };
+	template<> struct type_of<double> : std::integral_constant<glsl_type_t, GLSL_TYPE_DOUBLE> { };
+	template<> struct type_of<s32> : std::integral_constant<glsl_type_t, GLSL_TYPE_INT> { };
+	template<> struct type_of<u32> : std::integral_constant<glsl_type_t, GLSL_TYPE_UINT> { };
+	template<> struct type_of<s8> : std::integral_constant<glsl_type_t, GLSL_TYPE_INT8> { };
+	template<> struct type_of<u8> : std::integral_constant<glsl_type_t, GLSL_TYPE_UINT8> { };
+	template<> struct type_of<s16> : std::integral_constant<glsl_type_t, GLSL_TYPE_INT16> { };
+	template<> struct type_of<u16> : std::integral_constant<glsl_type_t, GLSL_TYPE_UINT16> { };
+	template<> struct type_of<s64> : std::integral_constant<glsl_type_t, GLSL_TYPE_INT64> { };
+	template<> struct type_of<u64> : std::integral_constant<glsl_type_t, GLSL_TYPE_UINT64> { };
+
+	/* constexpr version of transposeof_glsl_type() */
+	constexpr glsl_type_t transpose_type(glsl_type_t type)
+	{
+		switch(type)
+		{
+			case GLSL_TYPE_MAT2X3: return GLSL_TYPE_MAT3X2;
+			case GLSL_TYPE_MAT2X4: return GLSL_TYPE_MAT4X2;
+			case GLSL_TYPE_MAT3X2: return GLSL_TYPE_MAT2X3;
+			case GLSL_TYPE_MAT3X4: return GLSL_TYPE_MAT4X3;
+			case GLSL_TYPE_MAT4X2: return GLSL_TYPE_MAT2X4;
+			case GLSL_TYPE_MAT4X3: return GLSL_TYPE_MAT3X4;
+			default: return type;
+		}
+	}
+
+	/* row_major matrix member, e.g. glsl::row_major<glsl::mat3x4>[64];
+	 * a row_major matCxR is laid out as an array of its rows, exactly like a matRxC, so it maps to that type */
+	template<typename Matrix>
+	struct row_major;
+	template<glsl_type_t Type>
+	struct row_major<type_tag<Type>> { };
+	template<glsl_type_t Type>
+	struct type_of<row_major<type_tag<Type>>> : std::integral_constant<glsl_type_t, transpose_type(Type)> { };
+
+	/* constexpr versions of alignof_glsl_type(_array), sizeof_glsl_type and strideof_glsl_type_array,
+	 * they are generated from the same GLSL_TYPE_LAYOUT_LIST as the runtime lookup tables */
+#define GLSLCOM_CONSTEXPR_ALIGN_CASE(LAYOUT, type, NAME, size) case type: return is_array ? GLSL_##LAYOUT##_##NAME##_ARR_ALIGN : GLSL_##LAYOUT##_##NAME##_ALIGN;
+#define GLSLCOM_CONSTEXPR_SIZE_CASE(LAYOUT, type, NAME, size) case type: return is_array ? U32_NEXT_MULTIPLE((size), GLSL_##LAYOUT##_##NAME##_ARR_ALIGN) : (size);
+	constexpr u32 alignof_type(glsl_type_t type, glsl_memory_layout_t layout, bool is_array = false)
+	{
+		switch(layout)
+		{
+			case GLSL_MEMORY_LAYOUT_SCALAR: switch(type) { GLSL_TYPE_LAYOUT_LIST(GLSLCOM_CONSTEXPR_ALIGN_CASE, SCALAR) default: return 0; }
+			case GLSL_MEMORY_LAYOUT_BASE: switch(type) { GLSL_TYPE_LAYOUT_LIST(GLSLCOM_CONSTEXPR_ALIGN_CASE, STD430) default: return 0; }
+			case GLSL_MEMORY_LAYOUT_EXTENDED: switch(type) { GLSL_TYPE_LAYOUT_LIST(GLSLCOM_CONSTEXPR_ALIGN_CASE, STD140) default: return 0; }
+			default: return 0;
+		}
+	}
+	/* returns size of a value of type 'type' if is_array is false, otherwise returns the array stride */
+	constexpr u32 sizeof_type(glsl_type_t type, glsl_memory_layout_t layout, bool is_array = false)
+	{
+		switch(layout)
+		{
+			case GLSL_MEMORY_LAYOUT_SCALAR: switch(type) { GLSL_TYPE_LAYOUT_LIST(GLSLCOM_CONSTEXPR_SIZE_CASE, SCALAR) default: return 0; }
+			case GLSL_MEMORY_LAYOUT_BASE: switch(type) { GLSL_TYPE_LAYOUT_LIST(GLSLCOM_CONSTEXPR_SIZE_CASE, STD430) default: return 0; }
+			case GLSL_MEMORY_LAYOUT_EXTENDED: switch(type) { GLSL_TYPE_LAYOUT_LIST(GLSLCOM_CONSTEXPR_SIZE_CASE, STD140) default: return 0; }
+			default: return 0;
+		}
+	}
+#undef GLSLCOM_CONSTEXPR_ALIGN_CASE
+#undef GLSLCOM_CONSTEXPR_SIZE_CASE
+
+	template<typename Layout, typename... Members>
+	struct layout_of;
+
+	/* layout information (alignment, size and array stride) of a member of type 'T' under 'Layout' */
+	template<typename Layout, typename T>
+	struct member_traits
+	{
+		static constexpr glsl_type_t type = type_of<T>::value;
+		static constexpr u32 align = alignof_type(type, Layout::value);
+		static constexpr u32 size = sizeof_type(type, Layout::value);
+		static constexpr u32 array_stride = 0;
+		static_assert(align != 0, "alignment is not defined for this glsl type");
+	};
+
+	/* arrays (and arrays of arrays) */
+	template<typename Layout, typename T, std::size_t N>
+	struct member_traits<Layout, T[N]>
+	{
+		static_assert(N > 0, "glsl arrays must have at least one element");
+		using element_traits = member_traits<Layout, T>;
+		/* arrays of non-array glsl types take their alignment from the tables, arrays of structs and arrays of arrays
+		 * follow the same rule: Extended Alignment rounds the alignment of an array up to a multiple of 16 */
+		static constexpr u32 compute_align()
+		{
+			if constexpr(requires { type_of<T>::value; })
+				return alignof_type(type_of<T>::value, Layout::value, true);
+			else
+				return (Layout::value == GLSL_MEMORY_LAYOUT_EXTENDED) ? U32_NEXT_MULTIPLE(element_traits::align, 16) : element_traits::align;
+		}
+		static constexpr u32 align = compute_align();
+		static constexpr u32 array_stride = U32_NEXT_MULTIPLE(element_traits::size, align);
+		static constexpr u32 size = array_stride * static_cast<u32>(N);
+	};
+
+	/* nested structs are laid out again under the enclosing block's layout */
+	template<typename Layout, typename OtherLayout, typename... Members>
+	struct member_traits<Layout, layout_of<OtherLayout, Members...>>
+	{
+		static constexpr u32 align = layout_of<Layout, Members...>::align;
+		static constexpr u32 size = layout_of<Layout, Members...>::size;
+		static constexpr u32 array_stride = 0;
+	};
+
+	namespace detail
+	{
+		template<std::size_t N>
+		struct struct_layout
+		{
+			std::array<u32, N> offsets { };
+			std::array<u32, N> sizes { };
+			std::array<u32, N> array_strides { };
+			u32 align = 1;
+			u32 size = 0;
+		};
+
+		/* constexpr version of layoutof_glsl_type_struct() */
+		template<typename Layout, typename... Members>
+		constexpr struct_layout<sizeof...(Members)> compute_struct_layout()
+		{
+			constexpr u32 aligns[] = { member_traits<Layout, Members>::align... };
+			struct_layout<sizeof...(Members)> result { { }, { member_traits<Layout, Members>::size... }, { member_traits<Layout, Members>::array_stride... } };
+			u32 offset = 0;
+			for(std::size_t i = 0; i < sizeof...(Members); i++)
+			{
+				offset = U32_NEXT_MULTIPLE(offset, aligns[i]);
+				result.offsets[i] = offset;
+				offset += result.sizes[i];
+				if(result.align < aligns[i])
+					result.align = aligns[i];
+			}
+			/* Extended Alignment: A structure has an extended alignment rounded up to a multiple of 16 */
+			if(Layout::value == GLSL_MEMORY_LAYOUT_EXTENDED)
+				result.align = U32_NEXT_MULTIPLE(result.align, 16);
+			result.size = U32_NEXT_MULTIPLE(offset, result.align);
+			return result;
+		}
+	}
+
+	/* compile time layout of a struct (or block) with members of types 'Members' under 'Layout' (scalar, std430 or std140) */
+	template<typename Layout, typename... Members>
+	struct layout_of
+	{
+		static_assert(sizeof...(Members) > 0, "a glsl struct must have at least one member");
+	private:
+		static constexpr detail::struct_layout<sizeof...(Members)> value = detail::compute_struct_layout<Layout, Members...>();
+	public:
+		static constexpr glsl_memory_layout_t memory_layout = Layout::value;
+		static constexpr u32 member_count = sizeof...(Members);
+		/* offset (in bytes) of each member */
+		static constexpr std::array<u32, sizeof...(Members)> offsets = value.offsets;
+		/* size (in bytes) occupied by each member */
+		static constexpr std::array<u32, sizeof...(Members)> sizes = value.sizes;
+		/* array stride (in bytes) of each member, 0 for non-array members */
+		static constexpr std::array<u32, sizeof...(Members)> array_strides = value.array_strides;
+		static constexpr u32 align = value.align;
+		static constexpr u32 size = value.size;
+		static constexpr u32 array_stride = value.size;
+
+		/* returns true if a C++ struct of size 'struct_size' with members at 'member_offsets' (use offsetof) matches this layout byte for byte */
+		static constexpr bool matches(std::size_t struct_size, std::initializer_list<std::size_t> member_offsets)
+		{
+			if((struct_size != size) || (member_offsets.size() != member_count))
+				return false;
+			std::size_t i = 0;
+			for(std::size_t offset : member_offsets)
+				if(offset != offsets[i++])
+					return false;
+			return true;
+		}
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_allocator.h>
+
+/* shared and immutable layout of a struct (or block), owned by the glsl_layout_cache_t which interned it */
+typedef struct glsl_layout_descriptor_t
+{
+	/* hash of the member signature (type, is_array, array_length and is_row_major of each member, and the layout) */
+	u64 signature_hash;
+	/* memory layout this descriptor has been computed for */
+	glsl_memory_layout_t layout;
+	/* number of members in the struct */
+	u32 member_count;
+	/* interned copy of the traits of each member (in declaration order) */
+	const glsl_type_layout_traits_t* member_traits;
+	/* offset, alignment, size and array stride of each member */
+	const glsl_member_layout_t* members;
+	/* alignment, size and array stride of the struct itself */
+	glsl_struct_layout_t struct_layout;
+	/* fingerprint of the layout (see glsl_fingerprint.h), computed once when the descriptor is interned;
+	 * row_major square matrices are interned as column major ones (their layouts are identical), so their fingerprints are too */
+	u64 fingerprint;
+} glsl_layout_descriptor_t;
+
+typedef struct glsl_layout_cache_stats_t
+{
+	/* number of lookups which found an already interned descriptor */
+	u64 hit_count;
+	/* number of lookups which had to compute (and intern) a new descriptor */
+	u64 miss_count;
+	/* number of descriptors currently interned */
+	u64 descriptor_count;
+} glsl_layout_cache_stats_t;
+
+/* thread safe cache of interned struct layouts, each signature is interned exactly once;
+ * lookups of interned layouts probe a single table without taking a lock (or writing anything but a hit counter striped per thread) and neither recompute nor allocate,
+ * interning a new layout briefly takes a spin lock */
+typedef struct glsl_layout_cache_t glsl_layout_cache_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* creates a cache which is expected to hold about 'capacity' descriptors, it grows beyond that when needed;
+ * allocator: [optional] see glsl_allocator.h, the descriptors are allocated from it too, so it must be thread safe if the cache is used by several threads */
+GLSLCOM_API glsl_layout_cache_t* glsl_layout_cache_create(u32 capacity, const glsl_allocator_t* allocator);
+/* destroys the cache and every descriptor it has interned, no other thread may be using the cache at this point */
+GLSLCOM_API void glsl_layout_cache_destroy(glsl_layout_cache_t* cache);
+/* returns the interned layout of the struct with members 'type_traits' under 'layout', computing and interning it on the first request;
+ * safe to be called concurrently from any number of threads, the returned descriptor stays valid until the cache is destroyed */
+GLSLCOM_API const glsl_layout_descriptor_t* glsl_layout_cache_get(glsl_layout_cache_t* cache, const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout);
+/* returns hit/miss counters of the cache */
+GLSLCOM_API glsl_layout_cache_stats_t glsl_layout_cache_get_stats(const glsl_layout_cache_t* cache);
+/* resets hit/miss counters of the cache to zero */
+GLSLCOM_API void glsl_layout_cache_reset_stats(glsl_layout_cache_t* cache);
+
+END_CPP_COMPATIBLE
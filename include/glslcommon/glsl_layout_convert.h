@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_copy_plan.h>
+
+/* remaps instances of one block from 'src_layout' to 'dst_layout' (e.g. std430 --> std140);
+ * members of GLSL_TYPE_UNDEFINED type (nested structs) can only be copied as opaque bytes when both layouts are the same,
+ * to convert blocks with nested structs between layouts, build a glsl_layout_tree_t of the block under each layout and use glsl_layout_migration_create() */
+typedef struct glsl_layout_converter_t
+{
+	glsl_memory_layout_t src_layout;
+	glsl_memory_layout_t dst_layout;
+	glsl_struct_layout_t src_struct_layout;
+	glsl_struct_layout_t dst_struct_layout;
+	/* true if both layouts place every member at the same offset with the same size and strides, conversion is then a no-op */
+	bool is_identity;
+	/* copies an instance from 'src_layout' into 'dst_layout', NULL if is_identity is true */
+	glsl_copy_plan_t* plan;
+} glsl_layout_converter_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* returns NULL if 'src_layout' and 'dst_layout' differ and any member is of GLSL_TYPE_UNDEFINED type;
+ * allocator: [optional] see glsl_allocator.h, the copy plan is allocated from it too */
+GLSLCOM_API glsl_layout_converter_t* glsl_layout_converter_create(const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t src_layout, glsl_memory_layout_t dst_layout, const glsl_allocator_t* allocator);
+GLSLCOM_API void glsl_layout_converter_destroy(glsl_layout_converter_t* converter);
+/* converts 'instance_count' consecutive instances (array_stride bytes apart) from 'src' into 'dst',
+ * returns the converted data: 'src' itself if the converter is an identity (no copy is made), otherwise 'dst' */
+GLSLCOM_API const void* glsl_layout_converter_convert(const glsl_layout_converter_t* converter, void* dst, const void* src, u32 instance_count);
+
+END_CPP_COMPATIBLE
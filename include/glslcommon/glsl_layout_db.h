@@ -0,0 +1,157 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_layout_tree.h>
+
+/* Layout database: the block layouts of a whole shader build, written once by the compiler and read in place by the renderer.
+ * The file is a header followed by three tables; every reference is an offset from the start of the file, so it can be mapped
+ * (or loaded) at any address and queried directly, without parsing and without allocating.
+ *
+ *   glsl_layout_db_header_t
+ *   glsl_layout_db_block_t[block_count]    sorted by (name_hash, layout)
+ *   glsl_layout_db_member_t[member_count]  the members of a block are contiguous and sorted by name_hash
+ *   char[strings_size]                     null terminated block names and member paths
+ *
+ * Values are stored in the byte order of the writer (little endian on every supported target) and readers reject files of the other byte order;
+ * every record is 8 byte aligned, so the file must be loaded at an 8 byte aligned address (mmap() always is).
+ * Names are hashed with glsl_member_index_hash(), members are indexed by full path like glsl_member_index_create_from_tree() does,
+ * struct arrays once ("lights[].position"), so a block takes space in proportion to its declaration and not to its array lengths.
+ * Type values are those of glsl_type_t, changing their numbering requires a new major version. */
+
+#define GLSL_LAYOUT_DB_MAGIC 0x42444c47u /* "GLDB" */
+/* glsl_layout_db_member_t::outer_array of members which aren't within a struct array */
+#define GLSL_LAYOUT_DB_NO_OUTER_ARRAY 0xffffffffu
+/* readers reject files of another major version */
+#define GLSL_LAYOUT_DB_VERSION_MAJOR 2
+/* minor versions only add fields which older readers can ignore */
+#define GLSL_LAYOUT_DB_VERSION_MINOR 0
+
+typedef struct glsl_layout_db_header_t
+{
+	u32 magic;
+	u16 version_major;
+	u16 version_minor;
+	/* size of this header, records added by later minor versions start after the fields known to older readers */
+	u32 header_size;
+	u32 file_size;
+	u32 block_count;
+	u32 blocks_offset;
+	u32 member_count;
+	u32 members_offset;
+	u32 strings_size;
+	u32 strings_offset;
+	/* FNV-1a of every byte after the header, see glsl_layout_db_verify() */
+	u64 checksum;
+} glsl_layout_db_header_t;
+
+typedef struct glsl_layout_db_block_t
+{
+	u64 name_hash;
+	/* offset into the string table */
+	u32 name_offset;
+	/* glsl_memory_layout_t */
+	u32 layout;
+	u32 size;
+	u32 align;
+	/* index of the first member in the member table */
+	u32 first_member;
+	u32 member_count;
+} glsl_layout_db_block_t;
+
+/* same meaning as the fields of glsl_member_index_entry_t */
+typedef struct glsl_layout_db_member_t
+{
+	u64 name_hash;
+	/* offset into the string table */
+	u32 name_offset;
+	/* glsl_type_t, GLSL_TYPE_UNDEFINED for structs */
+	u32 type;
+	u32 offset;
+	u32 size;
+	u32 array_length;
+	u32 array_stride;
+	/* 0 or 1 */
+	u32 is_row_major;
+	/* position (among the members of the block) of the struct array the last "[]" of the path indexes, GLSL_LAYOUT_DB_NO_OUTER_ARRAY if the path has no "[]" */
+	u32 outer_array;
+} glsl_layout_db_member_t;
+
+/* view of a database in memory, filled by glsl_layout_db_open(), it only points into the data and doesn't need to be destroyed */
+typedef struct glsl_layout_db_t
+{
+	const glsl_layout_db_header_t* header;
+	const glsl_layout_db_block_t* blocks;
+	const glsl_layout_db_member_t* members;
+	const char* strings;
+} glsl_layout_db_t;
+
+/* read only mapping of a database file, see glsl_layout_db_map() */
+typedef struct glsl_layout_db_mapping_t
+{
+	glsl_layout_db_t db;
+	const void* data;
+	u64 size;
+	/* platform handle of the mapping */
+	void* handle;
+} glsl_layout_db_mapping_t;
+
+/* accumulates blocks on the compiler side and serializes them */
+typedef struct glsl_layout_db_writer_t glsl_layout_db_writer_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* reader */
+
+/* checks the header and that every table lies within 'size' bytes of 'data', which is O(1) and doesn't read the tables;
+ * returns false (and logs why) if 'data' isn't a database of a supported version.
+ * Files produced by the build can be trusted past this point, others should go through glsl_layout_db_verify() as well */
+GLSLCOM_API bool glsl_layout_db_open(glsl_layout_db_t* out_db, const void* data, u64 size);
+/* checks the checksum and that every record references existing members and strings, O(file size) */
+GLSLCOM_API bool glsl_layout_db_verify(const glsl_layout_db_t* db);
+/* returns the block named 'name' with layout 'layout', NULL if there is no such block; binary search over the block table */
+GLSLCOM_API const glsl_layout_db_block_t* glsl_layout_db_find_block(const glsl_layout_db_t* db, const char* name, glsl_memory_layout_t layout);
+/* same as glsl_layout_db_find_block() with the glsl_member_index_hash() of the name, only the hash is compared */
+GLSLCOM_API const glsl_layout_db_block_t* glsl_layout_db_find_block_prehashed(const glsl_layout_db_t* db, u64 name_hash, glsl_memory_layout_t layout);
+/* returns the member of 'block' at full path 'path', NULL if there is no such member; binary search over the members of the block */
+GLSLCOM_API const glsl_layout_db_member_t* glsl_layout_db_find_member(const glsl_layout_db_t* db, const glsl_layout_db_block_t* block, const char* path);
+/* same as glsl_layout_db_find_member() with the glsl_member_index_hash() of the path, only the hash is compared */
+GLSLCOM_API const glsl_layout_db_member_t* glsl_layout_db_find_member_prehashed(const glsl_layout_db_t* db, const glsl_layout_db_block_t* block, u64 path_hash);
+/* same as glsl_member_index_resolve(): returns the member of 'block' at 'path' with its constant struct array indices replaced by "[]" ("lights[3].pos" --> "lights[].pos"),
+ * and in 'out_offset' the offset of the indexed element; NULL if there is no such member or an index is out of bounds */
+GLSLCOM_API const glsl_layout_db_member_t* glsl_layout_db_resolve_member(const glsl_layout_db_t* db, const glsl_layout_db_block_t* block, const char* path, u32* out_offset);
+
+static inline const char* glsl_layout_db_get_string(const glsl_layout_db_t* db, u32 offset)
+{
+	return db->strings + offset;
+}
+
+/* returns the block->member_count members of 'block', sorted by name_hash */
+static inline const glsl_layout_db_member_t* glsl_layout_db_get_members(const glsl_layout_db_t* db, const glsl_layout_db_block_t* block)
+{
+	return db->members + block->first_member;
+}
+
+/* maps the file at 'path' read only and opens it (glsl_layout_db_open(), not verified), the pages are only read when queried;
+ * returns false if the file can't be mapped or isn't a valid database */
+GLSLCOM_API bool glsl_layout_db_map(const char* path, glsl_layout_db_mapping_t* out_mapping);
+GLSLCOM_API void glsl_layout_db_unmap(glsl_layout_db_mapping_t* mapping);
+
+/* writer */
+
+GLSLCOM_API glsl_layout_db_writer_t* glsl_layout_db_writer_create(void);
+GLSLCOM_API void glsl_layout_db_writer_destroy(glsl_layout_db_writer_t* writer);
+/* adds the layout of 'tree' under 'name' (the name of the root if NULL), e.g. a name qualified by the shader variant ("shadow.frag/Lights");
+ * every member is stored by full path, struct arrays once ("lights[].pos"), like glsl_member_index_create_from_tree();
+ * returns false if a member path is too long */
+GLSLCOM_API bool glsl_layout_db_writer_add_tree(glsl_layout_db_writer_t* writer, const char* name, const glsl_layout_tree_t* tree);
+/* returns the size (in bytes) of the serialized database, 0 if it would exceed 4 GiB */
+GLSLCOM_API u32 glsl_layout_db_writer_get_size(const glsl_layout_db_writer_t* writer);
+/* serializes the database into 'dst' of 'dst_size' bytes (at least glsl_layout_db_writer_get_size()), which must be 8 byte aligned;
+ * the output only depends on the added blocks, not on the order they were added in;
+ * returns false if two blocks have the same name and layout */
+GLSLCOM_API bool glsl_layout_db_writer_write(const glsl_layout_db_writer_t* writer, void* dst, u32 dst_size);
+/* serializes the database into the file at 'path' */
+GLSLCOM_API bool glsl_layout_db_writer_write_file(const glsl_layout_db_writer_t* writer, const char* path);
+
+END_CPP_COMPATIBLE
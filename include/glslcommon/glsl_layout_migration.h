@@ -0,0 +1,82 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_layout_tree.h>
+#include <glslcommon/glsl_copy_plan.h>
+#include <glslcommon/glsl_allocator.h>
+
+/* Carries the contents of block instances over to a new layout of the block (e.g. after a shader is edited and reloaded):
+ * members are matched by name (recursively through structs), those present in both layouts with the same type are moved to their new offsets,
+ * arrays keep the elements present in both lengths, everything else in the new instances is zero-filled. */
+
+typedef enum glsl_layout_change_t
+{
+	/* same offset, strides and array lengths */
+	GLSL_LAYOUT_CHANGE_NONE = 0,
+	/* moved to a different offset (or to different strides, e.g. under a different memory layout), its data is carried over */
+	GLSL_LAYOUT_CHANGE_MOVED,
+	/* array lengths changed, the elements present in both are carried over */
+	GLSL_LAYOUT_CHANGE_RESIZED,
+	/* type, row_major or number of array dimensions changed, the member is zero-filled */
+	GLSL_LAYOUT_CHANGE_RETYPED,
+	/* only in the new layout, zero-filled */
+	GLSL_LAYOUT_CHANGE_ADDED,
+	/* only in the old layout, dropped */
+	GLSL_LAYOUT_CHANGE_REMOVED
+} glsl_layout_change_t;
+
+/* change of a member, members of structs are compared relative to their struct */
+typedef struct glsl_layout_diff_entry_t
+{
+	glsl_layout_change_t change;
+	/* NULL for added members */
+	const glsl_layout_node_t* old_node;
+	/* NULL for removed members */
+	const glsl_layout_node_t* new_node;
+} glsl_layout_diff_entry_t;
+
+/* byte range of an instance */
+typedef struct glsl_layout_range_t
+{
+	u32 offset;
+	u32 size;
+} glsl_layout_range_t;
+
+/* immutable diff and migration plan between two layouts of a block, allocated as a single memory block (plus the copy plan) */
+typedef struct glsl_layout_migration_t
+{
+	const glsl_layout_tree_t* old_tree;
+	const glsl_layout_tree_t* new_tree;
+	/* one entry per member of either layout, parents before their children; members of added, removed or retyped structs have no entries of their own */
+	u32 entry_count;
+	const glsl_layout_diff_entry_t* entries;
+	/* sizes of an instance under the old and the new layout */
+	u32 old_size;
+	u32 new_size;
+	/* true if both layouts are identical, migrating is then a no-op */
+	bool is_identity;
+	/* true if instances can be migrated in place (see glsl_layout_migration_execute_in_place()) without a scratch copy of each instance */
+	bool is_in_place;
+	/* copies the surviving members of an old instance into a new instance, ordered by destination offset */
+	glsl_copy_plan_t* plan;
+	/* ranges of a new instance no surviving member is copied into (new members and padding), zero-filled after the copy */
+	u32 zero_range_count;
+	const glsl_layout_range_t* zero_ranges;
+} glsl_layout_migration_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* computes the diff and the migration plan from 'old_tree' to 'new_tree' (their memory layouts may differ), returns NULL if they can't be compared;
+ * both trees must outlive the migration (diff entries point into them); allocator: [optional] see glsl_allocator.h, the copy plan is allocated from it too */
+GLSLCOM_API glsl_layout_migration_t* glsl_layout_migration_create(const glsl_layout_tree_t* old_tree, const glsl_layout_tree_t* new_tree, const glsl_allocator_t* allocator);
+GLSLCOM_API void glsl_layout_migration_destroy(glsl_layout_migration_t* migration);
+/* returns the entry of the member named 'name' in either layout (a direct member of the block), NULL if there is no such member */
+GLSLCOM_API const glsl_layout_diff_entry_t* glsl_layout_migration_find(const glsl_layout_migration_t* migration, const char* name);
+/* migrates 'count' old instances 'src_stride' bytes apart in 'src' into 'count' new instances 'dst_stride' bytes apart in 'dst', which must not overlap */
+GLSLCOM_API void glsl_layout_migration_execute(const glsl_layout_migration_t* migration, void* dst, u32 dst_stride, const void* src, u32 src_stride, u64 count);
+/* migrates 'count' old instances 'old_stride' bytes apart in 'data' into new instances 'new_stride' bytes apart in the same memory,
+ * which must be large enough for both; instances which change size (or plans which aren't is_in_place) are saved into a scratch instance one at a time */
+GLSLCOM_API void glsl_layout_migration_execute_in_place(const glsl_layout_migration_t* migration, void* data, u32 old_stride, u32 new_stride, u64 count);
+
+END_CPP_COMPATIBLE
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_allocator.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+/* maximum number of dimensions of an array of arrays (float a[2][3][4] has 3) */
+#define GLSL_MAX_ARRAY_DIMENSIONS 4
+/* maximum nesting of structs in a block, deeper (or self referencing) descriptions are rejected */
+#define GLSL_LAYOUT_TREE_MAX_DEPTH 16
+/* maximum number of runtime indices of a glsl_layout_accessor_t (summed over all arrays along its path) */
+#define GLSL_LAYOUT_ACCESSOR_MAX_INDICES 8
+
+typedef struct glsl_struct_desc_t glsl_struct_desc_t;
+
+/* declaration of a member of a struct (or block) */
+typedef struct glsl_member_desc_t
+{
+	const char* name;
+	/* GLSL_TYPE_UNDEFINED if the member is a struct described by 'struct_desc' */
+	glsl_type_t type;
+	const glsl_struct_desc_t* struct_desc;
+	/* 0 if the member is not an array */
+	u32 array_dimension_count;
+	/* length of each dimension, outermost first (float a[2][3] --> { 2, 3 }), each must be at least 1 */
+	u32 array_lengths[GLSL_MAX_ARRAY_DIMENSIONS];
+	/* true if a matrix member is declared row_major */
+	bool is_row_major;
+} glsl_member_desc_t;
+
+/* declaration of a struct (or block), struct descriptions can be shared by any number of members */
+struct glsl_struct_desc_t
+{
+	const char* name;
+	u32 member_count;
+	const glsl_member_desc_t* members;
+};
+
+/* resolved layout of a member (or of the block itself, which is the root of the tree) */
+typedef struct glsl_layout_node_t
+{
+	const char* name;
+	/* GLSL_TYPE_UNDEFINED for structs */
+	glsl_type_t type;
+	/* true for row_major matrices, laid out as arrays of their rows */
+	bool is_row_major;
+	/* offset (in bytes) relative to the start of the parent struct */
+	u32 offset;
+	u32 align;
+	/* size of the whole member, including every array element */
+	u32 size;
+	/* size of one (innermost) element, the padded size for structs */
+	u32 element_size;
+	u32 array_dimension_count;
+	/* length of each dimension, outermost first */
+	u32 array_lengths[GLSL_MAX_ARRAY_DIMENSIONS];
+	/* bytes between consecutive indices of each dimension, so element [i][j] is at offset + i * array_strides[0] + j * array_strides[1] */
+	u32 array_strides[GLSL_MAX_ARRAY_DIMENSIONS];
+	/* members of the struct (in declaration order), 0 and NULL for non-struct types */
+	u32 child_count;
+	const struct glsl_layout_node_t* children;
+	/* indices into 'children' sorted by name, for lookups by name */
+	const u32* sorted_children;
+	/* fingerprint of the layout (see glsl_fingerprint.h): that of the member regardless of its offset, and for the root that of the whole block */
+	u64 fingerprint;
+} glsl_layout_node_t;
+
+/* immutable layout tree of a block, allocated as a single memory block */
+typedef struct glsl_layout_tree_t
+{
+	glsl_memory_layout_t layout;
+	/* the block itself, its size and align are those of the whole block */
+	glsl_layout_node_t root;
+} glsl_layout_tree_t;
+
+/* result of resolving a path of constant indices, e.g. "lights[3].cascades[2].viewProj" */
+typedef struct glsl_layout_location_t
+{
+	const glsl_layout_node_t* node;
+	/* offset (in bytes) from the start of the block */
+	u32 offset;
+	/* number of leading array dimensions of 'node' indexed by the path, "cascades[2]" of 'Shadow cascades[4][2]' leaves 1 dimension unindexed */
+	u32 indexed_dimension_count;
+} glsl_layout_location_t;
+
+/* result of resolving a path with runtime indices, e.g. "lights[].cascades[].viewProj";
+ * the offset of an element is then a multiply-add per runtime index, see glsl_layout_accessor_offset() */
+typedef struct glsl_layout_accessor_t
+{
+	const glsl_layout_node_t* node;
+	/* offset (in bytes) from the start of the block of the element with all runtime indices being 0 */
+	u32 base_offset;
+	u32 indexed_dimension_count;
+	/* number of "[]" in the path */
+	u32 index_count;
+	u32 strides[GLSL_LAYOUT_ACCESSOR_MAX_INDICES];
+	/* number of elements of the dimension each runtime index indexes into */
+	u32 lengths[GLSL_LAYOUT_ACCESSOR_MAX_INDICES];
+} glsl_layout_accessor_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* computes the layout tree of the block 'block_desc' under 'layout', returns NULL if the description is invalid
+ * or if any size or offset doesn't fit in 32 bits (the block would be larger than 4 GiB);
+ * allocator: [optional] see glsl_allocator.h */
+GLSLCOM_API glsl_layout_tree_t* glsl_layout_tree_create(const glsl_struct_desc_t* block_desc, glsl_memory_layout_t layout, const glsl_allocator_t* allocator);
+GLSLCOM_API void glsl_layout_tree_destroy(glsl_layout_tree_t* tree);
+/* returns the child named 'name' ('name_length' characters, need not be null terminated) of a struct node, NULL if there is no such child */
+GLSLCOM_API const glsl_layout_node_t* glsl_layout_node_find_child(const glsl_layout_node_t* node, const char* name, u32 name_length);
+/* resolves a path of member names and constant indices in O(depth) steps (each a binary search over member names), e.g. "lights[3].cascades[2].viewProj" or "lights[3]" (a whole element)
+ * returns false if the path doesn't name a member or an index is out of range */
+GLSLCOM_API bool glsl_layout_tree_resolve(const glsl_layout_tree_t* tree, const char* path, glsl_layout_location_t* out_location);
+/* same as glsl_layout_tree_resolve() but "[]" in the path stands for a runtime index, e.g. "lights[].cascades[].viewProj" */
+GLSLCOM_API bool glsl_layout_tree_get_accessor(const glsl_layout_tree_t* tree, const char* path, glsl_layout_accessor_t* out_accessor);
+
+END_CPP_COMPATIBLE
+
+/* returns the offset (in bytes) from the start of the block of the element at 'indices' (one for each "[]" of the accessor path) */
+static inline u32 glsl_layout_accessor_offset(const glsl_layout_accessor_t* accessor, const u32* indices)
+{
+	u32 offset = accessor->base_offset;
+	for(u32 i = 0; i < accessor->index_count; i++)
+	{
+		_ASSERT(indices[i] < accessor->lengths[i]);
+		offset += indices[i] * accessor->strides[i];
+	}
+	return offset;
+}
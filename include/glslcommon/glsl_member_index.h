@@ -0,0 +1,70 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_layout_tree.h>
+#include <glslcommon/glsl_allocator.h>
+
+/* maximum length of a full member path ("lights[3].cascades[2].viewProj") indexed from a glsl_layout_tree_t */
+#define GLSL_MEMBER_INDEX_MAX_PATH_LENGTH 256
+/* maximum number of constant indices in a path passed to glsl_member_index_resolve() */
+#define GLSL_MEMBER_INDEX_MAX_INDICES 8
+
+/* what a by-name lookup returns, everything needed to write the member */
+typedef struct glsl_member_index_entry_t
+{
+	/* member name, or full path for indices built from a layout tree */
+	const char* name;
+	u64 hash;
+	/* GLSL_TYPE_UNDEFINED for structs */
+	glsl_type_t type;
+	/* offset (in bytes) from the start of the block */
+	u32 offset;
+	/* size of the whole member, including every array element */
+	u32 size;
+	/* 0 if the member is not an array, otherwise the number of elements (of the outermost dimension) */
+	u32 array_length;
+	u32 array_stride;
+	/* true if a matrix member is declared row_major, 'type' is the declared type so this is needed to pack it */
+	bool is_row_major;
+	/* hash of the entry of the struct array the last "[]" of the path indexes ("lights" for "lights[].pos"), 0 if the path has no "[]" */
+	u64 outer_array_hash;
+} glsl_member_index_entry_t;
+
+/* immutable minimal perfect hash (hash and displace) from member names to glsl_member_index_entry_t,
+ * lookups are O(1): one hash, one displacement read, one entry read, and never allocate */
+typedef struct glsl_member_index_t glsl_member_index_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* returns the hash of 'name_length' characters of 'name' used by the index, callers can cache it for the *_prehashed lookups */
+GLSLCOM_API u64 glsl_member_index_hash(const char* name, u32 name_length);
+/* builds an index over the members of a flat block, 'type_traits' and 'members' are the inputs and outputs of layoutof_glsl_type_struct();
+ * returns NULL if two members have the same name; allocator: [optional] see glsl_allocator.h */
+GLSLCOM_API glsl_member_index_t* glsl_member_index_create(const char* const* names, const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, u32 member_count, const glsl_allocator_t* allocator);
+/* builds an index over every member of a layout tree by full path; a struct array is indexed once, its element as "lights[]"
+ * and the members of its elements as "lights[].pos" (at the offset of element 0), so the index grows with the tree and not with the array lengths;
+ * arrays of non-struct types are indexed by their name only ("weights", use array_stride to reach the elements);
+ * glsl_member_index_resolve() looks up paths with constant indices ("lights[3].pos") */
+GLSLCOM_API glsl_member_index_t* glsl_member_index_create_from_tree(const glsl_layout_tree_t* tree, const glsl_allocator_t* allocator);
+GLSLCOM_API void glsl_member_index_destroy(glsl_member_index_t* index);
+GLSLCOM_API u32 glsl_member_index_get_count(const glsl_member_index_t* index);
+/* returns the glsl_member_index_get_count() entries of the index, in slot (unspecified) order, to enumerate the members */
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_get_entries(const glsl_member_index_t* index);
+/* returns the entry named 'name' (null terminated), NULL if there is no such member */
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_find(const glsl_member_index_t* index, const char* name);
+/* same as glsl_member_index_find() for names which aren't null terminated */
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_find_n(const glsl_member_index_t* index, const char* name, u32 name_length);
+/* returns the entry of 'path' with its constant struct array indices replaced by "[]" ("lights[3].pos" --> "lights[].pos"),
+ * and in 'out_offset' the offset of the indexed element, i.e. the entry's offset plus index * array_stride of every struct array along the path;
+ * NULL if there is no such member or an index is out of bounds; paths without indices are looked up like glsl_member_index_find() */
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_resolve(const glsl_member_index_t* index, const char* path, u32* out_offset);
+/* copies 'path' into 'out_path' (GLSL_MEMBER_INDEX_MAX_PATH_LENGTH characters) with every constant index removed ("lights[3].pos" --> "lights[].pos"),
+ * and the indices into 'out_indices' (GLSL_MEMBER_INDEX_MAX_INDICES elements), outermost first;
+ * returns false if the path is too long, has too many indices or an index isn't a decimal integer */
+GLSLCOM_API bool glsl_member_index_split_path(const char* path, char* out_path, u32* out_path_length, u32* out_indices, u32* out_index_count);
+/* returns the entry whose name hashes to 'hash' (as returned by glsl_member_index_hash()), NULL if there is no such member;
+ * only the 64 bit hash is compared, so a name which isn't in the index may (with negligible probability) alias a member */
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_find_prehashed(const glsl_member_index_t* index, u64 hash);
+
+END_CPP_COMPATIBLE
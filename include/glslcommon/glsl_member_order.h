@@ -0,0 +1,20 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+
+BEGIN_CPP_COMPATIBLE
+
+/* finds an order of the members of a struct (or block) which reduces its padded size under 'layout'
+ * type_traits: contiguous array of 'type_traits_count' member traits (in declaration order)
+ * out_order: array of 'type_traits_count' elements to receive the declaration index of the member at each new position, i.e. out_order[new] = old
+ * out_remap: [optional] array of 'type_traits_count' elements to receive the new position of each member, i.e. out_remap[old] = new
+ * members are placed greedily, each step takes the most aligned member which needs the least padding at the current offset,
+ * so e.g. a float fills the hole after a vec3; this is a heuristic, the result isn't guaranteed to be the smallest possible order,
+ * but it is never larger than the declared order and keeps the declared order when that is as small,
+ * members of equal alignment keep their relative (declared) order;
+ * a runtime sized array must remain the last member of a storage block, so only the members before it should be passed
+ * returns alignment, padded size and array stride of the reordered struct */
+GLSLCOM_API glsl_struct_layout_t glsl_optimize_member_order(const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout, u32* out_order, u32* out_remap);
+
+END_CPP_COMPATIBLE
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+
+/* Packing writes tightly packed CPU data into a buffer laid out by layoutof_glsl_type_struct().
+ * In the tightly packed (source) data every member immediately follows the previous one without any padding,
+ * i.e. a vec3 is 3 floats, a mat3 is 9 floats (column major, row after row for row_major members) and a float[4] is 4 floats;
+ * members of GLSL_TYPE_UNDEFINED type (nested structs) are copied as opaque 'size' bytes per element.
+ * All padding bytes written into the destination are zero filled, nothing is written past the end of the last element
+ * (a strided run of 'count' elements spans (count - 1) * stride + element size bytes, the padding after its last element is left untouched). */
+
+BEGIN_CPP_COMPATIBLE
+
+/* copies 'count' elements of 'element_size' bytes from tightly packed 'src' into 'dst', placing consecutive elements 'dst_stride' bytes apart
+ * (and zero filling the padding in between them);
+ * float[] into a 16 byte stride, vec2[] (and mat2 columns) into 16 byte slots, and vec3[] (and mat3 columns) into vec4 slots have SSE2/AVX2 kernels */
+GLSLCOM_API void glsl_pack_strided(void* dst, u32 dst_stride, const void* src, u32 element_size, u32 count);
+/* reverse of glsl_pack_strided(), copies 'count' elements of 'element_size' bytes, 'src_stride' bytes apart in 'src', into tightly packed 'dst';
+ * 16 byte strided float[], vec2[] and vec3[] have SSE2 kernels */
+GLSLCOM_API void glsl_unpack_strided(void* dst, const void* src, u32 src_stride, u32 element_size, u32 count);
+/* packs a single member described by 'type_traits' and its resolved layout 'member' at 'dst + member->offset'
+ * returns the number of bytes read from 'src' */
+GLSLCOM_API u32 glsl_pack_member(void* dst, const glsl_member_layout_t* member, glsl_type_layout_traits_t type_traits, const void* src);
+/* packs 'type_traits_count' members into 'dst' (of at least 'struct_layout->size' bytes), 'members' and 'struct_layout' are the outputs of layoutof_glsl_type_struct()
+ * returns the number of bytes read from 'src' */
+GLSLCOM_API u32 glsl_pack_struct(void* dst, const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, u32 type_traits_count, const glsl_struct_layout_t* struct_layout, const void* src);
+/* writes 'count' matrices of glsl type 'type' (a float matCxR) into 'dst', 'dst_stride' bytes apart (the array stride of the member, or its size, the last matrix is not followed by padding),
+ * from row major CPU math matrices in 'src': R rows of C floats each, row after row, tightly packed (a mat3x4 is 4 rows of 3 floats);
+ * the matrices are transposed into column major, or written as they are if the member is row_major ('is_row_major'),
+ * with each column (row) padded to its stride under 'layout' and the padding zero filled; the transposition has an SSE2 kernel */
+GLSLCOM_API void glsl_pack_matrices(void* dst, u32 dst_stride, const f32* src, glsl_type_t type, bool is_row_major, glsl_memory_layout_t layout, u32 count);
+
+END_CPP_COMPATIBLE
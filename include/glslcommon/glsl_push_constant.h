@@ -0,0 +1,88 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_allocator.h>
+
+/* smallest maxPushConstantsSize a Vulkan device may report */
+#define GLSL_PUSH_CONSTANT_MIN_MAX_SIZE 128
+
+/* same values as VkShaderStageFlagBits, the bits are in pipeline order */
+typedef enum glsl_shader_stage_t
+{
+	GLSL_SHADER_STAGE_VERTEX = 0x1,
+	GLSL_SHADER_STAGE_TESSELLATION_CONTROL = 0x2,
+	GLSL_SHADER_STAGE_TESSELLATION_EVALUATION = 0x4,
+	GLSL_SHADER_STAGE_GEOMETRY = 0x8,
+	GLSL_SHADER_STAGE_FRAGMENT = 0x10,
+	GLSL_SHADER_STAGE_COMPUTE = 0x20
+} glsl_shader_stage_t;
+
+/* members of the push constant block (GLSL_TYPE_PUSH_CONSTANT) declared by a shader stage */
+typedef struct glsl_push_constant_block_t
+{
+	/* glsl_shader_stage_t bits, usually one stage but stages which share the same declaration can be given together */
+	u32 stage_flags;
+	u32 member_count;
+	const char* const* names;
+	const glsl_type_layout_traits_t* type_traits;
+} glsl_push_constant_block_t;
+
+/* same layout as VkPushConstantRange */
+typedef struct glsl_push_constant_range_t
+{
+	/* VkShaderStageFlags */
+	u32 stage_flags;
+	u32 offset;
+	u32 size;
+} glsl_push_constant_range_t;
+
+/* a member declared by one or more stages */
+typedef struct glsl_push_constant_member_t
+{
+	const char* name;
+	/* stages which declare the member */
+	u32 stage_flags;
+	/* true if the member didn't fit into the push constants and moved to the spill uniform block */
+	bool is_spilled;
+	/* offset (in bytes) in the push constant block, or in the spill uniform block if is_spilled */
+	u32 offset;
+	u32 size;
+} glsl_push_constant_member_t;
+
+/* offsets of the push constants of a pipeline, allocated as a single memory block */
+typedef struct glsl_push_constant_layout_t
+{
+	/* distinct members (by name) in the order they were first declared */
+	u32 member_count;
+	const glsl_push_constant_member_t* members;
+	/* one range per distinct extent, every stage with push constants is in exactly one range */
+	u32 range_count;
+	const glsl_push_constant_range_t* ranges;
+	/* bytes of push constants, a multiple of 4 */
+	u32 size;
+	/* number of spilled members, the stages declaring them and the size of the uniform block holding them */
+	u32 spill_count;
+	u32 spill_stage_flags;
+	u32 spill_size;
+} glsl_push_constant_layout_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* assigns push constant offsets to the members of the blocks of every stage of a pipeline,
+ * members with the same name are shared: they must have the same type in every stage and are stored once;
+ * members are grouped by the set of stages declaring them and the groups ordered by stage (vertex only, vertex and fragment, fragment only, ...)
+ * so that each stage's range stays small, members within a group are ordered by glsl_optimize_member_order() to reduce padding.
+ * Members are admitted in the order they are first declared (earlier blocks and earlier members first) as long as the total fits in 'max_size' bytes,
+ * the members which don't fit spill into a uniform block (in the same order). The shaders must declare each member with 'layout(offset = N)'
+ * and in increasing offset order.
+ * 'layout' is GLSL_STD430 for push constants unless scalar block layout is enabled, the spill uniform block uses the same layout
+ * (so struct members keep the align and size of their traits), which needs uniformBufferStandardLayout (or scalarBlockLayout) unless it is GLSL_STD140;
+ * allocator: [optional] see glsl_allocator.h
+ * returns NULL if a member is declared twice in a block or with different types in different blocks */
+GLSLCOM_API glsl_push_constant_layout_t* glsl_push_constant_layout_create(const glsl_push_constant_block_t* blocks, u32 block_count, glsl_memory_layout_t layout, u32 max_size, const glsl_allocator_t* allocator);
+GLSLCOM_API void glsl_push_constant_layout_destroy(glsl_push_constant_layout_t* layout);
+/* returns the member named 'name', NULL if no stage declares it */
+GLSLCOM_API const glsl_push_constant_member_t* glsl_push_constant_layout_find(const glsl_push_constant_layout_t* layout, const char* name);
+
+END_CPP_COMPATIBLE
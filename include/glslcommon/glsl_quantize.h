@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+
+/* Quantization encodes 32 bit float components into the storage of a glsl_component_encoding_t, e.g. normals into SNORM16 and colors into UNORM8,
+ * so that vertex buffers can use the formats returned by vkformatof_glsl_type_encoded().
+ * Every encoding rounds to nearest (ties to even); snorm clamps to [-1, 1], unorm clamps to [0, 1] and NaN encodes as -1 (snorm) or 0 (unorm);
+ * half precision overflows to infinity like IEEE 754 conversions do.
+ * Decoding follows the Vulkan fixed point conversion rules, so decode(encode(x)) is what the vertex fetch returns. */
+
+BEGIN_CPP_COMPATIBLE
+
+/* IEEE 754 single <--> half precision */
+GLSLCOM_API u16 glsl_f32_to_f16(f32 value);
+GLSLCOM_API f32 glsl_f16_to_f32(u16 value);
+
+/* single component conversions */
+GLSLCOM_API s16 glsl_f32_to_snorm16(f32 value);
+GLSLCOM_API s8 glsl_f32_to_snorm8(f32 value);
+GLSLCOM_API u16 glsl_f32_to_unorm16(f32 value);
+GLSLCOM_API u8 glsl_f32_to_unorm8(f32 value);
+GLSLCOM_API f32 glsl_snorm16_to_f32(s16 value);
+GLSLCOM_API f32 glsl_snorm8_to_f32(s8 value);
+GLSLCOM_API f32 glsl_unorm16_to_f32(u16 value);
+GLSLCOM_API f32 glsl_unorm8_to_f32(u8 value);
+
+/* encodes 'component_count' floats of 'src' into 'dst' (of component_count * sizeof_glsl_component_encoding(encoding) bytes),
+ * a vec3 stream of n vertices is 3 * n components; GLSL_COMPONENT_ENCODING_NATIVE copies the floats as they are;
+ * SSE2 kernels handle the fixed point encodings and F16C (detected at runtime) the half precision one.
+ * To pad three component vectors to the widely supported four component formats, quantize first and then spread the elements
+ * with glsl_pack_strided(), e.g. 6 byte SNORM16 normals into 8 byte slots */
+GLSLCOM_API void glsl_quantize(void* dst, const f32* src, u32 component_count, glsl_component_encoding_t encoding);
+/* reverse of glsl_quantize(), decodes 'component_count' components of 'src' into floats */
+GLSLCOM_API void glsl_dequantize(f32* dst, const void* src, u32 component_count, glsl_component_encoding_t encoding);
+
+END_CPP_COMPATIBLE
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_layout_tree.h>
+#include <glslcommon/glsl_copy_plan.h>
+
+/* Storage buffers (GLSL_TYPE_STORAGE_BUFFER blocks) may end in a runtime sized array, e.g.
+ *   layout(std430) buffer Particles { uint count; vec4 bounds; Particle particles[]; };
+ * The buffer then holds the fixed members (the header) followed by as many elements as fit in it. */
+
+/* layout of a block ending in a runtime sized array */
+typedef struct glsl_storage_array_layout_t
+{
+	/* offset (in bytes) of the first element, the size of the fixed members including the padding up to the array */
+	u32 header_size;
+	/* bytes between consecutive elements */
+	u32 element_stride;
+	/* alignment (in bytes) of the block */
+	u32 align;
+} glsl_storage_array_layout_t;
+
+/* appends elements to the runtime sized array of a mapped storage buffer, owned by one thread */
+typedef struct glsl_storage_array_writer_t
+{
+	/* mapped memory of the first element */
+	u8* elements;
+	u32 element_stride;
+	/* [optional] writes a source (CPU side) element into an element of the array, NULL if the source elements are copied as they are */
+	const glsl_copy_plan_t* plan;
+	/* number of elements which fit in the buffer */
+	u64 capacity;
+	/* number of elements appended so far */
+	u64 count;
+} glsl_storage_array_writer_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* computes the layout of a block whose fixed members are 'header_traits' ('header_count' of them, may be 0) followed by a runtime sized array of 'element_traits'
+ * (is_array and array_length of 'element_traits' are ignored, the element itself can't be an array);
+ * out_header_members: [optional] array of 'header_count' elements to receive the layouts of the fixed members */
+GLSLCOM_API glsl_storage_array_layout_t glsl_storage_array_layout(const glsl_type_layout_traits_t* header_traits, u32 header_count, glsl_type_layout_traits_t element_traits, glsl_memory_layout_t layout, glsl_member_layout_t* out_header_members);
+/* same as glsl_storage_array_layout() for a layout tree whose last member is the runtime sized array, declared with an outermost dimension of 1 ('Particle particles[1]'),
+ * inner dimensions are part of the element ('float weights[][4]' has 16 byte elements under std430); returns false if the last member isn't an array */
+GLSLCOM_API bool glsl_storage_array_layout_from_tree(const glsl_layout_tree_t* tree, glsl_storage_array_layout_t* out_layout);
+
+/* starts appending to the array of a storage buffer whose 'buffer_size' bytes are mapped at 'mapped_data' (the start of the block),
+ * the header isn't touched (e.g. the caller writes the final element count into it once it is done appending);
+ * plan: [optional] copy plan (see glsl_copy_plan.h) writing one source element into one element of the array, at most 'element_stride' bytes */
+GLSLCOM_API void glsl_storage_array_writer_init(glsl_storage_array_writer_t* writer, const glsl_storage_array_layout_t* layout, void* mapped_data, u64 buffer_size, const glsl_copy_plan_t* plan);
+/* appends 'count' source elements 'src_stride' bytes apart in 'src', writing them straight into the mapped memory;
+ * without a plan each element is 'src_stride' bytes (at most the element stride) copied as is, tightly packed sources go through glsl_pack_strided();
+ * returns the number of elements appended, less than 'count' once the buffer is full */
+GLSLCOM_API u64 glsl_storage_array_append(glsl_storage_array_writer_t* writer, const void* src, u32 src_stride, u64 count);
+
+END_CPP_COMPATIBLE
+
+/* returns the number of elements which fit in a buffer of 'buffer_size' bytes */
+static inline u64 glsl_storage_array_get_capacity(const glsl_storage_array_layout_t* layout, u64 buffer_size)
+{
+	return (buffer_size <= layout->header_size) ? 0 : ((buffer_size - layout->header_size) / layout->element_stride);
+}
+
+/* returns the size (in bytes) of a buffer holding 'element_count' elements */
+static inline u64 glsl_storage_array_get_buffer_size(const glsl_storage_array_layout_t* layout, u64 element_count)
+{
+	return layout->header_size + element_count * layout->element_stride;
+}
+
+/* reserves 'count' elements for the caller to write in place, returns their mapped memory and the index of the first of them,
+ * or NULL if fewer than 'count' elements are left */
+static inline void* glsl_storage_array_writer_reserve(glsl_storage_array_writer_t* writer, u64 count, u64* out_first_index)
+{
+	if(count > (writer->capacity - writer->count))
+		return NULL;
+	*out_first_index = writer->count;
+	writer->count += count;
+	return writer->elements + *out_first_index * writer->element_stride;
+}
+
+/* discards every appended element, e.g. at the start of a frame */
+static inline void glsl_storage_array_writer_reset(glsl_storage_array_writer_t* writer)
+{
+	writer->count = 0;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glslcommon/defines.h>
+#include <glslcommon/debug.h>
 
 typedef enum glsl_memory_layout_t
 {
@@ -9,7 +10,8 @@ typedef enum glsl_memory_layout_t
 	GLSL_STD430,
 	GLSL_MEMORY_LAYOUT_BASE = GLSL_STD430,
 	GLSL_STD140,
-	GLSL_MEMORY_LAYOUT_EXTENDED = GLSL_STD140
+	GLSL_MEMORY_LAYOUT_EXTENDED = GLSL_STD140,
+	GLSL_MEMORY_LAYOUT_MAX
 } glsl_memory_layout_t;
 
 typedef enum glsl_type_t
@@ -45,6 +47,32 @@ typedef enum glsl_type_t
 	GLSL_TYPE_DMAT3 = 27ULL,
 	GLSL_TYPE_DMAT4	= 28ULL,
 
+	/* explicit arithmetic types (GL_EXT_shader_explicit_arithmetic_types), the 8 and 16 bit integer scalars are GLSL_TYPE_U8 ... GLSL_TYPE_S16 */
+	GLSL_TYPE_F16 		= 29ULL,
+	GLSL_TYPE_F16VEC2 	= 30ULL,
+	GLSL_TYPE_F16VEC3 	= 31ULL,
+	GLSL_TYPE_F16VEC4 	= 32ULL,
+	GLSL_TYPE_I16VEC2 	= 33ULL,
+	GLSL_TYPE_I16VEC3 	= 34ULL,
+	GLSL_TYPE_I16VEC4 	= 35ULL,
+	GLSL_TYPE_U16VEC2 	= 36ULL,
+	GLSL_TYPE_U16VEC3 	= 37ULL,
+	GLSL_TYPE_U16VEC4 	= 38ULL,
+	GLSL_TYPE_I8VEC2 	= 39ULL,
+	GLSL_TYPE_I8VEC3 	= 40ULL,
+	GLSL_TYPE_I8VEC4 	= 41ULL,
+	GLSL_TYPE_U8VEC2 	= 42ULL,
+	GLSL_TYPE_U8VEC3 	= 43ULL,
+	GLSL_TYPE_U8VEC4 	= 44ULL,
+
+	/* non-square matrices, matCxR has C columns of R components (MAT3X4 --> array of 3 VEC4) */
+	GLSL_TYPE_MAT2X3 	= 45ULL,
+	GLSL_TYPE_MAT2X4 	= 46ULL,
+	GLSL_TYPE_MAT3X2 	= 47ULL,
+	GLSL_TYPE_MAT3X4 	= 48ULL,
+	GLSL_TYPE_MAT4X2 	= 49ULL,
+	GLSL_TYPE_MAT4X3 	= 50ULL,
+
 	GLSL_TYPE_MAX_NON_OPAQUE,
 
 	GLSL_TYPE_BLOCK,
@@ -58,10 +86,19 @@ typedef enum glsl_type_t
 	GLSL_TYPE_SAMPLER_CUBE,
 	GLSL_TYPE_SUBPASS_INPUT,
 
+	GLSL_TYPE_MAX,
+
 	GLSL_TYPE_FLOAT = GLSL_TYPE_F32,
 	GLSL_TYPE_INT = GLSL_TYPE_S32,
 	GLSL_TYPE_UINT = GLSL_TYPE_U32,
-	GLSL_TYPE_DOUBLE = GLSL_TYPE_F64
+	GLSL_TYPE_DOUBLE = GLSL_TYPE_F64,
+	GLSL_TYPE_FLOAT16 = GLSL_TYPE_F16,
+	GLSL_TYPE_INT8 = GLSL_TYPE_S8,
+	GLSL_TYPE_UINT8 = GLSL_TYPE_U8,
+	GLSL_TYPE_INT16 = GLSL_TYPE_S16,
+	GLSL_TYPE_UINT16 = GLSL_TYPE_U16,
+	GLSL_TYPE_INT64 = GLSL_TYPE_S64,
+	GLSL_TYPE_UINT64 = GLSL_TYPE_U64
 } glsl_type_t;
 
 typedef struct glsl_type_layout_traits_t
@@ -74,19 +111,259 @@ typedef struct glsl_type_layout_traits_t
 	u32 align;
 	/* size of GLSL_TYPE_UNDEFINED type */
 	u32 size;
+	/* number of elements if is_array is true, 0 is treated as 1 */
+	u32 array_length;
+	/* true if a matrix type is declared row_major, it is then laid out as an array of its rows (see layout_typeof_glsl_type()) */
+	bool is_row_major;
 } glsl_type_layout_traits_t;
 
+/* resolved layout information of a single member of a struct */
+typedef struct glsl_member_layout_t
+{
+	/* offset (in bytes) of this member from the start of the struct */
+	u32 offset;
+	/* alignment (in bytes) of this member */
+	u32 align;
+	/* size (in bytes) occupied by this member, for arrays it is array_stride * array_length */
+	u32 size;
+	/* stride (in bytes) between consecutive elements if this member is an array, otherwise 0 */
+	u32 array_stride;
+} glsl_member_layout_t;
+
+/* resolved layout information of a struct (or block) */
+typedef struct glsl_struct_layout_t
+{
+	/* alignment (in bytes) of the struct */
+	u32 align;
+	/* size (in bytes) of the struct, padded to a multiple of its alignment */
+	u32 size;
+	/* stride (in bytes) between consecutive elements in an array of this struct */
+	u32 array_stride;
+} glsl_struct_layout_t;
+
+/* how the components of a float vertex input (float, vec2, vec3, vec4) are stored in the vertex buffer,
+ * the shader still reads 32 bit floats, the vertex fetch converts the stored components */
+typedef enum glsl_component_encoding_t
+{
+	/* as the type declares them, 32 bit floats for vecN */
+	GLSL_COMPONENT_ENCODING_NATIVE = 0,
+	/* IEEE 754 half precision floats */
+	GLSL_COMPONENT_ENCODING_HALF,
+	/* fixed point normalized to [-1, 1] (normals, tangents) */
+	GLSL_COMPONENT_ENCODING_SNORM16,
+	GLSL_COMPONENT_ENCODING_SNORM8,
+	/* fixed point normalized to [0, 1] (texture coordinates, colors) */
+	GLSL_COMPONENT_ENCODING_UNORM16,
+	GLSL_COMPONENT_ENCODING_UNORM8,
+	GLSL_COMPONENT_ENCODING_MAX
+} glsl_component_encoding_t;
+
+/* X(LAYOUT, type, NAME, size) lists every non-opaque type for which alignment and size are defined,
+ * 'NAME' selects the GLSL_<LAYOUT>_<NAME>_ALIGN and GLSL_<LAYOUT>_<NAME>_ARR_ALIGN macros,
+ * 'size' is the size of a single value of the type under 'LAYOUT'. */
+#define GLSL_TYPE_LAYOUT_LIST(X, LAYOUT) \
+	X(LAYOUT, GLSL_TYPE_FLOAT,  FLOAT,  4) /* IEEE 745 double precision float has 32 bits */ \
+	X(LAYOUT, GLSL_TYPE_INT,    INT,    4) /* GLSL spec states 32-bits for int */ \
+	X(LAYOUT, GLSL_TYPE_UINT,   UINT,   4) /* GLSL spec states 32-bits for uint */ \
+	X(LAYOUT, GLSL_TYPE_DOUBLE, DOUBLE, 8) /* IEEE 745 double precision float has 64 bits */ \
+	X(LAYOUT, GLSL_TYPE_IVEC2,  IVEC2,  8) \
+	X(LAYOUT, GLSL_TYPE_UVEC2,  UVEC2,  8) \
+	X(LAYOUT, GLSL_TYPE_VEC2,   VEC2,   8) \
+	X(LAYOUT, GLSL_TYPE_DVEC2,  DVEC2,  16) \
+	X(LAYOUT, GLSL_TYPE_IVEC3,  IVEC3,  12) \
+	X(LAYOUT, GLSL_TYPE_UVEC3,  UVEC3,  12) \
+	X(LAYOUT, GLSL_TYPE_VEC3,   VEC3,   12) \
+	X(LAYOUT, GLSL_TYPE_DVEC3,  DVEC3,  24) \
+	X(LAYOUT, GLSL_TYPE_IVEC4,  IVEC4,  16) \
+	X(LAYOUT, GLSL_TYPE_UVEC4,  UVEC4,  16) \
+	X(LAYOUT, GLSL_TYPE_VEC4,   VEC4,   16) \
+	X(LAYOUT, GLSL_TYPE_DVEC4,  DVEC4,  32) \
+	/* explicit arithmetic types, a scalar of N bytes is aligned to N bytes and vectors follow the same rules as their 32 bit counterparts */ \
+	X(LAYOUT, GLSL_TYPE_INT8,    INT8,    1) \
+	X(LAYOUT, GLSL_TYPE_UINT8,   UINT8,   1) \
+	X(LAYOUT, GLSL_TYPE_INT16,   INT16,   2) \
+	X(LAYOUT, GLSL_TYPE_UINT16,  UINT16,  2) \
+	X(LAYOUT, GLSL_TYPE_FLOAT16, FLOAT16, 2) /* IEEE 754 half precision float has 16 bits */ \
+	X(LAYOUT, GLSL_TYPE_INT64,   INT64,   8) \
+	X(LAYOUT, GLSL_TYPE_UINT64,  UINT64,  8) \
+	X(LAYOUT, GLSL_TYPE_I8VEC2,  I8VEC2,  2) \
+	X(LAYOUT, GLSL_TYPE_U8VEC2,  U8VEC2,  2) \
+	X(LAYOUT, GLSL_TYPE_I16VEC2, I16VEC2, 4) \
+	X(LAYOUT, GLSL_TYPE_U16VEC2, U16VEC2, 4) \
+	X(LAYOUT, GLSL_TYPE_F16VEC2, F16VEC2, 4) \
+	X(LAYOUT, GLSL_TYPE_I8VEC3,  I8VEC3,  3) \
+	X(LAYOUT, GLSL_TYPE_U8VEC3,  U8VEC3,  3) \
+	X(LAYOUT, GLSL_TYPE_I16VEC3, I16VEC3, 6) \
+	X(LAYOUT, GLSL_TYPE_U16VEC3, U16VEC3, 6) \
+	X(LAYOUT, GLSL_TYPE_F16VEC3, F16VEC3, 6) \
+	X(LAYOUT, GLSL_TYPE_I8VEC4,  I8VEC4,  4) \
+	X(LAYOUT, GLSL_TYPE_U8VEC4,  U8VEC4,  4) \
+	X(LAYOUT, GLSL_TYPE_I16VEC4, I16VEC4, 8) \
+	X(LAYOUT, GLSL_TYPE_U16VEC4, U16VEC4, 8) \
+	X(LAYOUT, GLSL_TYPE_F16VEC4, F16VEC4, 8) \
+	/* MAT2 --> array of VEC2, MAT3 --> array of VEC3, MAT4 --> array of VEC4 (column major) */ \
+	X(LAYOUT, GLSL_TYPE_MAT2,   MAT2,   2 * U32_NEXT_MULTIPLE(8, GLSL_##LAYOUT##_VEC2_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_MAT3,   MAT3,   3 * U32_NEXT_MULTIPLE(12, GLSL_##LAYOUT##_VEC3_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_MAT4,   MAT4,   4 * U32_NEXT_MULTIPLE(16, GLSL_##LAYOUT##_VEC4_ARR_ALIGN)) \
+	/* MAT2X3 --> array of 2 VEC3, MAT3X4 --> array of 3 VEC4, ... (column major) */ \
+	X(LAYOUT, GLSL_TYPE_MAT2X3, MAT2X3, 2 * U32_NEXT_MULTIPLE(12, GLSL_##LAYOUT##_VEC3_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_MAT2X4, MAT2X4, 2 * U32_NEXT_MULTIPLE(16, GLSL_##LAYOUT##_VEC4_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_MAT3X2, MAT3X2, 3 * U32_NEXT_MULTIPLE(8, GLSL_##LAYOUT##_VEC2_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_MAT3X4, MAT3X4, 3 * U32_NEXT_MULTIPLE(16, GLSL_##LAYOUT##_VEC4_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_MAT4X2, MAT4X2, 4 * U32_NEXT_MULTIPLE(8, GLSL_##LAYOUT##_VEC2_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_MAT4X3, MAT4X3, 4 * U32_NEXT_MULTIPLE(12, GLSL_##LAYOUT##_VEC3_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_DMAT2,  DMAT2,  2 * U32_NEXT_MULTIPLE(16, GLSL_##LAYOUT##_DVEC2_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_DMAT3,  DMAT3,  3 * U32_NEXT_MULTIPLE(24, GLSL_##LAYOUT##_DVEC3_ARR_ALIGN)) \
+	X(LAYOUT, GLSL_TYPE_DMAT4,  DMAT4,  4 * U32_NEXT_MULTIPLE(32, GLSL_##LAYOUT##_DVEC4_ARR_ALIGN))
+
+BEGIN_CPP_COMPATIBLE
+
+/* precomputed lookup tables indexed as [layout][is_array][type], entries for which a property is not defined are 0 */
+/* alignment (in bytes) of a glsl type 'type' (is_array = false), or of an array of glsl type 'type' (is_array = true) */
+GLSLCOM_API extern const u32 glsl_type_align_table[GLSL_MEMORY_LAYOUT_MAX][2][GLSL_TYPE_MAX];
+/* size (in bytes) of a glsl type 'type' (is_array = false), or stride (in bytes) of an array of glsl type 'type' (is_array = true) */
+GLSLCOM_API extern const u32 glsl_type_size_table[GLSL_MEMORY_LAYOUT_MAX][2][GLSL_TYPE_MAX];
+/* VkFormat (u32) of a glsl type 'type', the format of one column for matrices */
+GLSLCOM_API extern const u32 glsl_type_vkformat_table[GLSL_TYPE_MAX];
+/* VkFormat (u32) of a float vertex input whose components are stored with a glsl_component_encoding_t other than GLSL_COMPONENT_ENCODING_NATIVE */
+GLSLCOM_API extern const u32 glsl_type_encoded_vkformat_table[GLSL_COMPONENT_ENCODING_MAX][GLSL_TYPE_MAX];
+
+/* same as table[layout][is_array][type] but reports invalid layouts and types for which the property is not defined;
+ * the inline accessors below only use it in debug builds, the struct layout functions always do */
+GLSLCOM_API u32 glsl_type_table_lookup(const u32 table[GLSL_MEMORY_LAYOUT_MAX][2][GLSL_TYPE_MAX], glsl_memory_layout_t layout, bool is_array, glsl_type_t type);
+#ifdef GLSLCOM_DEBUG
+#	define GLSL_TYPE_TABLE_LOOKUP(table, layout, is_array, type) glsl_type_table_lookup(table, layout, is_array, type)
+#else
+#	define GLSL_TYPE_TABLE_LOOKUP(table, layout, is_array, type) ((table)[layout][is_array][type])
+#endif /* GLSLCOM_DEBUG */
+
 /* returns alignment (in bytes) of a glsl type 'type' */
-GLSLCOM_API u32 alignof_glsl_type(glsl_type_t type, glsl_memory_layout_t layout);
-GLSLCOM_API u32 alignof_glsl_type_array(glsl_type_t type, glsl_memory_layout_t layout);
+static inline u32 alignof_glsl_type(glsl_type_t type, glsl_memory_layout_t layout)
+{
+	return GLSL_TYPE_TABLE_LOOKUP(glsl_type_align_table, layout, false, type);
+}
+static inline u32 alignof_glsl_type_array(glsl_type_t type, glsl_memory_layout_t layout)
+{
+	return GLSL_TYPE_TABLE_LOOKUP(glsl_type_align_table, layout, true, type);
+}
 typedef glsl_type_layout_traits_t (*glsl_type_layout_traits_callback_t)(void* user_data, u32 type_index);
 GLSLCOM_API u32 alignof_glsl_type_struct(glsl_type_layout_traits_callback_t callback, void* user_data, u32 type_traits_count, glsl_memory_layout_t layout);
 #define alignof_glsl_type_struct_array alignof_glsl_type_struct
+/* computes the layout of a struct by walking its members only once
+ * type_traits: contiguous array of 'type_traits_count' member traits (in declaration order)
+ * out_members: [optional] array of 'type_traits_count' elements to receive offset, alignment, size and array stride of each member
+ * returns alignment, padded size and array stride of the struct */
+GLSLCOM_API glsl_struct_layout_t layoutof_glsl_type_struct(const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout, glsl_member_layout_t* out_members);
+
+/* returns size (in bytes) of a glsl type 'type', matrices are sized as arrays of column vectors in the given layout */
+static inline u32 sizeof_glsl_type(glsl_type_t type, glsl_memory_layout_t layout)
+{
+	return GLSL_TYPE_TABLE_LOOKUP(glsl_type_size_table, layout, false, type);
+}
+/* returns stride (in bytes) between consecutive elements of an array of glsl type 'type' */
+static inline u32 strideof_glsl_type_array(glsl_type_t type, glsl_memory_layout_t layout)
+{
+	return GLSL_TYPE_TABLE_LOOKUP(glsl_type_size_table, layout, true, type);
+}
+/* returns VkFormat (u32) of a glsl type 'type', for matrices this is the format of one column, as each column is a separate vertex attribute */
+static inline u32 vkformatof_glsl_type(glsl_type_t type)
+{
+	return glsl_type_vkformat_table[type];
+}
+/* returns number of column vectors of a matrix type (MAT3 --> array of VEC3), 1 for every other type */
+static inline u32 columnsof_glsl_type(glsl_type_t type)
+{
+	switch(type)
+	{
+		case GLSL_TYPE_MAT2			:
+		case GLSL_TYPE_MAT2X3		:
+		case GLSL_TYPE_MAT2X4		:
+		case GLSL_TYPE_DMAT2		: return 2;
+		case GLSL_TYPE_MAT3			:
+		case GLSL_TYPE_MAT3X2		:
+		case GLSL_TYPE_MAT3X4		:
+		case GLSL_TYPE_DMAT3		: return 3;
+		case GLSL_TYPE_MAT4			:
+		case GLSL_TYPE_MAT4X2		:
+		case GLSL_TYPE_MAT4X3		:
+		case GLSL_TYPE_DMAT4		: return 4;
+		default						: return 1;
+	}
+}
+/* returns the matrix type with columns and rows swapped (MAT3X4 --> MAT4X3), the type itself for square matrices and every other type */
+static inline glsl_type_t transposeof_glsl_type(glsl_type_t type)
+{
+	switch(type)
+	{
+		case GLSL_TYPE_MAT2X3		: return GLSL_TYPE_MAT3X2;
+		case GLSL_TYPE_MAT2X4		: return GLSL_TYPE_MAT4X2;
+		case GLSL_TYPE_MAT3X2		: return GLSL_TYPE_MAT2X3;
+		case GLSL_TYPE_MAT3X4		: return GLSL_TYPE_MAT4X3;
+		case GLSL_TYPE_MAT4X2		: return GLSL_TYPE_MAT2X4;
+		case GLSL_TYPE_MAT4X3		: return GLSL_TYPE_MAT3X4;
+		default						: return type;
+	}
+}
+/* returns number of rows (components of a column) of a matrix type (MAT3X4 --> 4), 1 for every other type */
+static inline u32 rowsof_glsl_type(glsl_type_t type)
+{
+	return (columnsof_glsl_type(type) == 1) ? 1 : columnsof_glsl_type(transposeof_glsl_type(type));
+}
+/* returns the type whose (column major) layout a type has, a row_major matCxR is laid out as an array of its R rows, exactly like a matRxC;
+ * the alignment, size and stride of a row_major matrix are those of alignof_glsl_type(layout_typeof_glsl_type(type, true), layout) and so on */
+static inline glsl_type_t layout_typeof_glsl_type(glsl_type_t type, bool is_row_major)
+{
+	return is_row_major ? transposeof_glsl_type(type) : type;
+}
+/* returns number of vertex input locations consumed by a glsl type 'type', one per column, and two per column for dvec3 and dvec4 columns */
+static inline u32 locationsof_glsl_type(glsl_type_t type)
+{
+	switch(type)
+	{
+		case GLSL_TYPE_DVEC3		:
+		case GLSL_TYPE_DVEC4		: return 2;
+		case GLSL_TYPE_DMAT3		: return 6;
+		case GLSL_TYPE_DMAT4		: return 8;
+		default						: return columnsof_glsl_type(type);
+	}
+}
+/* returns size (in bytes) of one component stored with 'encoding', 0 for GLSL_COMPONENT_ENCODING_NATIVE as that depends on the type */
+static inline u32 sizeof_glsl_component_encoding(glsl_component_encoding_t encoding)
+{
+	switch(encoding)
+	{
+		case GLSL_COMPONENT_ENCODING_HALF		:
+		case GLSL_COMPONENT_ENCODING_SNORM16	:
+		case GLSL_COMPONENT_ENCODING_UNORM16	: return 2;
+		case GLSL_COMPONENT_ENCODING_SNORM8		:
+		case GLSL_COMPONENT_ENCODING_UNORM8		: return 1;
+		default									: return 0;
+	}
+}
+/* returns VkFormat (u32) of a glsl type 'type' whose components are stored with 'encoding', e.g. VK_FORMAT_R16G16B16A16_SNORM for GLSL_TYPE_VEC4 and GLSL_COMPONENT_ENCODING_SNORM16,
+ * VK_FORMAT_UNDEFINED if the type can't be stored with 'encoding' (only float, vec2, vec3 and vec4 can be encoded);
+ * note that many implementations don't support three component 8 and 16 bit vertex formats, a padded four component vector is the portable choice */
+static inline u32 vkformatof_glsl_type_encoded(glsl_type_t type, glsl_component_encoding_t encoding)
+{
+	return (encoding == GLSL_COMPONENT_ENCODING_NATIVE) ? glsl_type_vkformat_table[type] : glsl_type_encoded_vkformat_table[encoding][type];
+}
+/* returns size (in bytes) of a value of glsl type 'type' stored with 'encoding', for matrices this is the size of all of its (scalar layout) columns */
+static inline u32 sizeof_glsl_type_encoded(glsl_type_t type, glsl_component_encoding_t encoding)
+{
+	u32 size = sizeof_glsl_type(type, GLSL_SCALAR);
+	/* encodable types have 4 byte components */
+	return (encoding == GLSL_COMPONENT_ENCODING_NATIVE) ? size : ((size >> 2) * sizeof_glsl_component_encoding(encoding));
+}
+
+/* batched versions of the above, each resolves 'count' types in one call and writes the results into 'out_*' (of 'count' elements),
+ * types for which a property is not defined resolve to 0 (VK_FORMAT_UNDEFINED for vkformatof_glsl_types), invalid types and layouts are fatal errors */
+GLSLCOM_API void alignof_glsl_types(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_aligns);
+GLSLCOM_API void alignof_glsl_types_array(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_aligns);
+GLSLCOM_API void sizeof_glsl_types(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_sizes);
+GLSLCOM_API void strideof_glsl_types_array(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_strides);
+GLSLCOM_API void vkformatof_glsl_types(const glsl_type_t* types, u32 count, u32* out_formats);
 
-/* returns size (in bytes) of a glsl type 'type' */
-GLSLCOM_API u32 sizeof_glsl_type(glsl_type_t type, glsl_memory_layout_t layout);
-/* returns VkFormat (u32) of a glsl type 'type' */
-GLSLCOM_API u32 vkformatof_glsl_type(glsl_type_t type);
+END_CPP_COMPATIBLE
 
 /* Scalary Layout */
 #define GLSL_SCALAR_FLOAT_ALIGN            	4 /* IEEE 745 double precision float has 32 bits */
@@ -133,6 +410,63 @@ GLSLCOM_API u32 vkformatof_glsl_type(glsl_type_t type);
 #define GLSL_SCALAR_DMAT3_ARR_ALIGN			GLSL_SCALAR_DMAT3_ALIGN
 #define GLSL_SCALAR_DMAT4_ALIGN            	GLSL_SCALAR_DVEC4_ARR_ALIGN /* Recursively DMAT2 --> array of DVEC2, DMAT3 --> array of DVEC3, DMAT4 --> array of DVEC4 */
 #define GLSL_SCALAR_DMAT4_ARR_ALIGN			GLSL_SCALAR_DMAT4_ALIGN
+#define GLSL_SCALAR_MAT2X3_ALIGN           	GLSL_SCALAR_VEC3_ARR_ALIGN /* MAT2X3 --> array of 2 VEC3, the alignment of a column */
+#define GLSL_SCALAR_MAT2X3_ARR_ALIGN			GLSL_SCALAR_MAT2X3_ALIGN
+#define GLSL_SCALAR_MAT2X4_ALIGN           	GLSL_SCALAR_VEC4_ARR_ALIGN
+#define GLSL_SCALAR_MAT2X4_ARR_ALIGN			GLSL_SCALAR_MAT2X4_ALIGN
+#define GLSL_SCALAR_MAT3X2_ALIGN           	GLSL_SCALAR_VEC2_ARR_ALIGN
+#define GLSL_SCALAR_MAT3X2_ARR_ALIGN			GLSL_SCALAR_MAT3X2_ALIGN
+#define GLSL_SCALAR_MAT3X4_ALIGN           	GLSL_SCALAR_VEC4_ARR_ALIGN
+#define GLSL_SCALAR_MAT3X4_ARR_ALIGN			GLSL_SCALAR_MAT3X4_ALIGN
+#define GLSL_SCALAR_MAT4X2_ALIGN           	GLSL_SCALAR_VEC2_ARR_ALIGN
+#define GLSL_SCALAR_MAT4X2_ARR_ALIGN			GLSL_SCALAR_MAT4X2_ALIGN
+#define GLSL_SCALAR_MAT4X3_ALIGN           	GLSL_SCALAR_VEC3_ARR_ALIGN
+#define GLSL_SCALAR_MAT4X3_ARR_ALIGN			GLSL_SCALAR_MAT4X3_ALIGN
+/* explicit arithmetic types */
+#define GLSL_SCALAR_INT8_ALIGN				1 /* 8 bit members of buffers need the storageBuffer8BitAccess family of features */
+#define GLSL_SCALAR_INT8_ARR_ALIGN			GLSL_SCALAR_INT8_ALIGN
+#define GLSL_SCALAR_UINT8_ALIGN				1
+#define GLSL_SCALAR_UINT8_ARR_ALIGN			GLSL_SCALAR_UINT8_ALIGN
+#define GLSL_SCALAR_INT16_ALIGN				2 /* 16 bit members of buffers need the storageBuffer16BitAccess family of features */
+#define GLSL_SCALAR_INT16_ARR_ALIGN			GLSL_SCALAR_INT16_ALIGN
+#define GLSL_SCALAR_UINT16_ALIGN			2
+#define GLSL_SCALAR_UINT16_ARR_ALIGN		GLSL_SCALAR_UINT16_ALIGN
+#define GLSL_SCALAR_FLOAT16_ALIGN			2 /* IEEE 754 half precision float has 16 bits */
+#define GLSL_SCALAR_FLOAT16_ARR_ALIGN		GLSL_SCALAR_FLOAT16_ALIGN
+#define GLSL_SCALAR_INT64_ALIGN				8
+#define GLSL_SCALAR_INT64_ARR_ALIGN			GLSL_SCALAR_INT64_ALIGN
+#define GLSL_SCALAR_UINT64_ALIGN			8
+#define GLSL_SCALAR_UINT64_ARR_ALIGN		GLSL_SCALAR_UINT64_ALIGN
+#define GLSL_SCALAR_I8VEC2_ALIGN			GLSL_SCALAR_INT8_ALIGN
+#define GLSL_SCALAR_I8VEC2_ARR_ALIGN		GLSL_SCALAR_I8VEC2_ALIGN
+#define GLSL_SCALAR_I8VEC3_ALIGN			GLSL_SCALAR_INT8_ALIGN
+#define GLSL_SCALAR_I8VEC3_ARR_ALIGN		GLSL_SCALAR_I8VEC3_ALIGN
+#define GLSL_SCALAR_I8VEC4_ALIGN			GLSL_SCALAR_INT8_ALIGN
+#define GLSL_SCALAR_I8VEC4_ARR_ALIGN		GLSL_SCALAR_I8VEC4_ALIGN
+#define GLSL_SCALAR_U8VEC2_ALIGN			GLSL_SCALAR_UINT8_ALIGN
+#define GLSL_SCALAR_U8VEC2_ARR_ALIGN		GLSL_SCALAR_U8VEC2_ALIGN
+#define GLSL_SCALAR_U8VEC3_ALIGN			GLSL_SCALAR_UINT8_ALIGN
+#define GLSL_SCALAR_U8VEC3_ARR_ALIGN		GLSL_SCALAR_U8VEC3_ALIGN
+#define GLSL_SCALAR_U8VEC4_ALIGN			GLSL_SCALAR_UINT8_ALIGN
+#define GLSL_SCALAR_U8VEC4_ARR_ALIGN		GLSL_SCALAR_U8VEC4_ALIGN
+#define GLSL_SCALAR_I16VEC2_ALIGN			GLSL_SCALAR_INT16_ALIGN
+#define GLSL_SCALAR_I16VEC2_ARR_ALIGN		GLSL_SCALAR_I16VEC2_ALIGN
+#define GLSL_SCALAR_I16VEC3_ALIGN			GLSL_SCALAR_INT16_ALIGN
+#define GLSL_SCALAR_I16VEC3_ARR_ALIGN		GLSL_SCALAR_I16VEC3_ALIGN
+#define GLSL_SCALAR_I16VEC4_ALIGN			GLSL_SCALAR_INT16_ALIGN
+#define GLSL_SCALAR_I16VEC4_ARR_ALIGN		GLSL_SCALAR_I16VEC4_ALIGN
+#define GLSL_SCALAR_U16VEC2_ALIGN			GLSL_SCALAR_UINT16_ALIGN
+#define GLSL_SCALAR_U16VEC2_ARR_ALIGN		GLSL_SCALAR_U16VEC2_ALIGN
+#define GLSL_SCALAR_U16VEC3_ALIGN			GLSL_SCALAR_UINT16_ALIGN
+#define GLSL_SCALAR_U16VEC3_ARR_ALIGN		GLSL_SCALAR_U16VEC3_ALIGN
+#define GLSL_SCALAR_U16VEC4_ALIGN			GLSL_SCALAR_UINT16_ALIGN
+#define GLSL_SCALAR_U16VEC4_ARR_ALIGN		GLSL_SCALAR_U16VEC4_ALIGN
+#define GLSL_SCALAR_F16VEC2_ALIGN			GLSL_SCALAR_FLOAT16_ALIGN
+#define GLSL_SCALAR_F16VEC2_ARR_ALIGN		GLSL_SCALAR_F16VEC2_ALIGN
+#define GLSL_SCALAR_F16VEC3_ALIGN			GLSL_SCALAR_FLOAT16_ALIGN
+#define GLSL_SCALAR_F16VEC3_ARR_ALIGN		GLSL_SCALAR_F16VEC3_ALIGN
+#define GLSL_SCALAR_F16VEC4_ALIGN			GLSL_SCALAR_FLOAT16_ALIGN
+#define GLSL_SCALAR_F16VEC4_ARR_ALIGN		GLSL_SCALAR_F16VEC4_ALIGN
 
 /* (std430) Base Layout */
 #define GLSL_STD430_FLOAT_ALIGN            	GLSL_SCALAR_FLOAT_ALIGN /* IEEE 745 double precision float has 32 bits */
@@ -179,6 +513,63 @@ GLSLCOM_API u32 vkformatof_glsl_type(glsl_type_t type);
 #define GLSL_STD430_DMAT3_ARR_ALIGN			GLSL_STD430_DMAT3_ALIGN
 #define GLSL_STD430_DMAT4_ALIGN            	GLSL_STD430_DVEC4_ARR_ALIGN /* Recursively DMAT2 --> array of DVEC2, DMAT3 --> array of DVEC3, DMAT4 --> array of DVEC4 */
 #define GLSL_STD430_DMAT4_ARR_ALIGN			GLSL_STD430_DMAT4_ALIGN
+#define GLSL_STD430_MAT2X3_ALIGN           	GLSL_STD430_VEC3_ARR_ALIGN /* MAT2X3 --> array of 2 VEC3, the alignment of a column */
+#define GLSL_STD430_MAT2X3_ARR_ALIGN			GLSL_STD430_MAT2X3_ALIGN
+#define GLSL_STD430_MAT2X4_ALIGN           	GLSL_STD430_VEC4_ARR_ALIGN
+#define GLSL_STD430_MAT2X4_ARR_ALIGN			GLSL_STD430_MAT2X4_ALIGN
+#define GLSL_STD430_MAT3X2_ALIGN           	GLSL_STD430_VEC2_ARR_ALIGN
+#define GLSL_STD430_MAT3X2_ARR_ALIGN			GLSL_STD430_MAT3X2_ALIGN
+#define GLSL_STD430_MAT3X4_ALIGN           	GLSL_STD430_VEC4_ARR_ALIGN
+#define GLSL_STD430_MAT3X4_ARR_ALIGN			GLSL_STD430_MAT3X4_ALIGN
+#define GLSL_STD430_MAT4X2_ALIGN           	GLSL_STD430_VEC2_ARR_ALIGN
+#define GLSL_STD430_MAT4X2_ARR_ALIGN			GLSL_STD430_MAT4X2_ALIGN
+#define GLSL_STD430_MAT4X3_ALIGN           	GLSL_STD430_VEC3_ARR_ALIGN
+#define GLSL_STD430_MAT4X3_ARR_ALIGN			GLSL_STD430_MAT4X3_ALIGN
+/* explicit arithmetic types */
+#define GLSL_STD430_INT8_ALIGN				GLSL_SCALAR_INT8_ALIGN
+#define GLSL_STD430_INT8_ARR_ALIGN			GLSL_STD430_INT8_ALIGN
+#define GLSL_STD430_UINT8_ALIGN				GLSL_SCALAR_UINT8_ALIGN
+#define GLSL_STD430_UINT8_ARR_ALIGN			GLSL_STD430_UINT8_ALIGN
+#define GLSL_STD430_INT16_ALIGN				GLSL_SCALAR_INT16_ALIGN
+#define GLSL_STD430_INT16_ARR_ALIGN			GLSL_STD430_INT16_ALIGN
+#define GLSL_STD430_UINT16_ALIGN			GLSL_SCALAR_UINT16_ALIGN
+#define GLSL_STD430_UINT16_ARR_ALIGN		GLSL_STD430_UINT16_ALIGN
+#define GLSL_STD430_FLOAT16_ALIGN			GLSL_SCALAR_FLOAT16_ALIGN
+#define GLSL_STD430_FLOAT16_ARR_ALIGN		GLSL_STD430_FLOAT16_ALIGN
+#define GLSL_STD430_INT64_ALIGN				GLSL_SCALAR_INT64_ALIGN
+#define GLSL_STD430_INT64_ARR_ALIGN			GLSL_STD430_INT64_ALIGN
+#define GLSL_STD430_UINT64_ALIGN			GLSL_SCALAR_UINT64_ALIGN
+#define GLSL_STD430_UINT64_ARR_ALIGN		GLSL_STD430_UINT64_ALIGN
+#define GLSL_STD430_I8VEC2_ALIGN			(2 * GLSL_STD430_INT8_ALIGN)
+#define GLSL_STD430_I8VEC2_ARR_ALIGN		GLSL_STD430_I8VEC2_ALIGN
+#define GLSL_STD430_I8VEC3_ALIGN			(4 * GLSL_STD430_INT8_ALIGN) /* Base Alignment: a three component vector is aligned like a four component one */
+#define GLSL_STD430_I8VEC3_ARR_ALIGN		GLSL_STD430_I8VEC3_ALIGN
+#define GLSL_STD430_I8VEC4_ALIGN			(4 * GLSL_STD430_INT8_ALIGN)
+#define GLSL_STD430_I8VEC4_ARR_ALIGN		GLSL_STD430_I8VEC4_ALIGN
+#define GLSL_STD430_U8VEC2_ALIGN			(2 * GLSL_STD430_UINT8_ALIGN)
+#define GLSL_STD430_U8VEC2_ARR_ALIGN		GLSL_STD430_U8VEC2_ALIGN
+#define GLSL_STD430_U8VEC3_ALIGN			(4 * GLSL_STD430_UINT8_ALIGN)
+#define GLSL_STD430_U8VEC3_ARR_ALIGN		GLSL_STD430_U8VEC3_ALIGN
+#define GLSL_STD430_U8VEC4_ALIGN			(4 * GLSL_STD430_UINT8_ALIGN)
+#define GLSL_STD430_U8VEC4_ARR_ALIGN		GLSL_STD430_U8VEC4_ALIGN
+#define GLSL_STD430_I16VEC2_ALIGN			(2 * GLSL_STD430_INT16_ALIGN)
+#define GLSL_STD430_I16VEC2_ARR_ALIGN		GLSL_STD430_I16VEC2_ALIGN
+#define GLSL_STD430_I16VEC3_ALIGN			(4 * GLSL_STD430_INT16_ALIGN)
+#define GLSL_STD430_I16VEC3_ARR_ALIGN		GLSL_STD430_I16VEC3_ALIGN
+#define GLSL_STD430_I16VEC4_ALIGN			(4 * GLSL_STD430_INT16_ALIGN)
+#define GLSL_STD430_I16VEC4_ARR_ALIGN		GLSL_STD430_I16VEC4_ALIGN
+#define GLSL_STD430_U16VEC2_ALIGN			(2 * GLSL_STD430_UINT16_ALIGN)
+#define GLSL_STD430_U16VEC2_ARR_ALIGN		GLSL_STD430_U16VEC2_ALIGN
+#define GLSL_STD430_U16VEC3_ALIGN			(4 * GLSL_STD430_UINT16_ALIGN)
+#define GLSL_STD430_U16VEC3_ARR_ALIGN		GLSL_STD430_U16VEC3_ALIGN
+#define GLSL_STD430_U16VEC4_ALIGN			(4 * GLSL_STD430_UINT16_ALIGN)
+#define GLSL_STD430_U16VEC4_ARR_ALIGN		GLSL_STD430_U16VEC4_ALIGN
+#define GLSL_STD430_F16VEC2_ALIGN			(2 * GLSL_STD430_FLOAT16_ALIGN)
+#define GLSL_STD430_F16VEC2_ARR_ALIGN		GLSL_STD430_F16VEC2_ALIGN
+#define GLSL_STD430_F16VEC3_ALIGN			(4 * GLSL_STD430_FLOAT16_ALIGN)
+#define GLSL_STD430_F16VEC3_ARR_ALIGN		GLSL_STD430_F16VEC3_ALIGN
+#define GLSL_STD430_F16VEC4_ALIGN			(4 * GLSL_STD430_FLOAT16_ALIGN)
+#define GLSL_STD430_F16VEC4_ARR_ALIGN		GLSL_STD430_F16VEC4_ALIGN
 
 /* (std140) Extended Layout */
 #define GLSL_STD140_FLOAT_ALIGN 			GLSL_STD430_FLOAT_ALIGN
@@ -213,7 +604,7 @@ GLSLCOM_API u32 vkformatof_glsl_type(glsl_type_t type);
 #define GLSL_STD140_DVEC3_ARR_ALIGN 		U32_NEXT_MULTIPLE(GLSL_STD430_DVEC3_ARR_ALIGN, 16)
 #define GLSL_STD140_DVEC4_ALIGN 			GLSL_STD430_DVEC4_ALIGN
 #define GLSL_STD140_DVEC4_ARR_ALIGN 		U32_NEXT_MULTIPLE(GLSL_STD430_DVEC4_ARR_ALIGN, 16)
-#define GLSL_STD140_MAT2_ALIGN 				GLSL_STD430_MAT2_ALIGN
+#define GLSL_STD140_MAT2_ALIGN 				U32_NEXT_MULTIPLE(GLSL_STD430_MAT2_ALIGN, 16) /* Extended Alignment: MAT2 --> array of VEC2, rounded up to a multiple of 16 */
 #define GLSL_STD140_MAT2_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_MAT2_ALIGN, 16)
 #define GLSL_STD140_MAT3_ALIGN 				GLSL_STD430_MAT3_ALIGN
 #define GLSL_STD140_MAT3_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_MAT3_ALIGN, 16)
@@ -225,4 +616,61 @@ GLSLCOM_API u32 vkformatof_glsl_type(glsl_type_t type);
 #define GLSL_STD140_DMAT3_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_DMAT3_ALIGN, 16)
 #define GLSL_STD140_DMAT4_ALIGN 			GLSL_STD430_DMAT4_ALIGN
 #define GLSL_STD140_DMAT4_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_DMAT4_ALIGN, 16)
+#define GLSL_STD140_MAT2X3_ALIGN 			U32_NEXT_MULTIPLE(GLSL_STD430_MAT2X3_ALIGN, 16) /* Extended Alignment: array of columns, rounded up to a multiple of 16 */
+#define GLSL_STD140_MAT2X3_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_MAT2X3_ALIGN, 16)
+#define GLSL_STD140_MAT2X4_ALIGN 			U32_NEXT_MULTIPLE(GLSL_STD430_MAT2X4_ALIGN, 16)
+#define GLSL_STD140_MAT2X4_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_MAT2X4_ALIGN, 16)
+#define GLSL_STD140_MAT3X2_ALIGN 			U32_NEXT_MULTIPLE(GLSL_STD430_MAT3X2_ALIGN, 16)
+#define GLSL_STD140_MAT3X2_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_MAT3X2_ALIGN, 16)
+#define GLSL_STD140_MAT3X4_ALIGN 			U32_NEXT_MULTIPLE(GLSL_STD430_MAT3X4_ALIGN, 16)
+#define GLSL_STD140_MAT3X4_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_MAT3X4_ALIGN, 16)
+#define GLSL_STD140_MAT4X2_ALIGN 			U32_NEXT_MULTIPLE(GLSL_STD430_MAT4X2_ALIGN, 16)
+#define GLSL_STD140_MAT4X2_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_MAT4X2_ALIGN, 16)
+#define GLSL_STD140_MAT4X3_ALIGN 			U32_NEXT_MULTIPLE(GLSL_STD430_MAT4X3_ALIGN, 16)
+#define GLSL_STD140_MAT4X3_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_MAT4X3_ALIGN, 16)
+/* explicit arithmetic types */
+#define GLSL_STD140_INT8_ALIGN				GLSL_STD430_INT8_ALIGN
+#define GLSL_STD140_INT8_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_INT8_ARR_ALIGN, 16) /* Extended Alignment: an array of bytes still has a stride of 16 bytes */
+#define GLSL_STD140_UINT8_ALIGN				GLSL_STD430_UINT8_ALIGN
+#define GLSL_STD140_UINT8_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_UINT8_ARR_ALIGN, 16)
+#define GLSL_STD140_INT16_ALIGN				GLSL_STD430_INT16_ALIGN
+#define GLSL_STD140_INT16_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_INT16_ARR_ALIGN, 16)
+#define GLSL_STD140_UINT16_ALIGN			GLSL_STD430_UINT16_ALIGN
+#define GLSL_STD140_UINT16_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_UINT16_ARR_ALIGN, 16)
+#define GLSL_STD140_FLOAT16_ALIGN			GLSL_STD430_FLOAT16_ALIGN
+#define GLSL_STD140_FLOAT16_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_FLOAT16_ARR_ALIGN, 16)
+#define GLSL_STD140_INT64_ALIGN				GLSL_STD430_INT64_ALIGN
+#define GLSL_STD140_INT64_ARR_ALIGN			U32_NEXT_MULTIPLE(GLSL_STD430_INT64_ARR_ALIGN, 16)
+#define GLSL_STD140_UINT64_ALIGN			GLSL_STD430_UINT64_ALIGN
+#define GLSL_STD140_UINT64_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_UINT64_ARR_ALIGN, 16)
+#define GLSL_STD140_I8VEC2_ALIGN			GLSL_STD430_I8VEC2_ALIGN
+#define GLSL_STD140_I8VEC2_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_I8VEC2_ARR_ALIGN, 16)
+#define GLSL_STD140_I8VEC3_ALIGN			GLSL_STD430_I8VEC3_ALIGN
+#define GLSL_STD140_I8VEC3_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_I8VEC3_ARR_ALIGN, 16)
+#define GLSL_STD140_I8VEC4_ALIGN			GLSL_STD430_I8VEC4_ALIGN
+#define GLSL_STD140_I8VEC4_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_I8VEC4_ARR_ALIGN, 16)
+#define GLSL_STD140_U8VEC2_ALIGN			GLSL_STD430_U8VEC2_ALIGN
+#define GLSL_STD140_U8VEC2_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_U8VEC2_ARR_ALIGN, 16)
+#define GLSL_STD140_U8VEC3_ALIGN			GLSL_STD430_U8VEC3_ALIGN
+#define GLSL_STD140_U8VEC3_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_U8VEC3_ARR_ALIGN, 16)
+#define GLSL_STD140_U8VEC4_ALIGN			GLSL_STD430_U8VEC4_ALIGN
+#define GLSL_STD140_U8VEC4_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_U8VEC4_ARR_ALIGN, 16)
+#define GLSL_STD140_I16VEC2_ALIGN			GLSL_STD430_I16VEC2_ALIGN
+#define GLSL_STD140_I16VEC2_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_I16VEC2_ARR_ALIGN, 16)
+#define GLSL_STD140_I16VEC3_ALIGN			GLSL_STD430_I16VEC3_ALIGN
+#define GLSL_STD140_I16VEC3_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_I16VEC3_ARR_ALIGN, 16)
+#define GLSL_STD140_I16VEC4_ALIGN			GLSL_STD430_I16VEC4_ALIGN
+#define GLSL_STD140_I16VEC4_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_I16VEC4_ARR_ALIGN, 16)
+#define GLSL_STD140_U16VEC2_ALIGN			GLSL_STD430_U16VEC2_ALIGN
+#define GLSL_STD140_U16VEC2_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_U16VEC2_ARR_ALIGN, 16)
+#define GLSL_STD140_U16VEC3_ALIGN			GLSL_STD430_U16VEC3_ALIGN
+#define GLSL_STD140_U16VEC3_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_U16VEC3_ARR_ALIGN, 16)
+#define GLSL_STD140_U16VEC4_ALIGN			GLSL_STD430_U16VEC4_ALIGN
+#define GLSL_STD140_U16VEC4_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_U16VEC4_ARR_ALIGN, 16)
+#define GLSL_STD140_F16VEC2_ALIGN			GLSL_STD430_F16VEC2_ALIGN
+#define GLSL_STD140_F16VEC2_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_F16VEC2_ARR_ALIGN, 16)
+#define GLSL_STD140_F16VEC3_ALIGN			GLSL_STD430_F16VEC3_ALIGN
+#define GLSL_STD140_F16VEC3_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_F16VEC3_ARR_ALIGN, 16)
+#define GLSL_STD140_F16VEC4_ALIGN			GLSL_STD430_F16VEC4_ALIGN
+#define GLSL_STD140_F16VEC4_ARR_ALIGN		U32_NEXT_MULTIPLE(GLSL_STD430_F16VEC4_ARR_ALIGN, 16)
 
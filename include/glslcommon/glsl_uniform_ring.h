@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+
+/* Per-frame suballocator for dynamic uniform (and storage) buffer offsets on a persistently mapped buffer owned by the caller.
+ * The buffer is a ring of chunks: each thread bumps through a chunk of its own (glsl_uniform_ring_chunk_t) without synchronization
+ * and only takes a new chunk from the ring, with one compare and swap, when it runs out.
+ * The ring is divided into the memory of the frames in flight, a frame's memory is reclaimed as a whole once the caller
+ * has waited for the fence of that frame and begins a new frame in its slot. */
+
+typedef struct glsl_uniform_ring_t glsl_uniform_ring_t;
+
+/* per-thread bump allocator, owned by one thread */
+typedef struct glsl_uniform_ring_chunk_t
+{
+	glsl_uniform_ring_t* ring;
+	u8* mapped_data;
+	/* free range [cursor, end) of the chunk, in bytes from the start of the buffer */
+	u32 cursor;
+	u32 end;
+	/* frame in which the chunk was reset, checked in debug builds */
+	u64 frame;
+} glsl_uniform_ring_chunk_t;
+
+/* size and alignment of a block allocation, the alignment satisfies both the block layout and the device's minimum offset alignment */
+typedef struct glsl_uniform_block_alloc_t
+{
+	u32 size;
+	u32 align;
+} glsl_uniform_block_alloc_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* creates a ring over 'size' bytes of 'mapped_data' (the persistently mapped memory of a buffer),
+ * min_offset_alignment: minUniformBufferOffsetAlignment (or the larger of it and minStorageBufferOffsetAlignment when the buffer serves both)
+ * chunk_size: bytes a thread takes from the ring at once, a power of two of at least min_offset_alignment (e.g. 64 KiB),
+ *             the ring uses the largest multiple of chunk_size which fits in 'size'
+ * frame_count: number of frames in flight, i.e. of frame slots passed to glsl_uniform_ring_begin_frame() */
+GLSLCOM_API glsl_uniform_ring_t* glsl_uniform_ring_create(void* mapped_data, u32 size, u32 min_offset_alignment, u32 chunk_size, u32 frame_count);
+GLSLCOM_API void glsl_uniform_ring_destroy(glsl_uniform_ring_t* ring);
+/* starts a frame in 'frame_slot' (0 to frame_count - 1, usually round robin) and reclaims the memory of the frame which last used that slot;
+ * call it after waiting for the fence of that frame and while no thread allocates, then reset every chunk before allocating from it */
+GLSLCOM_API void glsl_uniform_ring_begin_frame(glsl_uniform_ring_t* ring, u32 frame_slot);
+/* returns the number of bytes allocated to the frames in flight (including the unused ends of chunks) */
+GLSLCOM_API u32 glsl_uniform_ring_get_used_size(const glsl_uniform_ring_t* ring);
+/* returns the size and alignment to allocate an instance of a block ('struct_layout' from layoutof_glsl_type_struct()), or an array of 'count' instances */
+GLSLCOM_API glsl_uniform_block_alloc_t glsl_uniform_ring_get_block_alloc(const glsl_uniform_ring_t* ring, glsl_struct_layout_t struct_layout, u32 count);
+
+/* binds a chunk to 'ring' for the current frame, the next allocation takes a new chunk from the ring */
+GLSLCOM_API void glsl_uniform_ring_chunk_reset(glsl_uniform_ring_chunk_t* chunk, glsl_uniform_ring_t* ring);
+/* slow path of glsl_uniform_ring_alloc(), takes a new chunk (or a dedicated run of chunks for allocations larger than a chunk) */
+GLSLCOM_API void* glsl_uniform_ring_alloc_slow(glsl_uniform_ring_chunk_t* chunk, u32 size, u32 align, u32* out_offset);
+#ifdef GLSLCOM_DEBUG
+/* fails if 'chunk' wasn't reset in the current frame */
+GLSLCOM_API void glsl_uniform_ring_check_chunk(const glsl_uniform_ring_chunk_t* chunk);
+#endif /* GLSLCOM_DEBUG */
+
+/* allocates 'size' bytes aligned to 'align' (a power of two) for the current frame,
+ * returns the mapped memory to write to and its offset in the buffer (the dynamic offset to bind), or NULL if the frames in flight use the whole ring */
+static inline void* glsl_uniform_ring_alloc(glsl_uniform_ring_chunk_t* chunk, u32 size, u32 align, u32* out_offset)
+{
+#ifdef GLSLCOM_DEBUG
+	glsl_uniform_ring_check_chunk(chunk);
+#endif /* GLSLCOM_DEBUG */
+	u64 offset = ((u64)chunk->cursor + align - 1) & ~(u64)(align - 1);
+	if((offset + size) > chunk->end)
+		return glsl_uniform_ring_alloc_slow(chunk, size, align, out_offset);
+	chunk->cursor = (u32)offset + size;
+	*out_offset = (u32)offset;
+	return chunk->mapped_data + offset;
+}
+
+static inline void* glsl_uniform_ring_alloc_block(glsl_uniform_ring_chunk_t* chunk, glsl_uniform_block_alloc_t block_alloc, u32* out_offset)
+{
+	return glsl_uniform_ring_alloc(chunk, block_alloc.size, block_alloc.align, out_offset);
+}
+
+END_CPP_COMPATIBLE
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_allocator.h>
+
+/* location of a glsl_vertex_input_t which is assigned the next free location(s) */
+#define GLSL_VERTEX_LOCATION_AUTO (~0u)
+
+/* how the vertex inputs are distributed over vertex buffer bindings (streams) */
+typedef enum glsl_vertex_stream_mode_t
+{
+	/* every input in binding 0 */
+	GLSL_VERTEX_STREAMS_INTERLEAVED,
+	/* every input in its own binding, the i-th input in binding i */
+	GLSL_VERTEX_STREAMS_SPLIT,
+	/* every input in the binding it specifies, e.g. positions alone (for depth passes) and the other inputs interleaved */
+	GLSL_VERTEX_STREAMS_MIXED
+} glsl_vertex_stream_mode_t;
+
+/* same values as VkVertexInputRate */
+typedef enum glsl_vertex_input_rate_t
+{
+	GLSL_VERTEX_INPUT_RATE_VERTEX = 0,
+	GLSL_VERTEX_INPUT_RATE_INSTANCE = 1
+} glsl_vertex_input_rate_t;
+
+/* an input variable of a vertex shader, e.g. 'layout(location = 3) in mat4 model' */
+typedef struct glsl_vertex_input_t
+{
+	glsl_type_t type;
+	/* first location, or GLSL_VERTEX_LOCATION_AUTO */
+	u32 location;
+	/* only used with GLSL_VERTEX_STREAMS_MIXED */
+	u32 binding;
+	/* all inputs of a binding must have the same rate */
+	glsl_vertex_input_rate_t input_rate;
+	/* storage of the components in the vertex buffer, e.g. GLSL_COMPONENT_ENCODING_SNORM16 for a vec3 normal, only float inputs can be encoded */
+	glsl_component_encoding_t encoding;
+} glsl_vertex_input_t;
+
+/* same layout as VkVertexInputAttributeDescription */
+typedef struct glsl_vertex_attribute_desc_t
+{
+	u32 location;
+	u32 binding;
+	/* VkFormat */
+	u32 format;
+	u32 offset;
+} glsl_vertex_attribute_desc_t;
+
+/* same layout as VkVertexInputBindingDescription */
+typedef struct glsl_vertex_binding_desc_t
+{
+	u32 binding;
+	u32 stride;
+	/* VkVertexInputRate */
+	u32 input_rate;
+} glsl_vertex_binding_desc_t;
+
+/* attribute and binding descriptions for a list of vertex inputs, allocated as a single memory block */
+typedef struct glsl_vertex_layout_t
+{
+	/* one attribute per location consuming column, so a mat4 input emits 4 attributes */
+	u32 attribute_count;
+	const glsl_vertex_attribute_desc_t* attributes;
+	/* bindings used by the inputs, sorted by binding number */
+	u32 binding_count;
+	const glsl_vertex_binding_desc_t* bindings;
+	/* first location, binding and offset (of the first column) of each input, indexed like the inputs */
+	const u32* input_locations;
+	const u32* input_bindings;
+	const u32* input_offsets;
+} glsl_vertex_layout_t;
+
+BEGIN_CPP_COMPATIBLE
+
+/* assigns locations and offsets to 'inputs' and emits their attribute and binding descriptions;
+ * within a binding the inputs are packed in the given order, each aligned to the size of its stored components (1 to 8 bytes),
+ * and matrices expand to one attribute per column; returns NULL if locations overlap, bindings mix input rates or a type can't be a vertex input (with its encoding);
+ * allocator: [optional] see glsl_allocator.h */
+GLSLCOM_API glsl_vertex_layout_t* glsl_vertex_layout_create(const glsl_vertex_input_t* inputs, u32 input_count, glsl_vertex_stream_mode_t stream_mode, const glsl_allocator_t* allocator);
+GLSLCOM_API void glsl_vertex_layout_destroy(glsl_vertex_layout_t* layout);
+
+END_CPP_COMPATIBLE
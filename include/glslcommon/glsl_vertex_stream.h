@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glslcommon/defines.h>
+#include <glslcommon/glsl_types.h>
+
+/* one attribute stream, as an array of 'vertex_count' tightly packed elements of sizeof_glsl_type_encoded(type, encoding) bytes,
+ * which is read by glsl_vertex_interleave() and written by glsl_vertex_deinterleave() */
+typedef struct glsl_vertex_stream_t
+{
+	glsl_type_t type;
+	/* offset (in bytes) of the attribute in an interleaved vertex, e.g. glsl_vertex_layout_t::input_offsets */
+	u32 offset;
+	void* data;
+	/* storage of the components, the stream is copied as is, see glsl_quantize() for encoding float streams */
+	glsl_component_encoding_t encoding;
+} glsl_vertex_stream_t;
+
+/* runs 'job(job_data, i)' for every i in [0, job_count), possibly concurrently on worker threads, and returns once all of them have finished */
+typedef void (*glsl_job_fn_t)(void* job_data, u32 job_index);
+typedef void (*glsl_job_dispatch_fn_t)(void* user_data, glsl_job_fn_t job, void* job_data, u32 job_count);
+
+/* hooks the (de)interleaving into the caller's job system */
+typedef struct glsl_job_dispatcher_t
+{
+	glsl_job_dispatch_fn_t dispatch;
+	void* user_data;
+	/* maximum number of jobs to split the work into, usually the number of worker threads */
+	u32 max_job_count;
+} glsl_job_dispatcher_t;
+
+/* meshes with fewer vertices than this per job are not split any further, smaller jobs cost more to dispatch than they save */
+#define GLSL_VERTEX_STREAM_MIN_JOB_VERTEX_COUNT 16384
+
+BEGIN_CPP_COMPATIBLE
+
+/* interleaves 'stream_count' streams into 'vertex_count' vertices of 'dst_stride' bytes, bytes of 'dst' not covered by any stream are left untouched;
+ * vec3 + vec3 + vec2 (position, normal, uv) into 32 byte vertices has an SSE2 kernel, every other combination is copied in cache sized blocks;
+ * 'dispatcher' is optional, without it (or for small meshes) everything runs on the calling thread */
+GLSLCOM_API void glsl_vertex_interleave(void* dst, u32 dst_stride, const glsl_vertex_stream_t* streams, u32 stream_count, u32 vertex_count, const glsl_job_dispatcher_t* dispatcher);
+/* reverse of glsl_vertex_interleave(), splits 'vertex_count' vertices of 'src_stride' bytes into 'stream_count' streams */
+GLSLCOM_API void glsl_vertex_deinterleave(const void* src, u32 src_stride, const glsl_vertex_stream_t* streams, u32 stream_count, u32 vertex_count, const glsl_job_dispatcher_t* dispatcher);
+
+END_CPP_COMPATIBLE
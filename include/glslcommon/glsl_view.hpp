@@ -0,0 +1,278 @@
+#pragma once
+
+#include <glslcommon/glsl_layout.hpp>
+#include <glslcommon/glsl_layout_tree.h>
+#include <glslcommon/glsl_storage_array.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <array> /* std::array */
+#include <cstddef> /* std::size_t, std::ptrdiff_t */
+#include <iterator> /* std::random_access_iterator_tag */
+#include <type_traits> /* std::conditional_t, std::is_const_v, std::is_empty_v, std::remove_const_t */
+
+/* Typed views reading and writing mapped GPU memory in place, with the strides of a glsl layout
+
+	glsl::array_view<glsl::vec3, glsl::std140> positions(mapped, 64);	// 16 byte stride, known at compile time
+	for(auto& position : positions)
+		position = { 0.0f, 1.0f, 0.0f };
+
+	glsl::block_view lights(mapped, tree);								// tree from glsl_layout_tree_create()
+	lights.get<float>("lights[3].intensity") = 2.0f;
+	for(auto& color : lights.array<glsl::vec4>("colors"))				// stride taken from the tree
+		color[3] = 1.0f;
+
+ * Debug builds (GLSLCOM_DEBUG) check every index and every dereference of an iterator against the bounds of the view,
+ * and check that the C++ element type matches the glsl type found in the tree; otherwise element access is a multiply-add
+ * and iterators are a pointer advanced by the stride. Matrices aren't contiguous in most layouts, view them as arrays of their columns. */
+namespace glsl
+{
+	/* C++ type an element of a glsl type is read and written as: C++ types as they are, vectors as std::array of their components
+	 * (float16_t components are their u16 bit patterns) */
+	template<typename T> struct value_of { using type = T; };
+	template<> struct value_of<vec2> { using type = std::array<f32, 2>; };
+	template<> struct value_of<vec3> { using type = std::array<f32, 3>; };
+	template<> struct value_of<vec4> { using type = std::array<f32, 4>; };
+	template<> struct value_of<ivec2> { using type = std::array<s32, 2>; };
+	template<> struct value_of<ivec3> { using type = std::array<s32, 3>; };
+	template<> struct value_of<ivec4> { using type = std::array<s32, 4>; };
+	template<> struct value_of<uvec2> { using type = std::array<u32, 2>; };
+	template<> struct value_of<uvec3> { using type = std::array<u32, 3>; };
+	template<> struct value_of<uvec4> { using type = std::array<u32, 4>; };
+	template<> struct value_of<dvec2> { using type = std::array<f64, 2>; };
+	template<> struct value_of<dvec3> { using type = std::array<f64, 3>; };
+	template<> struct value_of<dvec4> { using type = std::array<f64, 4>; };
+	template<> struct value_of<float16_t> { using type = u16; };
+	template<> struct value_of<f16vec2> { using type = std::array<u16, 2>; };
+	template<> struct value_of<f16vec3> { using type = std::array<u16, 3>; };
+	template<> struct value_of<f16vec4> { using type = std::array<u16, 4>; };
+	template<> struct value_of<i16vec2> { using type = std::array<s16, 2>; };
+	template<> struct value_of<i16vec3> { using type = std::array<s16, 3>; };
+	template<> struct value_of<i16vec4> { using type = std::array<s16, 4>; };
+	template<> struct value_of<u16vec2> { using type = std::array<u16, 2>; };
+	template<> struct value_of<u16vec3> { using type = std::array<u16, 3>; };
+	template<> struct value_of<u16vec4> { using type = std::array<u16, 4>; };
+	template<> struct value_of<i8vec2> { using type = std::array<s8, 2>; };
+	template<> struct value_of<i8vec3> { using type = std::array<s8, 3>; };
+	template<> struct value_of<i8vec4> { using type = std::array<s8, 4>; };
+	template<> struct value_of<u8vec2> { using type = std::array<u8, 2>; };
+	template<> struct value_of<u8vec3> { using type = std::array<u8, 3>; };
+	template<> struct value_of<u8vec4> { using type = std::array<u8, 4>; };
+
+	namespace detail
+	{
+		/* 'T' may be const qualified for read only views */
+		template<typename T>
+		using element_t = std::conditional_t<std::is_const_v<T>, const typename value_of<std::remove_const_t<T>>::type, typename value_of<std::remove_const_t<T>>::type>;
+		template<typename T>
+		using byte_t = std::conditional_t<std::is_const_v<T>, const u8, u8>;
+
+		/* glsl type of 'T', GLSL_TYPE_UNDEFINED for C++ structs */
+		template<typename T>
+		constexpr glsl_type_t type_of_or_undefined()
+		{
+			if constexpr(requires { type_of<std::remove_const_t<T>>::value; })
+				return type_of<std::remove_const_t<T>>::value;
+			else
+				return GLSL_TYPE_UNDEFINED;
+		}
+
+		/* a stride known at compile time takes no space, 0 means it is only known at runtime */
+		template<u32 Stride>
+		struct stride_holder
+		{
+			constexpr stride_holder(u32) { }
+			static constexpr u32 get() { return Stride; }
+		};
+		template<>
+		struct stride_holder<0>
+		{
+			u32 stride;
+			constexpr stride_holder(u32 stride) : stride(stride) { }
+			constexpr u32 get() const { return stride; }
+		};
+	}
+
+	/* random access iterator over elements 'Stride' bytes apart (0: stride given at runtime) */
+	template<typename T, u32 Stride = 0>
+	class strided_iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_const_t<detail::element_t<T>>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = detail::element_t<T>*;
+		using reference = detail::element_t<T>&;
+
+		strided_iterator() : m_data(nullptr), m_stride(Stride) { }
+#ifdef GLSLCOM_DEBUG
+		strided_iterator(detail::byte_t<T>* data, u32 stride, detail::byte_t<T>* begin, detail::byte_t<T>* end) : m_data(data), m_stride(stride), m_begin(begin), m_end(end) { }
+#else
+		strided_iterator(detail::byte_t<T>* data, u32 stride, detail::byte_t<T>*, detail::byte_t<T>*) : m_data(data), m_stride(stride) { }
+#endif /* GLSLCOM_DEBUG */
+
+		reference operator*() const
+		{
+#ifdef GLSLCOM_DEBUG
+			_ASSERT((m_data >= m_begin) && (m_data < m_end));
+#endif /* GLSLCOM_DEBUG */
+			return *reinterpret_cast<pointer>(m_data);
+		}
+		pointer operator->() const { return &**this; }
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		strided_iterator& operator++() { m_data += m_stride.get(); return *this; }
+		strided_iterator operator++(int) { strided_iterator it = *this; ++*this; return it; }
+		strided_iterator& operator--() { m_data -= m_stride.get(); return *this; }
+		strided_iterator operator--(int) { strided_iterator it = *this; --*this; return it; }
+		strided_iterator& operator+=(difference_type n) { m_data += n * static_cast<difference_type>(m_stride.get()); return *this; }
+		strided_iterator& operator-=(difference_type n) { m_data -= n * static_cast<difference_type>(m_stride.get()); return *this; }
+		friend strided_iterator operator+(strided_iterator it, difference_type n) { return it += n; }
+		friend strided_iterator operator+(difference_type n, strided_iterator it) { return it += n; }
+		friend strided_iterator operator-(strided_iterator it, difference_type n) { return it -= n; }
+		friend difference_type operator-(const strided_iterator& a, const strided_iterator& b) { return (a.m_data - b.m_data) / static_cast<difference_type>(a.m_stride.get()); }
+
+		friend bool operator==(const strided_iterator& a, const strided_iterator& b) { return a.m_data == b.m_data; }
+		friend auto operator<=>(const strided_iterator& a, const strided_iterator& b) { return a.m_data <=> b.m_data; }
+
+	private:
+		detail::byte_t<T>* m_data;
+		[[no_unique_address]] detail::stride_holder<Stride> m_stride;
+#ifdef GLSLCOM_DEBUG
+		detail::byte_t<T>* m_begin = nullptr;
+		detail::byte_t<T>* m_end = nullptr;
+#endif /* GLSLCOM_DEBUG */
+	};
+
+	/* view of 'size' elements 'Stride' bytes apart starting at 'data' (0: stride given at runtime) */
+	template<typename T, u32 Stride = 0>
+	class strided_view
+	{
+	public:
+		using iterator = strided_iterator<T, Stride>;
+		using reference = detail::element_t<T>&;
+
+		strided_view() : m_data(nullptr), m_stride(Stride), m_size(0) { }
+		strided_view(void* data, u32 stride, std::size_t size) : m_data(static_cast<detail::byte_t<T>*>(data)), m_stride(stride), m_size(size)
+		{
+			_ASSERT((Stride == 0) || (stride == Stride));
+			_ASSERT(m_stride.get() >= sizeof(detail::element_t<T>));
+		}
+		strided_view(const void* data, u32 stride, std::size_t size) requires std::is_const_v<T> : m_data(static_cast<detail::byte_t<T>*>(data)), m_stride(stride), m_size(size)
+		{
+			_ASSERT((Stride == 0) || (stride == Stride));
+			_ASSERT(m_stride.get() >= sizeof(detail::element_t<T>));
+		}
+
+		reference operator[](std::size_t index) const
+		{
+#ifdef GLSLCOM_DEBUG
+			_ASSERT(index < m_size);
+#endif /* GLSLCOM_DEBUG */
+			return *reinterpret_cast<detail::element_t<T>*>(m_data + index * m_stride.get());
+		}
+		iterator begin() const { return iterator(m_data, m_stride.get(), m_data, end_data()); }
+		iterator end() const { return iterator(end_data(), m_stride.get(), m_data, end_data()); }
+		std::size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		u32 stride() const { return m_stride.get(); }
+		detail::byte_t<T>* data() const { return m_data; }
+
+	private:
+		detail::byte_t<T>* end_data() const { return m_data + m_size * m_stride.get(); }
+
+		detail::byte_t<T>* m_data;
+		[[no_unique_address]] detail::stride_holder<Stride> m_stride;
+		std::size_t m_size;
+	};
+
+	/* view of an array of glsl type 'T' (a type tag or a C++ scalar) laid out under 'Layout', its stride is known at compile time:
+	 * glsl::array_view<glsl::vec3, glsl::std140> steps by 16 bytes and reads and writes std::array<f32, 3> */
+	template<typename T, typename Layout>
+	class array_view : public strided_view<T, sizeof_type(type_of<std::remove_const_t<T>>::value, Layout::value, true)>
+	{
+		static constexpr glsl_type_t type = type_of<std::remove_const_t<T>>::value;
+		static_assert(!std::is_empty_v<detail::element_t<T>>, "matrices aren't contiguous, view them as arrays of their columns");
+		using base = strided_view<T, sizeof_type(type, Layout::value, true)>;
+	public:
+		static constexpr u32 stride = sizeof_type(type, Layout::value, true);
+
+		array_view() = default;
+		array_view(void* data, std::size_t size) : base(data, stride, size) { }
+		array_view(const void* data, std::size_t size) requires std::is_const_v<T> : base(data, stride, size) { }
+	};
+
+	/* view of the runtime sized array of a storage buffer whose 'buffer_size' bytes are mapped at 'mapped_data' (see glsl_storage_array.h),
+	 * covering every element which fits in the buffer */
+	template<typename T>
+	strided_view<T> storage_array_view(void* mapped_data, const glsl_storage_array_layout_t& layout, u64 buffer_size)
+	{
+		return strided_view<T>(static_cast<u8*>(mapped_data) + layout.header_size, layout.element_stride, static_cast<std::size_t>(glsl_storage_array_get_capacity(&layout, buffer_size)));
+	}
+
+	/* view of a block instance laid out as 'tree' (from glsl_layout_tree_create()), members are found by path as in glsl_layout_tree_resolve() */
+	class block_view
+	{
+	public:
+		block_view(void* data, const glsl_layout_tree_t* tree) : m_data(static_cast<u8*>(data)), m_tree(tree) { }
+
+		/* returns the member (or array element) at 'path', e.g. "lights[3].intensity", nullptr if there is no such member */
+		template<typename T>
+		detail::element_t<T>* find(const char* path) const
+		{
+			glsl_layout_location_t location;
+			if(!glsl_layout_tree_resolve(m_tree, path, &location))
+				return nullptr;
+#ifdef GLSLCOM_DEBUG
+			check_type<T>(location.node, location.indexed_dimension_count);
+#endif /* GLSLCOM_DEBUG */
+			return reinterpret_cast<detail::element_t<T>*>(m_data + location.offset);
+		}
+		/* same as find() for paths which must exist */
+		template<typename T>
+		detail::element_t<T>& get(const char* path) const
+		{
+			detail::element_t<T>* member = find<T>(path);
+			_ASSERT(member != nullptr);
+			return *member;
+		}
+		/* returns a view of the array at 'path' ("lights", or "cascades[2].splits" for one dimension of an array of arrays), an empty view if there is no such array;
+		 * the view covers the first dimension left unindexed by the path, and its elements are the elements of the next dimensions (if any) */
+		template<typename T>
+		strided_view<T> array(const char* path) const
+		{
+			glsl_layout_location_t location;
+			if(!glsl_layout_tree_resolve(m_tree, path, &location) || (location.indexed_dimension_count == location.node->array_dimension_count))
+				return strided_view<T>();
+			u32 dimension = location.indexed_dimension_count;
+#ifdef GLSLCOM_DEBUG
+			if((dimension + 1) == location.node->array_dimension_count)
+				check_type<T>(location.node, dimension + 1);
+			else if(sizeof(detail::element_t<T>) > location.node->array_strides[dimension])
+				debug_log_fetal_error("[GLSLCommon] Member %s is viewed as an element larger than its %u bytes stride", location.node->name, location.node->array_strides[dimension]);
+#endif /* GLSLCOM_DEBUG */
+			return strided_view<T>(m_data + location.offset, location.node->array_strides[dimension], location.node->array_lengths[dimension]);
+		}
+		u8* data() const { return m_data; }
+		const glsl_layout_tree_t* tree() const { return m_tree; }
+
+	private:
+#ifdef GLSLCOM_DEBUG
+		/* the element of 'node' after indexing 'indexed_dimension_count' dimensions must be a single value of the glsl type of 'T' */
+		template<typename T>
+		static void check_type(const glsl_layout_node_t* node, u32 indexed_dimension_count)
+		{
+			constexpr glsl_type_t type = detail::type_of_or_undefined<T>();
+			if(indexed_dimension_count != node->array_dimension_count)
+				debug_log_fetal_error("[GLSLCommon] Member %s is an array, view it with block_view::array()", node->name);
+			else if((type != GLSL_TYPE_UNDEFINED) && (type != node->type))
+				debug_log_fetal_error("[GLSLCommon] Member %s is viewed as a different glsl type", node->name);
+			else if((type == GLSL_TYPE_UNDEFINED) && (sizeof(detail::element_t<T>) > node->element_size))
+				debug_log_fetal_error("[GLSLCommon] Member %s is viewed as a type larger than its %u bytes", node->name, node->element_size);
+		}
+#endif /* GLSLCOM_DEBUG */
+
+		u8* m_data;
+		const glsl_layout_tree_t* m_tree;
+	};
+}
@@ -0,0 +1,164 @@
+#include <glslcommon/glsl_allocator.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdint.h> /* uintptr_t */
+#include <stdlib.h> /* malloc, free */
+
+/* stored in front of every object, its size keeps the object aligned like the memory it is allocated in */
+typedef struct object_header_t
+{
+	/* allocate is NULL for the heap */
+	glsl_allocator_t allocator;
+	u64 size;
+} object_header_t;
+
+#define OBJECT_HEADER_SIZE 32
+#define OBJECT_ALIGN 16
+
+_Static_assert(sizeof(object_header_t) <= OBJECT_HEADER_SIZE, "object_header_t must fit in OBJECT_HEADER_SIZE bytes");
+
+GLSLCOM_API void* glsl_allocator_alloc_object(const glsl_allocator_t* allocator, u64 size)
+{
+	u64 total_size = OBJECT_HEADER_SIZE + size;
+	u8* memory = (allocator == NULL) ? malloc(total_size) : allocator->allocate(allocator->user_data, total_size, OBJECT_ALIGN);
+	if(memory == NULL)
+		return NULL;
+	object_header_t* header = (object_header_t*)memory;
+	header->allocator = (allocator == NULL) ? (glsl_allocator_t) { 0 } : *allocator;
+	header->size = total_size;
+	return memory + OBJECT_HEADER_SIZE;
+}
+
+GLSLCOM_API void glsl_allocator_free_object(void* object)
+{
+	if(object == NULL)
+		return;
+	u8* memory = (u8*)object - OBJECT_HEADER_SIZE;
+	const object_header_t* header = (const object_header_t*)memory;
+	if(header->allocator.allocate == NULL)
+		free(memory);
+	else if(header->allocator.release != NULL)
+		header->allocator.release(header->allocator.user_data, memory, header->size);
+}
+
+/* arena */
+
+typedef struct arena_block_t
+{
+	struct arena_block_t* next;
+	u64 size;
+	u64 used;
+	/* keeps the data of the block aligned to 16 bytes */
+	u64 reserved;
+} arena_block_t;
+
+struct glsl_arena_t
+{
+	/* the block allocations are bumped from, older blocks follow it through 'next' */
+	arena_block_t* head;
+	u64 block_size;
+	u64 used_size;
+};
+
+static arena_block_t* arena_block_create(u64 size, arena_block_t* next)
+{
+	arena_block_t* block = malloc(sizeof(arena_block_t) + size);
+	if(block == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for a glsl_arena_t block");
+		return NULL;
+	}
+	block->next = next;
+	block->size = size;
+	block->used = 0;
+	return block;
+}
+
+/* addresses and block offsets are 64 bit, U32_NEXT_MULTIPLE() would truncate them */
+static inline u64 u64_round_next_multiple(u64 value, u64 multiple)
+{
+	return ((value + multiple - 1) / multiple) * multiple;
+}
+
+GLSLCOM_API glsl_arena_t* glsl_arena_create(u64 block_size)
+{
+	glsl_arena_t* arena = malloc(sizeof(glsl_arena_t));
+	if(arena == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_arena_t");
+		return NULL;
+	}
+	arena->block_size = (block_size < 256) ? 256 : block_size;
+	arena->used_size = 0;
+	arena->head = arena_block_create(arena->block_size, NULL);
+	if(arena->head == NULL)
+	{
+		free(arena);
+		return NULL;
+	}
+	return arena;
+}
+
+GLSLCOM_API void glsl_arena_destroy(glsl_arena_t* arena)
+{
+	arena_block_t* block = arena->head;
+	while(block != NULL)
+	{
+		arena_block_t* next = block->next;
+		free(block);
+		block = next;
+	}
+	free(arena);
+}
+
+GLSLCOM_API void glsl_arena_reset(glsl_arena_t* arena)
+{
+	/* the first block is the last one of the chain */
+	arena_block_t* block = arena->head;
+	while(block->next != NULL)
+	{
+		arena_block_t* next = block->next;
+		free(block);
+		block = next;
+	}
+	block->used = 0;
+	arena->head = block;
+	arena->used_size = 0;
+}
+
+GLSLCOM_API void* glsl_arena_alloc(glsl_arena_t* arena, u64 size, u32 align)
+{
+	_ASSERT((align != 0) && ((align & (align - 1)) == 0));
+	arena_block_t* block = arena->head;
+	u8* data = (u8*)(block + 1);
+	u64 offset = u64_round_next_multiple((u64)(uintptr_t)data + block->used, align) - (u64)(uintptr_t)data;
+	if((offset + size) > block->size)
+	{
+		/* the rest of the current block is left unused */
+		block = arena_block_create(((size + align) > arena->block_size) ? (size + align) : arena->block_size, block);
+		if(block == NULL)
+			return NULL;
+		arena->head = block;
+		data = (u8*)(block + 1);
+		offset = u64_round_next_multiple((u64)(uintptr_t)data, align) - (u64)(uintptr_t)data;
+	}
+	block->used = offset + size;
+	arena->used_size += size;
+	return data + offset;
+}
+
+GLSLCOM_API u64 glsl_arena_get_used_size(const glsl_arena_t* arena)
+{
+	return arena->used_size;
+}
+
+static void* arena_allocate(void* user_data, u64 size, u32 align)
+{
+	return glsl_arena_alloc(user_data, size, align);
+}
+
+GLSLCOM_API glsl_allocator_t glsl_arena_get_allocator(glsl_arena_t* arena)
+{
+	return (glsl_allocator_t) { arena_allocate, NULL, arena };
+}
@@ -0,0 +1,194 @@
+#include <glslcommon/glsl_copy_plan.h>
+#include <glslcommon/glsl_pack.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <string.h> /* memcpy */
+
+/* a member is copied as rows: array elements, or columns of matrices (MAT3 --> array of VEC3), rows of row_major matrices */
+static glsl_copy_op_t get_member_op(glsl_type_layout_traits_t type_traits, const glsl_member_layout_t* member, const glsl_copy_source_member_t* src_member)
+{
+	u32 element_count = type_traits.is_array ? ((type_traits.array_length == 0) ? 1 : type_traits.array_length) : 1;
+	u32 element_size = (type_traits.type == GLSL_TYPE_UNDEFINED) ? type_traits.size : sizeof_glsl_type(type_traits.type, GLSL_MEMORY_LAYOUT_SCALAR);
+	u32 element_stride = type_traits.is_array ? member->array_stride : member->size;
+	u32 column_count = columnsof_glsl_type(layout_typeof_glsl_type(type_traits.type, type_traits.is_row_major));
+
+	glsl_copy_op_t op;
+	op.dst_offset = member->offset;
+	op.src_offset = src_member->offset;
+	op.row_size = element_size / column_count;
+	op.row_count = element_count * column_count;
+	op.dst_stride = element_stride / column_count;
+	op.src_stride = (src_member->row_stride == 0) ? op.row_size : src_member->row_stride;
+	_ASSERT(op.src_stride >= op.row_size);
+
+	/* rows which are contiguous in both the source and the destination are just one bigger row */
+	if((op.row_count > 1) && (op.dst_stride == op.row_size) && (op.src_stride == op.row_size))
+	{
+		op.row_size *= op.row_count;
+		op.row_count = 1;
+	}
+	if(op.row_count == 1)
+	{
+		op.dst_stride = op.row_size;
+		op.src_stride = op.row_size;
+	}
+	return op;
+}
+
+/* tries to merge 'next' into 'op', returns true on success */
+static bool try_merge_ops(glsl_copy_op_t* op, const glsl_copy_op_t* next)
+{
+	/* one contiguous run, possibly across an identical gap in both the source and the destination */
+	if((op->row_count == 1) && (next->row_count == 1))
+	{
+		u32 dst_end = op->dst_offset + op->row_size;
+		u32 src_end = op->src_offset + op->row_size;
+		if((next->dst_offset >= dst_end) && (next->src_offset >= src_end)
+			&& ((next->dst_offset - dst_end) == (next->src_offset - src_end))
+			&& ((next->dst_offset - dst_end) <= GLSL_COPY_PLAN_MAX_MERGE_GAP))
+		{
+			op->row_size = next->dst_offset + next->row_size - op->dst_offset;
+			op->dst_stride = op->row_size;
+			op->src_stride = op->row_size;
+			return true;
+		}
+	}
+
+	if(op->row_size != next->row_size)
+		return false;
+
+	/* two single rows start a strided run */
+	if((op->row_count == 1) && (next->row_count == 1))
+	{
+		if((next->dst_offset < (op->dst_offset + op->row_size)) || (next->src_offset < (op->src_offset + op->row_size)))
+			return false;
+		op->dst_stride = next->dst_offset - op->dst_offset;
+		op->src_stride = next->src_offset - op->src_offset;
+		op->row_count = 2;
+		return true;
+	}
+
+	/* a strided run continues with identically strided rows */
+	if((op->row_count > 1)
+		&& (next->dst_offset == (op->dst_offset + op->row_count * op->dst_stride))
+		&& (next->src_offset == (op->src_offset + op->row_count * op->src_stride))
+		&& ((next->row_count == 1) || ((next->dst_stride == op->dst_stride) && (next->src_stride == op->src_stride))))
+	{
+		op->row_count += next->row_count;
+		return true;
+	}
+	return false;
+}
+
+/* fills in the plan whose 'op_count' runs follow it in memory */
+static glsl_copy_plan_t* finish_plan(glsl_copy_plan_t* plan, u32 op_count)
+{
+	glsl_copy_op_t* ops = (glsl_copy_op_t*)(plan + 1);
+	u32 dst_size = 0;
+	for(u32 i = 0; i < op_count; i++)
+	{
+		u32 end = ops[i].dst_offset + (ops[i].row_count - 1) * ops[i].dst_stride + ops[i].row_size;
+		if(dst_size < end)
+			dst_size = end;
+	}
+	plan->op_count = op_count;
+	plan->dst_size = dst_size;
+	plan->ops = ops;
+	return plan;
+}
+
+GLSLCOM_API glsl_copy_plan_t* glsl_copy_plan_create(const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, const glsl_copy_source_member_t* src_members, u32 type_traits_count, const glsl_allocator_t* allocator)
+{
+	_ASSERT(type_traits_count > 0);
+
+	/* there can't be more runs than members */
+	glsl_copy_plan_t* plan = glsl_allocator_alloc_object(allocator, sizeof(glsl_copy_plan_t) + sizeof(glsl_copy_op_t) * type_traits_count);
+	if(plan == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_copy_plan_t");
+		return NULL;
+	}
+	glsl_copy_op_t* ops = (glsl_copy_op_t*)(plan + 1);
+	u32 op_count = 0;
+	for(u32 i = 0; i < type_traits_count; i++)
+	{
+		AUTO op = get_member_op(type_traits[i], &members[i], &src_members[i]);
+		if((op_count > 0) && try_merge_ops(&ops[op_count - 1], &op))
+			continue;
+		ops[op_count++] = op;
+	}
+	return finish_plan(plan, op_count);
+}
+
+GLSLCOM_API glsl_copy_plan_t* glsl_copy_plan_create_from_ops(const glsl_copy_op_t* ops, u32 op_count, const glsl_allocator_t* allocator)
+{
+	glsl_copy_plan_t* plan = glsl_allocator_alloc_object(allocator, sizeof(glsl_copy_plan_t) + sizeof(glsl_copy_op_t) * op_count);
+	if(plan == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_copy_plan_t");
+		return NULL;
+	}
+	glsl_copy_op_t* plan_ops = (glsl_copy_op_t*)(plan + 1);
+	u32 plan_op_count = 0;
+	for(u32 i = 0; i < op_count; i++)
+	{
+		if((plan_op_count > 0) && try_merge_ops(&plan_ops[plan_op_count - 1], &ops[i]))
+			continue;
+		plan_ops[plan_op_count++] = ops[i];
+	}
+	return finish_plan(plan, plan_op_count);
+}
+
+GLSLCOM_API void glsl_copy_plan_destroy(glsl_copy_plan_t* plan)
+{
+	glsl_allocator_free_object(plan);
+}
+
+static void execute_ops(const glsl_copy_op_t* ops, u32 op_count, u8* dst, const u8* src)
+{
+	for(u32 i = 0; i < op_count; i++)
+	{
+		const glsl_copy_op_t* op = &ops[i];
+		if(op->row_count == 1)
+			memcpy(dst + op->dst_offset, src + op->src_offset, op->row_size);
+		/* tightly packed source (or destination) rows can take the vectorized pack (or unpack) kernels */
+		else if(op->src_stride == op->row_size)
+			glsl_pack_strided(dst + op->dst_offset, op->dst_stride, src + op->src_offset, op->row_size, op->row_count);
+		else if(op->dst_stride == op->row_size)
+			glsl_unpack_strided(dst + op->dst_offset, src + op->src_offset, op->src_stride, op->row_size, op->row_count);
+		else
+		{
+			u8* _dst = dst + op->dst_offset;
+			const u8* _src = src + op->src_offset;
+			for(u32 j = 0; j < op->row_count; j++)
+			{
+				memcpy(_dst, _src, op->row_size);
+				_dst += op->dst_stride;
+				_src += op->src_stride;
+			}
+		}
+	}
+}
+
+GLSLCOM_API void glsl_copy_plan_execute(const glsl_copy_plan_t* plan, void* dst, const void* src)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	execute_ops(plan->ops, plan->op_count, dst, src);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_COPY_PLAN_EXECUTE, plan->dst_size);
+}
+
+GLSLCOM_API void glsl_copy_plan_execute_array(const glsl_copy_plan_t* plan, void* dst, u32 dst_stride, const void* src, u32 src_stride, u32 count)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	u8* _dst = dst;
+	const u8* _src = src;
+	for(u32 i = 0; i < count; i++)
+	{
+		execute_ops(plan->ops, plan->op_count, _dst, _src);
+		_dst += dst_stride;
+		_src += src_stride;
+	}
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_COPY_PLAN_EXECUTE, (u64)plan->dst_size * count);
+}
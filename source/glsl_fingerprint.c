@@ -0,0 +1,77 @@
+#include <glslcommon/glsl_fingerprint.h>
+
+/* 64-bit FNV-1a over the little endian bytes of 'value' */
+static inline u64 hash_u32(u64 hash, u32 value)
+{
+	for(u32 i = 0; i < 4; i++)
+	{
+		hash ^= (value >> (i * 8)) & 0xFFu;
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+static inline u64 hash_u64(u64 hash, u64 value)
+{
+	return hash_u32(hash_u32(hash, (u32)value), (u32)(value >> 32));
+}
+
+/* tags keep members, structs and opaque structs apart, so no sequence of hashed values can be read two ways */
+#define FINGERPRINT_TAG_MEMBER 0x4D454D42u /* "MEMB" */
+#define FINGERPRINT_TAG_STRUCT 0x53545255u /* "STRU" */
+#define FINGERPRINT_TAG_OPAQUE 0x4F504151u /* "OPAQ" */
+
+static inline u64 hash_begin(u32 tag)
+{
+	return hash_u32(hash_u32(0xCBF29CE484222325ULL, GLSL_FINGERPRINT_VERSION), tag);
+}
+
+GLSLCOM_API u64 glsl_fingerprint_member(glsl_type_t type, bool is_row_major, u64 struct_fingerprint, u32 size, u32 array_dimension_count, const u32* array_lengths, const u32* array_strides)
+{
+	u64 fingerprint = hash_u32(hash_begin(FINGERPRINT_TAG_MEMBER), (u32)type);
+	if(type == GLSL_TYPE_UNDEFINED)
+		fingerprint = hash_u64(fingerprint, struct_fingerprint);
+	/* row_major only means something for matrices */
+	else
+		fingerprint = hash_u32(fingerprint, (u32)(is_row_major && (columnsof_glsl_type(type) > 1)));
+	fingerprint = hash_u32(fingerprint, size);
+	fingerprint = hash_u32(fingerprint, array_dimension_count);
+	for(u32 i = 0; i < array_dimension_count; i++)
+	{
+		fingerprint = hash_u32(fingerprint, array_lengths[i]);
+		fingerprint = hash_u32(fingerprint, array_strides[i]);
+	}
+	return fingerprint;
+}
+
+GLSLCOM_API u64 glsl_fingerprint_struct_begin(glsl_memory_layout_t layout, u32 member_count)
+{
+	return hash_u32(hash_u32(hash_begin(FINGERPRINT_TAG_STRUCT), (u32)layout), member_count);
+}
+
+GLSLCOM_API u64 glsl_fingerprint_struct_add(u64 fingerprint, u32 offset, u64 member_fingerprint)
+{
+	return hash_u64(hash_u32(fingerprint, offset), member_fingerprint);
+}
+
+GLSLCOM_API u64 glsl_fingerprint_struct_end(u64 fingerprint, u32 align, u32 size)
+{
+	return hash_u32(hash_u32(fingerprint, align), size);
+}
+
+GLSLCOM_API u64 glsl_fingerprint_struct_layout(const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, u32 type_traits_count, glsl_struct_layout_t struct_layout, glsl_memory_layout_t layout)
+{
+	u64 fingerprint = glsl_fingerprint_struct_begin(layout, type_traits_count);
+	for(u32 i = 0; i < type_traits_count; i++)
+	{
+		const glsl_type_layout_traits_t* traits = &type_traits[i];
+		u64 struct_fingerprint = 0;
+		if(traits->type == GLSL_TYPE_UNDEFINED)
+			struct_fingerprint = hash_u32(hash_u32(hash_begin(FINGERPRINT_TAG_OPAQUE), traits->align), traits->size);
+		/* an array of length 0 is laid out with one element, like layoutof_glsl_type_struct() does */
+		u32 array_length = (traits->array_length == 0) ? 1 : traits->array_length;
+		u64 member_fingerprint = glsl_fingerprint_member(traits->type, traits->is_row_major, struct_fingerprint, members[i].size, traits->is_array ? 1 : 0, &array_length, &members[i].array_stride);
+		fingerprint = glsl_fingerprint_struct_add(fingerprint, members[i].offset, member_fingerprint);
+	}
+	return glsl_fingerprint_struct_end(fingerprint, struct_layout.align, struct_layout.size);
+}
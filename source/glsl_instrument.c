@@ -0,0 +1,186 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#endif
+
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <string.h> /* memset */
+
+#ifdef GLSLCOM_INSTRUMENTATION
+
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <time.h>
+#endif
+
+#ifdef _MSC_VER
+#	define GLSLCOM_THREAD_LOCAL __declspec(thread)
+#else
+#	define GLSLCOM_THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct api_counters_t
+{
+	atomic_ullong call_count;
+	atomic_ullong time_ns;
+	atomic_ullong bytes;
+} api_counters_t;
+
+static api_counters_t api_counters[GLSL_INSTRUMENT_API_MAX];
+static atomic_ullong padding_byte_count;
+static atomic_ullong cache_hit_count;
+static atomic_ullong cache_miss_count;
+static glsl_instrument_callback_t callback;
+static void* callback_user_data;
+/* number of instrumented calls the thread is currently in, only the outermost one is recorded */
+static GLSLCOM_THREAD_LOCAL u32 call_depth;
+
+static u64 get_time_ns(void)
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = { 0 };
+	LARGE_INTEGER counter;
+	if(frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (u64)((f64)counter.QuadPart * 1e9 / (f64)frequency.QuadPart);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+static inline u64 load_counter(atomic_ullong* counter)
+{
+	return atomic_load_explicit(counter, memory_order_relaxed);
+}
+
+static inline void add_counter(atomic_ullong* counter, u64 value)
+{
+	atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+GLSLCOM_API u64 glsl_instrument_begin(void)
+{
+	/* nested calls are never recorded, so they don't read the clock either */
+	return (call_depth++ == 0) ? get_time_ns() : 0;
+}
+
+GLSLCOM_API void glsl_instrument_end(glsl_instrument_api_t api, u64 start_ns, u64 bytes)
+{
+	_ASSERT((api < GLSL_INSTRUMENT_API_MAX) && (call_depth > 0));
+	if(--call_depth != 0)
+		return;
+	u64 time_ns = get_time_ns() - start_ns;
+	api_counters_t* counters = &api_counters[api];
+	add_counter(&counters->call_count, 1);
+	add_counter(&counters->time_ns, time_ns);
+	add_counter(&counters->bytes, bytes);
+	if(callback != NULL)
+		callback(callback_user_data, api, time_ns, bytes);
+}
+
+GLSLCOM_API void glsl_instrument_add_padding(u64 bytes)
+{
+	add_counter(&padding_byte_count, bytes);
+}
+
+GLSLCOM_API void glsl_instrument_add_cache_lookup(bool is_hit)
+{
+	add_counter(is_hit ? &cache_hit_count : &cache_miss_count, 1);
+}
+
+GLSLCOM_API bool glsl_instrument_is_enabled(void)
+{
+	return true;
+}
+
+GLSLCOM_API void glsl_instrument_get_snapshot(glsl_instrument_snapshot_t* out_snapshot)
+{
+	memset(out_snapshot, 0, sizeof(glsl_instrument_snapshot_t));
+	for(u32 i = 0; i < GLSL_INSTRUMENT_API_MAX; i++)
+	{
+		glsl_instrument_api_stats_t* stats = &out_snapshot->apis[i];
+		stats->call_count = load_counter(&api_counters[i].call_count);
+		stats->time_ns = load_counter(&api_counters[i].time_ns);
+		stats->bytes = load_counter(&api_counters[i].bytes);
+		switch(i)
+		{
+			case GLSL_INSTRUMENT_API_LAYOUTOF_STRUCT:
+			case GLSL_INSTRUMENT_API_LAYOUT_TREE_CREATE:
+			case GLSL_INSTRUMENT_API_LAYOUT_CACHE_GET:
+				break;
+			case GLSL_INSTRUMENT_API_LAYOUT_CONVERT:
+			case GLSL_INSTRUMENT_API_LAYOUT_MIGRATION:
+				out_snapshot->bytes_converted += stats->bytes;
+				break;
+			default:
+				out_snapshot->bytes_packed += stats->bytes;
+				break;
+		}
+	}
+	out_snapshot->padding_bytes_written = load_counter(&padding_byte_count);
+	out_snapshot->cache_hit_count = load_counter(&cache_hit_count);
+	out_snapshot->cache_miss_count = load_counter(&cache_miss_count);
+}
+
+GLSLCOM_API void glsl_instrument_reset(void)
+{
+	for(u32 i = 0; i < GLSL_INSTRUMENT_API_MAX; i++)
+	{
+		atomic_store_explicit(&api_counters[i].call_count, 0, memory_order_relaxed);
+		atomic_store_explicit(&api_counters[i].time_ns, 0, memory_order_relaxed);
+		atomic_store_explicit(&api_counters[i].bytes, 0, memory_order_relaxed);
+	}
+	atomic_store_explicit(&padding_byte_count, 0, memory_order_relaxed);
+	atomic_store_explicit(&cache_hit_count, 0, memory_order_relaxed);
+	atomic_store_explicit(&cache_miss_count, 0, memory_order_relaxed);
+}
+
+GLSLCOM_API void glsl_instrument_set_callback(glsl_instrument_callback_t _callback, void* user_data)
+{
+	callback = _callback;
+	callback_user_data = user_data;
+}
+
+#else
+
+GLSLCOM_API u64 glsl_instrument_begin(void) { return 0; }
+GLSLCOM_API void glsl_instrument_end(glsl_instrument_api_t api, u64 start_ns, u64 bytes) { (void)api; (void)start_ns; (void)bytes; }
+GLSLCOM_API void glsl_instrument_add_padding(u64 bytes) { (void)bytes; }
+GLSLCOM_API void glsl_instrument_add_cache_lookup(bool is_hit) { (void)is_hit; }
+GLSLCOM_API bool glsl_instrument_is_enabled(void) { return false; }
+GLSLCOM_API void glsl_instrument_get_snapshot(glsl_instrument_snapshot_t* out_snapshot) { memset(out_snapshot, 0, sizeof(glsl_instrument_snapshot_t)); }
+GLSLCOM_API void glsl_instrument_reset(void) { }
+GLSLCOM_API void glsl_instrument_set_callback(glsl_instrument_callback_t callback, void* user_data) { (void)callback; (void)user_data; }
+
+#endif /* GLSLCOM_INSTRUMENTATION */
+
+GLSLCOM_API const char* glsl_instrument_api_name(glsl_instrument_api_t api)
+{
+	switch(api)
+	{
+		case GLSL_INSTRUMENT_API_LAYOUTOF_STRUCT: return "layoutof_glsl_type_struct";
+		case GLSL_INSTRUMENT_API_LAYOUT_TREE_CREATE: return "glsl_layout_tree_create";
+		case GLSL_INSTRUMENT_API_LAYOUT_CACHE_GET: return "glsl_layout_cache_get";
+		case GLSL_INSTRUMENT_API_PACK_STRIDED: return "glsl_pack_strided";
+		case GLSL_INSTRUMENT_API_UNPACK_STRIDED: return "glsl_unpack_strided";
+		case GLSL_INSTRUMENT_API_PACK_MEMBER: return "glsl_pack_member";
+		case GLSL_INSTRUMENT_API_PACK_STRUCT: return "glsl_pack_struct";
+		case GLSL_INSTRUMENT_API_PACK_MATRICES: return "glsl_pack_matrices";
+		case GLSL_INSTRUMENT_API_COPY_PLAN_EXECUTE: return "glsl_copy_plan_execute";
+		case GLSL_INSTRUMENT_API_QUANTIZE: return "glsl_quantize";
+		case GLSL_INSTRUMENT_API_DEQUANTIZE: return "glsl_dequantize";
+		case GLSL_INSTRUMENT_API_VERTEX_INTERLEAVE: return "glsl_vertex_interleave";
+		case GLSL_INSTRUMENT_API_VERTEX_DEINTERLEAVE: return "glsl_vertex_deinterleave";
+		case GLSL_INSTRUMENT_API_STORAGE_ARRAY_APPEND: return "glsl_storage_array_append";
+		case GLSL_INSTRUMENT_API_LAYOUT_CONVERT: return "glsl_layout_converter_convert";
+		case GLSL_INSTRUMENT_API_LAYOUT_MIGRATION: return "glsl_layout_migration_execute";
+		default: return "<unknown>";
+	}
+}
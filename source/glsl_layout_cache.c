@@ -0,0 +1,350 @@
+#include <glslcommon/glsl_layout_cache.h>
+#include <glslcommon/glsl_fingerprint.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdatomic.h>
+#include <string.h> /* memcpy, memset */
+
+#ifdef _MSC_VER
+#	define GLSLCOM_THREAD_LOCAL __declspec(thread)
+#else
+#	define GLSLCOM_THREAD_LOCAL _Thread_local
+#endif
+
+/* open addressing (linear probing) hash table whose slots are only ever written once (from NULL to a descriptor), so readers never need a lock;
+ * a table is never grown in place, once it gets 3/4 full its descriptors are rehashed into a table of twice the capacity which then replaces it */
+typedef struct glsl_layout_cache_table_t
+{
+	/* power of 2 */
+	u32 capacity;
+	/* number of descriptors in the table, only accessed with the insert lock held */
+	u32 count;
+	/* next table in the list of retired tables */
+	struct glsl_layout_cache_table_t* next_retired;
+	_Atomic(glsl_layout_descriptor_t*) slots[];
+} glsl_layout_cache_table_t;
+
+#define GLSL_LAYOUT_CACHE_HIT_STRIPE_COUNT 16
+
+/* padded to a cache line */
+typedef struct glsl_layout_cache_hit_stripe_t
+{
+	atomic_uint_fast64_t count;
+	u8 padding[64 - sizeof(atomic_uint_fast64_t)];
+} glsl_layout_cache_hit_stripe_t;
+
+/* hands out hit stripes to threads round robin */
+static atomic_uint next_hit_stripe;
+/* hit stripe of the thread plus one, 0 until its first hit */
+static GLSLCOM_THREAD_LOCAL u32 thread_hit_stripe;
+
+struct glsl_layout_cache_t
+{
+	/* table holding every interned descriptor */
+	_Atomic(glsl_layout_cache_table_t*) table;
+	/* serializes interning (and replacing the table), lookups never take it */
+	atomic_flag insert_lock;
+	/* tables replaced by larger ones, lookups which started before the replacement may still be probing them, so they are only freed with the cache */
+	glsl_layout_cache_table_t* retired;
+	/* NULL for the heap, otherwise points to allocator_copy */
+	const glsl_allocator_t* allocator;
+	glsl_allocator_t allocator_copy;
+	/* hits are counted into the stripe of the looking up thread, so concurrent lookups don't all write the same cache line; summed by glsl_layout_cache_get_stats() */
+	glsl_layout_cache_hit_stripe_t hit_stripes[GLSL_LAYOUT_CACHE_HIT_STRIPE_COUNT];
+	/* misses take the insert lock anyway, one counter is enough */
+	atomic_uint_fast64_t miss_count;
+	atomic_uint_fast64_t descriptor_count;
+};
+
+#define GLSL_LAYOUT_CACHE_MIN_CAPACITY 16
+
+static glsl_layout_cache_table_t* table_create(u32 capacity, const glsl_allocator_t* allocator)
+{
+	u64 size = sizeof(glsl_layout_cache_table_t) + sizeof(((glsl_layout_cache_table_t*)NULL)->slots[0]) * capacity;
+	glsl_layout_cache_table_t* table = glsl_allocator_alloc_object(allocator, size);
+	if(table == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_cache_table_t");
+		return NULL;
+	}
+	/* zeroes (NULL) the slots, count and next_retired */
+	memset(table, 0, size);
+	table->capacity = capacity;
+	return table;
+}
+
+/* stores 'descriptor' into the first empty slot of its probe sequence, the insert lock must be held (or the table not yet published) */
+static void table_insert(glsl_layout_cache_table_t* table, glsl_layout_descriptor_t* descriptor)
+{
+	_ASSERT(table->count < table->capacity);
+	u32 mask = table->capacity - 1;
+	for(u32 probe = 0; probe < table->capacity; probe++)
+	{
+		AUTO slot = &table->slots[(descriptor->signature_hash + probe) & mask];
+		if(atomic_load_explicit(slot, memory_order_relaxed) == NULL)
+		{
+			/* release: a reader which sees the descriptor also sees its contents */
+			atomic_store_explicit(slot, descriptor, memory_order_release);
+			table->count++;
+			return;
+		}
+	}
+}
+
+/* rehashes the descriptors of 'table' into a table of twice the capacity and publishes it, the insert lock must be held;
+ * returns the new table, or 'table' itself if the new one couldn't be allocated */
+static glsl_layout_cache_table_t* table_replace(glsl_layout_cache_t* cache, glsl_layout_cache_table_t* table)
+{
+	glsl_layout_cache_table_t* new_table = table_create(table->capacity << 1, cache->allocator);
+	if(new_table == NULL)
+		return table;
+	for(u32 i = 0; i < table->capacity; i++)
+	{
+		glsl_layout_descriptor_t* descriptor = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+		if(descriptor != NULL)
+			table_insert(new_table, descriptor);
+	}
+	atomic_store_explicit(&cache->table, new_table, memory_order_release);
+	table->next_retired = cache->retired;
+	cache->retired = table;
+	return new_table;
+}
+
+static void insert_lock(glsl_layout_cache_t* cache)
+{
+	while(atomic_flag_test_and_set_explicit(&cache->insert_lock, memory_order_acquire));
+}
+
+static void insert_unlock(glsl_layout_cache_t* cache)
+{
+	atomic_flag_clear_explicit(&cache->insert_lock, memory_order_release);
+}
+
+/* members with built-in types ignore align and size, non-array members ignore array_length, and array_length 0 means 1 */
+static glsl_type_layout_traits_t normalize_type_traits(glsl_type_layout_traits_t type_traits)
+{
+	glsl_type_layout_traits_t normalized = { 0 };
+	normalized.type = type_traits.type;
+	normalized.is_array = type_traits.is_array;
+	if(type_traits.type == GLSL_TYPE_UNDEFINED)
+	{
+		normalized.align = type_traits.align;
+		normalized.size = type_traits.size;
+	}
+	if(type_traits.is_array)
+		normalized.array_length = (type_traits.array_length == 0) ? 1 : type_traits.array_length;
+	/* row_major only changes the layout of non-square matrices */
+	normalized.is_row_major = type_traits.is_row_major && (transposeof_glsl_type(type_traits.type) != type_traits.type);
+	return normalized;
+}
+
+static bool type_traits_equal(glsl_type_layout_traits_t a, glsl_type_layout_traits_t b)
+{
+	return (a.type == b.type) && (a.is_array == b.is_array) && (a.align == b.align) && (a.size == b.size) && (a.array_length == b.array_length) && (a.is_row_major == b.is_row_major);
+}
+
+/* 64-bit FNV-1a */
+static u64 hash_u32(u64 hash, u32 value)
+{
+	for(u32 i = 0; i < 4; i++)
+	{
+		hash ^= (value >> (i * 8)) & 0xFFu;
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+static u64 hash_signature(const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout)
+{
+	u64 hash = 0xCBF29CE484222325ULL;
+	hash = hash_u32(hash, (u32)layout);
+	hash = hash_u32(hash, type_traits_count);
+	for(u32 i = 0; i < type_traits_count; i++)
+	{
+		AUTO traits = normalize_type_traits(type_traits[i]);
+		hash = hash_u32(hash, (u32)traits.type);
+		hash = hash_u32(hash, (u32)traits.is_array);
+		hash = hash_u32(hash, traits.align);
+		hash = hash_u32(hash, traits.size);
+		hash = hash_u32(hash, traits.array_length);
+		hash = hash_u32(hash, (u32)traits.is_row_major);
+	}
+	return hash;
+}
+
+static bool descriptor_matches(const glsl_layout_descriptor_t* descriptor, u64 hash, const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout)
+{
+	if((descriptor->signature_hash != hash) || (descriptor->layout != layout) || (descriptor->member_count != type_traits_count))
+		return false;
+	for(u32 i = 0; i < type_traits_count; i++)
+		if(!type_traits_equal(descriptor->member_traits[i], normalize_type_traits(type_traits[i])))
+			return false;
+	return true;
+}
+
+/* probes the table (without writing anything), an empty slot ends the probe sequence as slots are never emptied */
+static glsl_layout_descriptor_t* table_find(glsl_layout_cache_table_t* table, u64 hash, const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout)
+{
+	u32 mask = table->capacity - 1;
+	for(u32 probe = 0; probe < table->capacity; probe++)
+	{
+		glsl_layout_descriptor_t* descriptor = atomic_load_explicit(&table->slots[(hash + probe) & mask], memory_order_acquire);
+		if(descriptor == NULL)
+			return NULL;
+		if(descriptor_matches(descriptor, hash, type_traits, type_traits_count, layout))
+			return descriptor;
+	}
+	return NULL;
+}
+
+/* allocates the descriptor, the interned member traits and the member layouts in a single block */
+static glsl_layout_descriptor_t* descriptor_create(u64 hash, const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout, const glsl_allocator_t* allocator)
+{
+	glsl_layout_descriptor_t* descriptor = glsl_allocator_alloc_object(allocator, sizeof(glsl_layout_descriptor_t)
+												+ sizeof(glsl_type_layout_traits_t) * type_traits_count
+												+ sizeof(glsl_member_layout_t) * type_traits_count);
+	if(descriptor == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_descriptor_t");
+		return NULL;
+	}
+	glsl_type_layout_traits_t* member_traits = (glsl_type_layout_traits_t*)(descriptor + 1);
+	glsl_member_layout_t* members = (glsl_member_layout_t*)(member_traits + type_traits_count);
+	for(u32 i = 0; i < type_traits_count; i++)
+		member_traits[i] = normalize_type_traits(type_traits[i]);
+	descriptor->signature_hash = hash;
+	descriptor->layout = layout;
+	descriptor->member_count = type_traits_count;
+	descriptor->member_traits = member_traits;
+	descriptor->members = members;
+	descriptor->struct_layout = layoutof_glsl_type_struct(member_traits, type_traits_count, layout, members);
+	descriptor->fingerprint = glsl_fingerprint_struct_layout(member_traits, members, type_traits_count, descriptor->struct_layout, layout);
+	return descriptor;
+}
+
+GLSLCOM_API glsl_layout_cache_t* glsl_layout_cache_create(u32 capacity, const glsl_allocator_t* allocator)
+{
+	u32 table_capacity = GLSL_LAYOUT_CACHE_MIN_CAPACITY;
+	/* keep the expected number of descriptors under 3/4 of the first table */
+	while((table_capacity - (table_capacity >> 2)) < capacity)
+		table_capacity <<= 1;
+	glsl_layout_cache_t* cache = glsl_allocator_alloc_object(allocator, sizeof(glsl_layout_cache_t));
+	if(cache == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_cache_t");
+		return NULL;
+	}
+	cache->allocator_copy = (allocator == NULL) ? (glsl_allocator_t) { 0 } : *allocator;
+	cache->allocator = (allocator == NULL) ? NULL : &cache->allocator_copy;
+	atomic_init(&cache->table, table_create(table_capacity, cache->allocator));
+	atomic_flag_clear(&cache->insert_lock);
+	cache->retired = NULL;
+	for(u32 i = 0; i < GLSL_LAYOUT_CACHE_HIT_STRIPE_COUNT; i++)
+		atomic_init(&cache->hit_stripes[i].count, 0);
+	atomic_init(&cache->miss_count, 0);
+	atomic_init(&cache->descriptor_count, 0);
+	return cache;
+}
+
+GLSLCOM_API void glsl_layout_cache_destroy(glsl_layout_cache_t* cache)
+{
+	/* the current table holds every descriptor, retired tables only hold some of them again */
+	glsl_layout_cache_table_t* table = atomic_load_explicit(&cache->table, memory_order_relaxed);
+	for(u32 i = 0; i < table->capacity; i++)
+		glsl_allocator_free_object(atomic_load_explicit(&table->slots[i], memory_order_relaxed));
+	glsl_allocator_free_object(table);
+	table = cache->retired;
+	while(table != NULL)
+	{
+		glsl_layout_cache_table_t* next = table->next_retired;
+		glsl_allocator_free_object(table);
+		table = next;
+	}
+	glsl_allocator_free_object(cache);
+}
+
+static void count_hit(glsl_layout_cache_t* cache)
+{
+	if(thread_hit_stripe == 0)
+		thread_hit_stripe = (atomic_fetch_add_explicit(&next_hit_stripe, 1, memory_order_relaxed) % GLSL_LAYOUT_CACHE_HIT_STRIPE_COUNT) + 1;
+	atomic_fetch_add_explicit(&cache->hit_stripes[thread_hit_stripe - 1].count, 1, memory_order_relaxed);
+	GLSL_INSTRUMENT_CACHE_LOOKUP(true);
+}
+
+static const glsl_layout_descriptor_t* cache_get(glsl_layout_cache_t* cache, const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout)
+{
+	_ASSERT(type_traits_count > 0);
+	_ASSERT(layout < GLSL_MEMORY_LAYOUT_MAX);
+
+	u64 hash = hash_signature(type_traits, type_traits_count, layout);
+	glsl_layout_descriptor_t* descriptor = table_find(atomic_load_explicit(&cache->table, memory_order_acquire), hash, type_traits, type_traits_count, layout);
+	if(descriptor != NULL)
+	{
+		count_hit(cache);
+		return descriptor;
+	}
+
+	/* computed outside of the lock, it is dropped if another thread interns the same signature first */
+	glsl_layout_descriptor_t* created = descriptor_create(hash, type_traits, type_traits_count, layout, cache->allocator);
+	if(created == NULL)
+		return NULL;
+	insert_lock(cache);
+	/* the signature may have been interned, or the table replaced, since the lookup above */
+	glsl_layout_cache_table_t* table = atomic_load_explicit(&cache->table, memory_order_relaxed);
+	descriptor = table_find(table, hash, type_traits, type_traits_count, layout);
+	if(descriptor == NULL)
+	{
+		if(table->count >= (table->capacity - (table->capacity >> 2)))
+			table = table_replace(cache, table);
+		if(table->count < table->capacity)
+		{
+			table_insert(table, created);
+			descriptor = created;
+			created = NULL;
+		}
+	}
+	insert_unlock(cache);
+
+	if(created == NULL)
+	{
+		atomic_fetch_add_explicit(&cache->miss_count, 1, memory_order_relaxed);
+		GLSL_INSTRUMENT_CACHE_LOOKUP(false);
+		atomic_fetch_add_explicit(&cache->descriptor_count, 1, memory_order_relaxed);
+		return descriptor;
+	}
+	glsl_allocator_free_object(created);
+	if(descriptor != NULL)
+	{
+		count_hit(cache);
+	}
+	return descriptor;
+}
+
+GLSLCOM_API const glsl_layout_descriptor_t* glsl_layout_cache_get(glsl_layout_cache_t* cache, const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	const glsl_layout_descriptor_t* descriptor = cache_get(cache, type_traits, type_traits_count, layout);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_LAYOUT_CACHE_GET, 0);
+	return descriptor;
+}
+
+GLSLCOM_API glsl_layout_cache_stats_t glsl_layout_cache_get_stats(const glsl_layout_cache_t* cache)
+{
+	glsl_layout_cache_t* _cache = (glsl_layout_cache_t*)cache;
+	glsl_layout_cache_stats_t stats;
+	stats.hit_count = 0;
+	for(u32 i = 0; i < GLSL_LAYOUT_CACHE_HIT_STRIPE_COUNT; i++)
+		stats.hit_count += atomic_load_explicit(&_cache->hit_stripes[i].count, memory_order_relaxed);
+	stats.miss_count = atomic_load_explicit(&_cache->miss_count, memory_order_relaxed);
+	stats.descriptor_count = atomic_load_explicit(&_cache->descriptor_count, memory_order_relaxed);
+	return stats;
+}
+
+GLSLCOM_API void glsl_layout_cache_reset_stats(glsl_layout_cache_t* cache)
+{
+	for(u32 i = 0; i < GLSL_LAYOUT_CACHE_HIT_STRIPE_COUNT; i++)
+		atomic_store_explicit(&cache->hit_stripes[i].count, 0, memory_order_relaxed);
+	atomic_store_explicit(&cache->miss_count, 0, memory_order_relaxed);
+}
@@ -0,0 +1,85 @@
+#include <glslcommon/glsl_layout_convert.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdlib.h> /* malloc, free */
+
+static bool member_layouts_equal(const glsl_member_layout_t* a, const glsl_member_layout_t* b, u32 count)
+{
+	for(u32 i = 0; i < count; i++)
+		if((a[i].offset != b[i].offset) || (a[i].size != b[i].size) || (a[i].array_stride != b[i].array_stride))
+			return false;
+	return true;
+}
+
+GLSLCOM_API glsl_layout_converter_t* glsl_layout_converter_create(const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t src_layout, glsl_memory_layout_t dst_layout, const glsl_allocator_t* allocator)
+{
+	_ASSERT(type_traits_count > 0);
+
+	/* the caller supplied alignment and size of a nested struct only hold for one layout, its own members would move under the other one */
+	if(src_layout != dst_layout)
+	{
+		for(u32 i = 0; i < type_traits_count; i++)
+		{
+			if(type_traits[i].type == GLSL_TYPE_UNDEFINED)
+			{
+				debug_log_error("[GLSLCommon] Member %u is a nested struct, it can't be converted between two different layouts, flatten it or use glsl_layout_migration_create()", i);
+				return NULL;
+			}
+		}
+	}
+
+	/* scratch space for the member layouts under both layouts and the source description of the plan */
+	glsl_member_layout_t* src_members = malloc(sizeof(glsl_member_layout_t) * type_traits_count * 2 + sizeof(glsl_copy_source_member_t) * type_traits_count);
+	glsl_layout_converter_t* converter = glsl_allocator_alloc_object(allocator, sizeof(glsl_layout_converter_t));
+	if((src_members == NULL) || (converter == NULL))
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_converter_t");
+		return NULL;
+	}
+	glsl_member_layout_t* dst_members = src_members + type_traits_count;
+	glsl_copy_source_member_t* plan_src_members = (glsl_copy_source_member_t*)(dst_members + type_traits_count);
+
+	converter->src_layout = src_layout;
+	converter->dst_layout = dst_layout;
+	converter->src_struct_layout = layoutof_glsl_type_struct(type_traits, type_traits_count, src_layout, src_members);
+	converter->dst_struct_layout = layoutof_glsl_type_struct(type_traits, type_traits_count, dst_layout, dst_members);
+	converter->is_identity = (converter->src_struct_layout.array_stride == converter->dst_struct_layout.array_stride)
+							&& member_layouts_equal(src_members, dst_members, type_traits_count);
+	converter->plan = NULL;
+
+	if(!converter->is_identity)
+	{
+		for(u32 i = 0; i < type_traits_count; i++)
+		{
+			/* rows of the source are its array elements, or its matrix columns (MAT3 --> array of VEC3), or the rows of row_major matrices */
+			u32 element_stride = type_traits[i].is_array ? src_members[i].array_stride : src_members[i].size;
+			plan_src_members[i].offset = src_members[i].offset;
+			plan_src_members[i].row_stride = element_stride / columnsof_glsl_type(layout_typeof_glsl_type(type_traits[i].type, type_traits[i].is_row_major));
+		}
+		converter->plan = glsl_copy_plan_create(type_traits, dst_members, plan_src_members, type_traits_count, allocator);
+	}
+	free(src_members);
+	return converter;
+}
+
+GLSLCOM_API void glsl_layout_converter_destroy(glsl_layout_converter_t* converter)
+{
+	if(converter->plan != NULL)
+		glsl_copy_plan_destroy(converter->plan);
+	glsl_allocator_free_object(converter);
+}
+
+GLSLCOM_API const void* glsl_layout_converter_convert(const glsl_layout_converter_t* converter, void* dst, const void* src, u32 instance_count)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	if(converter->is_identity)
+	{
+		GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_LAYOUT_CONVERT, 0);
+		return src;
+	}
+	glsl_copy_plan_execute_array(converter->plan, dst, converter->dst_struct_layout.array_stride, src, converter->src_struct_layout.array_stride, instance_count);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_LAYOUT_CONVERT, (u64)converter->dst_struct_layout.array_stride * instance_count);
+	return dst;
+}
@@ -0,0 +1,622 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 200809L /* open, fstat, mmap */
+#endif
+
+#include <glslcommon/glsl_layout_db.h>
+#include <glslcommon/glsl_member_index.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdint.h> /* uintptr_t */
+#include <stdio.h> /* fopen, fwrite, fclose */
+#include <stdlib.h> /* malloc, calloc, realloc, free, qsort */
+#include <string.h> /* memcpy, memset, strcmp, strlen */
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+/* the records are part of the file format, so they must not depend on the compiler's padding */
+_Static_assert(sizeof(glsl_layout_db_header_t) == 48, "glsl_layout_db_header_t must be 48 bytes");
+_Static_assert(sizeof(glsl_layout_db_block_t) == 32, "glsl_layout_db_block_t must be 32 bytes");
+_Static_assert(sizeof(glsl_layout_db_member_t) == 40, "glsl_layout_db_member_t must be 40 bytes");
+
+#define GLSL_LAYOUT_DB_ALIGN 8
+
+/* FNV-1a */
+static u64 get_checksum(const u8* bytes, u64 size)
+{
+	u64 hash = 0xcbf29ce484222325ull;
+	for(u64 i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+/* reader */
+
+/* returns true if 'count' records of 'record_size' bytes at 'offset' are aligned and lie within the tables of 'header' */
+static bool is_table_valid(const glsl_layout_db_header_t* header, u32 offset, u32 count, u32 record_size, u32 align)
+{
+	return ((offset % align) == 0) && (offset >= header->header_size) && (((u64)offset + (u64)count * record_size) <= header->file_size);
+}
+
+GLSLCOM_API bool glsl_layout_db_open(glsl_layout_db_t* out_db, const void* data, u64 size)
+{
+	const glsl_layout_db_header_t* header = data;
+	if((data == NULL) || ((uintptr_t)data % GLSL_LAYOUT_DB_ALIGN) != 0)
+	{
+		debug_log_error("[GLSLCommon] Layout database must be loaded at an address aligned to %u bytes", GLSL_LAYOUT_DB_ALIGN);
+		return false;
+	}
+	if((size < sizeof(u32)) || ((header->magic != GLSL_LAYOUT_DB_MAGIC) && (header->magic != 0x474c4442u)))
+	{
+		debug_log_error("[GLSLCommon] Not a layout database");
+		return false;
+	}
+	if(header->magic != GLSL_LAYOUT_DB_MAGIC)
+	{
+		debug_log_error("[GLSLCommon] Layout database was written on a host of the other byte order");
+		return false;
+	}
+	if((size < sizeof(glsl_layout_db_header_t)) || (header->version_major != GLSL_LAYOUT_DB_VERSION_MAJOR))
+	{
+		debug_log_error("[GLSLCommon] Layout database version %u.%u isn't supported, expected %u.x", (size < sizeof(glsl_layout_db_header_t)) ? 0u : header->version_major,
+			(size < sizeof(glsl_layout_db_header_t)) ? 0u : header->version_minor, GLSL_LAYOUT_DB_VERSION_MAJOR);
+		return false;
+	}
+	if((header->header_size < sizeof(glsl_layout_db_header_t)) || ((header->header_size % GLSL_LAYOUT_DB_ALIGN) != 0) || (header->file_size > size) || (header->file_size < header->header_size))
+	{
+		debug_log_error("[GLSLCommon] Layout database is truncated or its header is corrupted");
+		return false;
+	}
+	const u8* bytes = data;
+	if(!is_table_valid(header, header->blocks_offset, header->block_count, sizeof(glsl_layout_db_block_t), GLSL_LAYOUT_DB_ALIGN)
+		|| !is_table_valid(header, header->members_offset, header->member_count, sizeof(glsl_layout_db_member_t), GLSL_LAYOUT_DB_ALIGN)
+		|| !is_table_valid(header, header->strings_offset, header->strings_size, 1, 1)
+		/* every name ends before the end of the string table, even if a name offset is corrupted */
+		|| ((header->strings_size == 0) ? (header->block_count != 0) : (bytes[header->strings_offset + header->strings_size - 1] != 0)))
+	{
+		debug_log_error("[GLSLCommon] Layout database tables are out of bounds");
+		return false;
+	}
+
+	out_db->header = header;
+	out_db->blocks = (const glsl_layout_db_block_t*)(bytes + header->blocks_offset);
+	out_db->members = (const glsl_layout_db_member_t*)(bytes + header->members_offset);
+	out_db->strings = (const char*)(bytes + header->strings_offset);
+	return true;
+}
+
+static inline s32 compare_block_key(const glsl_layout_db_block_t* block, u64 name_hash, u32 layout)
+{
+	if(block->name_hash != name_hash)
+		return (block->name_hash < name_hash) ? -1 : 1;
+	if(block->layout != layout)
+		return (block->layout < layout) ? -1 : 1;
+	return 0;
+}
+
+GLSLCOM_API bool glsl_layout_db_verify(const glsl_layout_db_t* db)
+{
+	const glsl_layout_db_header_t* header = db->header;
+	const u8* bytes = (const u8*)header;
+	if(get_checksum(bytes + header->header_size, header->file_size - header->header_size) != header->checksum)
+	{
+		debug_log_error("[GLSLCommon] Layout database checksum mismatch");
+		return false;
+	}
+	for(u32 i = 0; i < header->block_count; i++)
+	{
+		const glsl_layout_db_block_t* block = &db->blocks[i];
+		if((block->name_offset >= header->strings_size) || (block->layout >= GLSL_MEMORY_LAYOUT_MAX)
+			|| (((u64)block->first_member + block->member_count) > header->member_count)
+			|| ((i > 0) && (compare_block_key(&db->blocks[i - 1], block->name_hash, block->layout) > 0)))
+		{
+			debug_log_error("[GLSLCommon] Layout database block %u is corrupted", i);
+			return false;
+		}
+		const glsl_layout_db_member_t* members = glsl_layout_db_get_members(db, block);
+		for(u32 j = 0; j < block->member_count; j++)
+		{
+			if((members[j].name_offset >= header->strings_size) || (members[j].type >= GLSL_TYPE_MAX_NON_OPAQUE) || (members[j].is_row_major > 1)
+				|| ((members[j].outer_array != GLSL_LAYOUT_DB_NO_OUTER_ARRAY) && (members[j].outer_array >= block->member_count))
+				|| ((j > 0) && (members[j - 1].name_hash >= members[j].name_hash)))
+			{
+				debug_log_error("[GLSLCommon] Layout database member %u of block %s is corrupted", j, glsl_layout_db_get_string(db, block->name_offset));
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/* returns the index of the first block whose key isn't less than (name_hash, layout) */
+static u32 lower_bound_block(const glsl_layout_db_t* db, u64 name_hash, u32 layout)
+{
+	u32 first = 0;
+	u32 count = db->header->block_count;
+	while(count > 0)
+	{
+		u32 half = count / 2;
+		if(compare_block_key(&db->blocks[first + half], name_hash, layout) < 0)
+		{
+			first += half + 1;
+			count -= half + 1;
+		}
+		else
+			count = half;
+	}
+	return first;
+}
+
+GLSLCOM_API const glsl_layout_db_block_t* glsl_layout_db_find_block_prehashed(const glsl_layout_db_t* db, u64 name_hash, glsl_memory_layout_t layout)
+{
+	u32 i = lower_bound_block(db, name_hash, layout);
+	if((i == db->header->block_count) || (compare_block_key(&db->blocks[i], name_hash, layout) != 0))
+		return NULL;
+	return &db->blocks[i];
+}
+
+GLSLCOM_API const glsl_layout_db_block_t* glsl_layout_db_find_block(const glsl_layout_db_t* db, const char* name, glsl_memory_layout_t layout)
+{
+	u64 name_hash = glsl_member_index_hash(name, (u32)strlen(name));
+	/* blocks whose names collide are adjacent */
+	for(u32 i = lower_bound_block(db, name_hash, layout); (i < db->header->block_count) && (compare_block_key(&db->blocks[i], name_hash, layout) == 0); i++)
+		if(strcmp(glsl_layout_db_get_string(db, db->blocks[i].name_offset), name) == 0)
+			return &db->blocks[i];
+	return NULL;
+}
+
+GLSLCOM_API const glsl_layout_db_member_t* glsl_layout_db_find_member_prehashed(const glsl_layout_db_t* db, const glsl_layout_db_block_t* block, u64 path_hash)
+{
+	const glsl_layout_db_member_t* members = glsl_layout_db_get_members(db, block);
+	u32 first = 0;
+	u32 count = block->member_count;
+	while(count > 0)
+	{
+		u32 half = count / 2;
+		if(members[first + half].name_hash < path_hash)
+		{
+			first += half + 1;
+			count -= half + 1;
+		}
+		else
+			count = half;
+	}
+	if((first == block->member_count) || (members[first].name_hash != path_hash))
+		return NULL;
+	return &members[first];
+}
+
+GLSLCOM_API const glsl_layout_db_member_t* glsl_layout_db_find_member(const glsl_layout_db_t* db, const glsl_layout_db_block_t* block, const char* path)
+{
+	const glsl_layout_db_member_t* member = glsl_layout_db_find_member_prehashed(db, block, glsl_member_index_hash(path, (u32)strlen(path)));
+	if((member == NULL) || (strcmp(glsl_layout_db_get_string(db, member->name_offset), path) != 0))
+		return NULL;
+	return member;
+}
+
+GLSLCOM_API const glsl_layout_db_member_t* glsl_layout_db_resolve_member(const glsl_layout_db_t* db, const glsl_layout_db_block_t* block, const char* path, u32* out_offset)
+{
+	char member_path[GLSL_MEMBER_INDEX_MAX_PATH_LENGTH];
+	u32 indices[GLSL_MEMBER_INDEX_MAX_INDICES];
+	u32 path_length;
+	u32 index_count;
+	if(!glsl_member_index_split_path(path, member_path, &path_length, indices, &index_count))
+		return NULL;
+	const glsl_layout_db_member_t* member = glsl_layout_db_find_member(db, block, member_path);
+	if(member == NULL)
+		return NULL;
+	/* one multiply-add per index, innermost first, each "[]" links to the member of the array it indexes */
+	const glsl_layout_db_member_t* members = glsl_layout_db_get_members(db, block);
+	u32 offset = member->offset;
+	u32 outer_array = member->outer_array;
+	for(u32 i = index_count; i > 0; i--)
+	{
+		/* also bounds the walk, a corrupted link can't loop for longer than there are indices */
+		if((outer_array >= block->member_count) || (indices[i - 1] >= members[outer_array].array_length))
+			return NULL;
+		offset += indices[i - 1] * members[outer_array].array_stride;
+		outer_array = members[outer_array].outer_array;
+	}
+	*out_offset = offset;
+	return member;
+}
+
+GLSLCOM_API bool glsl_layout_db_map(const char* path, glsl_layout_db_mapping_t* out_mapping)
+{
+	memset(out_mapping, 0, sizeof(glsl_layout_db_mapping_t));
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+	{
+		debug_log_error("[GLSLCommon] Failed to open layout database %s", path);
+		return false;
+	}
+	LARGE_INTEGER file_size;
+	HANDLE mapping = NULL;
+	const void* data = NULL;
+	if(GetFileSizeEx(file, &file_size) && (file_size.QuadPart > 0))
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(mapping != NULL)
+		data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	/* the mapping keeps the file open */
+	CloseHandle(file);
+	if(data == NULL)
+	{
+		if(mapping != NULL)
+			CloseHandle(mapping);
+		debug_log_error("[GLSLCommon] Failed to map layout database %s", path);
+		return false;
+	}
+	out_mapping->data = data;
+	out_mapping->size = (u64)file_size.QuadPart;
+	out_mapping->handle = mapping;
+#else
+	int file = open(path, O_RDONLY);
+	if(file < 0)
+	{
+		debug_log_error("[GLSLCommon] Failed to open layout database %s", path);
+		return false;
+	}
+	struct stat file_stat;
+	void* data = MAP_FAILED;
+	if((fstat(file, &file_stat) == 0) && (file_stat.st_size > 0))
+		data = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	/* the mapping keeps the file open */
+	close(file);
+	if(data == MAP_FAILED)
+	{
+		debug_log_error("[GLSLCommon] Failed to map layout database %s", path);
+		return false;
+	}
+	out_mapping->data = data;
+	out_mapping->size = (u64)file_stat.st_size;
+#endif
+	if(!glsl_layout_db_open(&out_mapping->db, out_mapping->data, out_mapping->size))
+	{
+		glsl_layout_db_unmap(out_mapping);
+		return false;
+	}
+	return true;
+}
+
+GLSLCOM_API void glsl_layout_db_unmap(glsl_layout_db_mapping_t* mapping)
+{
+	if(mapping->data == NULL)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(mapping->data);
+	CloseHandle((HANDLE)mapping->handle);
+#else
+	munmap((void*)mapping->data, (size_t)mapping->size);
+#endif
+	memset(mapping, 0, sizeof(glsl_layout_db_mapping_t));
+}
+
+/* writer */
+
+typedef struct writer_block_t
+{
+	char* name;
+	u64 name_hash;
+	glsl_memory_layout_t layout;
+	u32 size;
+	u32 align;
+	/* owns the flattened members and their paths */
+	glsl_member_index_t* index;
+} writer_block_t;
+
+struct glsl_layout_db_writer_t
+{
+	writer_block_t* blocks;
+	u32 block_count;
+	u32 block_capacity;
+};
+
+GLSLCOM_API glsl_layout_db_writer_t* glsl_layout_db_writer_create(void)
+{
+	glsl_layout_db_writer_t* writer = calloc(1, sizeof(glsl_layout_db_writer_t));
+	if(writer == NULL)
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_db_writer_t");
+	return writer;
+}
+
+GLSLCOM_API void glsl_layout_db_writer_destroy(glsl_layout_db_writer_t* writer)
+{
+	for(u32 i = 0; i < writer->block_count; i++)
+	{
+		free(writer->blocks[i].name);
+		glsl_member_index_destroy(writer->blocks[i].index);
+	}
+	free(writer->blocks);
+	free(writer);
+}
+
+GLSLCOM_API bool glsl_layout_db_writer_add_tree(glsl_layout_db_writer_t* writer, const char* name, const glsl_layout_tree_t* tree)
+{
+	if(name == NULL)
+		name = tree->root.name;
+	glsl_member_index_t* index = glsl_member_index_create_from_tree(tree, NULL);
+	if(index == NULL)
+		return false;
+
+	if(writer->block_count == writer->block_capacity)
+	{
+		u32 capacity = (writer->block_capacity == 0) ? 16 : (writer->block_capacity * 2);
+		writer_block_t* blocks = realloc(writer->blocks, sizeof(writer_block_t) * capacity);
+		if(blocks == NULL)
+		{
+			debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_db_writer_t");
+			return false;
+		}
+		writer->blocks = blocks;
+		writer->block_capacity = capacity;
+	}
+	u32 name_length = (u32)strlen(name);
+	char* name_copy = malloc(name_length + 1);
+	if(name_copy == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_db_writer_t");
+		return false;
+	}
+	memcpy(name_copy, name, name_length + 1);
+
+	writer->blocks[writer->block_count++] = (writer_block_t)
+	{
+		.name = name_copy,
+		.name_hash = glsl_member_index_hash(name, name_length),
+		.layout = tree->layout,
+		.size = tree->root.size,
+		.align = tree->root.align,
+		.index = index
+	};
+	return true;
+}
+
+static int compare_blocks(const void* a, const void* b)
+{
+	const writer_block_t* block_a = *(const writer_block_t* const*)a;
+	const writer_block_t* block_b = *(const writer_block_t* const*)b;
+	if(block_a->name_hash != block_b->name_hash)
+		return (block_a->name_hash < block_b->name_hash) ? -1 : 1;
+	if(block_a->layout != block_b->layout)
+		return (block_a->layout < block_b->layout) ? -1 : 1;
+	return strcmp(block_a->name, block_b->name);
+}
+
+static int compare_entries(const void* a, const void* b)
+{
+	const glsl_member_index_entry_t* entry_a = *(const glsl_member_index_entry_t* const*)a;
+	const glsl_member_index_entry_t* entry_b = *(const glsl_member_index_entry_t* const*)b;
+	return (entry_a->hash < entry_b->hash) ? -1 : ((entry_a->hash > entry_b->hash) ? 1 : 0);
+}
+
+/* returns the position of the entry hashed 'hash' among the 'count' entries sorted by hash, GLSL_LAYOUT_DB_NO_OUTER_ARRAY for 0 */
+static u32 find_sorted_entry(const glsl_member_index_entry_t* const* sorted_entries, u32 count, u64 hash)
+{
+	if(hash == 0)
+		return GLSL_LAYOUT_DB_NO_OUTER_ARRAY;
+	u32 first = 0;
+	while(count > 0)
+	{
+		u32 half = count / 2;
+		if(sorted_entries[first + half]->hash < hash)
+		{
+			first += half + 1;
+			count -= half + 1;
+		}
+		else
+			count = half;
+	}
+	return first;
+}
+
+/* names shared by several blocks (member paths of shader variants mostly) are stored once,
+ * open addressing over the name hashes which the blocks and members already carry */
+typedef struct string_slot_t
+{
+	const char* string;
+	u64 hash;
+	u32 offset;
+} string_slot_t;
+
+typedef struct string_table_t
+{
+	string_slot_t* slots;
+	u32 slot_mask;
+	/* NULL when only measuring */
+	char* dst;
+	u64 dst_capacity;
+	u64 size;
+} string_table_t;
+
+static u32 intern_string(string_table_t* table, const char* string, u64 hash)
+{
+	u32 slot = (u32)hash & table->slot_mask;
+	while(table->slots[slot].string != NULL)
+	{
+		if((table->slots[slot].hash == hash) && (strcmp(table->slots[slot].string, string) == 0))
+			return table->slots[slot].offset;
+		slot = (slot + 1) & table->slot_mask;
+	}
+	u64 length = strlen(string) + 1;
+	u32 offset = (u32)table->size;
+	if((table->dst != NULL) && ((table->size + length) <= table->dst_capacity))
+		memcpy(table->dst + table->size, string, length);
+	table->slots[slot] = (string_slot_t) { string, hash, offset };
+	table->size += length;
+	return offset;
+}
+
+/* serializes into 'dst' (of 'dst_size' bytes) or, if 'dst' is NULL, only computes the size; returns the size of the database, 0 on failure */
+static u64 writer_serialize(const glsl_layout_db_writer_t* writer, u8* dst, u64 dst_size)
+{
+	u32 block_count = writer->block_count;
+	u64 member_count = 0;
+	u32 max_block_member_count = 0;
+	for(u32 i = 0; i < block_count; i++)
+	{
+		u32 count = glsl_member_index_get_count(writer->blocks[i].index);
+		member_count += count;
+		if(max_block_member_count < count)
+			max_block_member_count = count;
+	}
+
+	u32 slot_count = 16;
+	while(slot_count < ((block_count + member_count) * 2))
+		slot_count *= 2;
+	const writer_block_t** sorted_blocks = malloc(sizeof(writer_block_t*) * block_count + sizeof(glsl_member_index_entry_t*) * max_block_member_count + 1);
+	string_slot_t* slots = calloc(slot_count, sizeof(string_slot_t));
+	if((sorted_blocks == NULL) || (slots == NULL))
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the layout database serialization");
+		return 0;
+	}
+	const glsl_member_index_entry_t** sorted_entries = (const glsl_member_index_entry_t**)(sorted_blocks + block_count);
+
+	for(u32 i = 0; i < block_count; i++)
+		sorted_blocks[i] = &writer->blocks[i];
+	qsort(sorted_blocks, block_count, sizeof(writer_block_t*), compare_blocks);
+
+	u64 blocks_offset = sizeof(glsl_layout_db_header_t);
+	u64 members_offset = blocks_offset + sizeof(glsl_layout_db_block_t) * (u64)block_count;
+	u64 strings_offset = members_offset + sizeof(glsl_layout_db_member_t) * member_count;
+	bool is_writing = (dst != NULL) && (strings_offset <= dst_size);
+	glsl_layout_db_block_t* dst_blocks = is_writing ? (glsl_layout_db_block_t*)(dst + blocks_offset) : NULL;
+	glsl_layout_db_member_t* dst_members = is_writing ? (glsl_layout_db_member_t*)(dst + members_offset) : NULL;
+	string_table_t strings = { slots, slot_count - 1, is_writing ? (char*)(dst + strings_offset) : NULL, is_writing ? (dst_size - strings_offset) : 0, 0 };
+
+	bool is_success = true;
+	u32 first_member = 0;
+	for(u32 i = 0; (i < block_count) && is_success; i++)
+	{
+		const writer_block_t* block = sorted_blocks[i];
+		if((i > 0) && (compare_blocks(&sorted_blocks[i - 1], &sorted_blocks[i]) == 0))
+		{
+			debug_log_error("[GLSLCommon] Block %s is added to the layout database twice with the same layout", block->name);
+			is_success = false;
+			break;
+		}
+		u32 name_offset = intern_string(&strings, block->name, block->name_hash);
+
+		u32 count = glsl_member_index_get_count(block->index);
+		const glsl_member_index_entry_t* entries = glsl_member_index_get_entries(block->index);
+		for(u32 j = 0; j < count; j++)
+			sorted_entries[j] = &entries[j];
+		qsort(sorted_entries, count, sizeof(glsl_member_index_entry_t*), compare_entries);
+		for(u32 j = 0; j < count; j++)
+		{
+			const glsl_member_index_entry_t* entry = sorted_entries[j];
+			u32 member_name_offset = intern_string(&strings, entry->name, entry->hash);
+			if(is_writing)
+				dst_members[first_member + j] = (glsl_layout_db_member_t)
+				{
+					.name_hash = entry->hash,
+					.name_offset = member_name_offset,
+					.type = (u32)entry->type,
+					.offset = entry->offset,
+					.size = entry->size,
+					.array_length = entry->array_length,
+					.array_stride = entry->array_stride,
+					.is_row_major = entry->is_row_major ? 1 : 0,
+					.outer_array = find_sorted_entry(sorted_entries, count, entry->outer_array_hash)
+				};
+		}
+
+		if(is_writing)
+			dst_blocks[i] = (glsl_layout_db_block_t)
+			{
+				.name_hash = block->name_hash,
+				.name_offset = name_offset,
+				.layout = (u32)block->layout,
+				.size = block->size,
+				.align = block->align,
+				.first_member = first_member,
+				.member_count = count
+			};
+		first_member += count;
+	}
+	free(slots);
+	free(sorted_blocks);
+
+	u64 file_size = strings_offset + strings.size;
+	if(!is_success)
+		return 0;
+	if(file_size > 0xffffffffull)
+	{
+		debug_log_error("[GLSLCommon] Layout database exceeds 4 GiB");
+		return 0;
+	}
+	if(dst == NULL)
+		return file_size;
+	if(file_size > dst_size)
+	{
+		debug_log_error("[GLSLCommon] Layout database needs %llu bytes but the destination has %llu", (unsigned long long)file_size, (unsigned long long)dst_size);
+		return 0;
+	}
+
+	glsl_layout_db_header_t* header = (glsl_layout_db_header_t*)dst;
+	*header = (glsl_layout_db_header_t)
+	{
+		.magic = GLSL_LAYOUT_DB_MAGIC,
+		.version_major = GLSL_LAYOUT_DB_VERSION_MAJOR,
+		.version_minor = GLSL_LAYOUT_DB_VERSION_MINOR,
+		.header_size = sizeof(glsl_layout_db_header_t),
+		.file_size = (u32)file_size,
+		.block_count = block_count,
+		.blocks_offset = (u32)blocks_offset,
+		.member_count = (u32)member_count,
+		.members_offset = (u32)members_offset,
+		.strings_size = (u32)strings.size,
+		.strings_offset = (u32)strings_offset
+	};
+	header->checksum = get_checksum(dst + header->header_size, file_size - header->header_size);
+	return file_size;
+}
+
+GLSLCOM_API u32 glsl_layout_db_writer_get_size(const glsl_layout_db_writer_t* writer)
+{
+	return (u32)writer_serialize(writer, NULL, 0);
+}
+
+GLSLCOM_API bool glsl_layout_db_writer_write(const glsl_layout_db_writer_t* writer, void* dst, u32 dst_size)
+{
+	_ASSERT(((uintptr_t)dst % GLSL_LAYOUT_DB_ALIGN) == 0);
+	return writer_serialize(writer, dst, dst_size) != 0;
+}
+
+GLSLCOM_API bool glsl_layout_db_writer_write_file(const glsl_layout_db_writer_t* writer, const char* path)
+{
+	u32 size = glsl_layout_db_writer_get_size(writer);
+	if(size == 0)
+		return false;
+	/* malloc'ed memory is aligned for u64 */
+	void* data = malloc(size);
+	if(data == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the layout database");
+		return false;
+	}
+	bool is_success = glsl_layout_db_writer_write(writer, data, size);
+	if(is_success)
+	{
+		FILE* file = fopen(path, "wb");
+		is_success = (file != NULL) && (fwrite(data, 1, size, file) == size);
+		if((file != NULL) && (fclose(file) != 0))
+			is_success = false;
+		if(!is_success)
+			debug_log_error("[GLSLCommon] Failed to write layout database %s", path);
+	}
+	free(data);
+	return is_success;
+}
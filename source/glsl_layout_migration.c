@@ -0,0 +1,515 @@
+#include <glslcommon/glsl_layout_migration.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdlib.h> /* malloc, realloc, free, qsort */
+#include <string.h> /* memcpy, memmove, memset, strlen */
+
+/* flags of each byte of a new instance */
+#define BYTE_COPIED 1
+/* part of a member (including padding inside matrices and arrays) */
+#define BYTE_MEMBER 2
+/* written by a run of the (merged) copy plan */
+#define BYTE_WRITTEN 4
+
+typedef struct migration_builder_t
+{
+	glsl_layout_diff_entry_t* entries;
+	u32 entry_count;
+	/* copy runs of the surviving members, one per innermost array run (or per matrix) */
+	glsl_copy_op_t* ops;
+	u32 op_count;
+	u32 op_capacity;
+	/* BYTE_* flags of each byte of a new instance */
+	u8* bytes;
+	bool is_failed;
+} migration_builder_t;
+
+static u32 count_nodes(const glsl_layout_node_t* node)
+{
+	u32 count = 1;
+	for(u32 i = 0; i < node->child_count; i++)
+		count += count_nodes(&node->children[i]);
+	return count;
+}
+
+static void add_entry(migration_builder_t* builder, glsl_layout_change_t change, const glsl_layout_node_t* old_node, const glsl_layout_node_t* new_node)
+{
+	builder->entries[builder->entry_count++] = (glsl_layout_diff_entry_t) { change, old_node, new_node };
+}
+
+static void add_op(migration_builder_t* builder, glsl_copy_op_t op)
+{
+	if(builder->op_count == builder->op_capacity)
+	{
+		u32 capacity = (builder->op_capacity == 0) ? 64 : (builder->op_capacity * 2);
+		glsl_copy_op_t* ops = realloc(builder->ops, sizeof(glsl_copy_op_t) * capacity);
+		if(ops == NULL)
+		{
+			debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the layout migration");
+			builder->is_failed = true;
+			return;
+		}
+		builder->ops = ops;
+		builder->op_capacity = capacity;
+	}
+	builder->ops[builder->op_count++] = op;
+}
+
+static void mark_bytes(u8* bytes, const glsl_copy_op_t* op, u8 flag)
+{
+	for(u32 i = 0; i < op->row_count; i++)
+		for(u32 j = 0; j < op->row_size; j++)
+			bytes[op->dst_offset + i * op->dst_stride + j] |= flag;
+}
+
+/* marks every element of 'node' (and of its members) in an instance whose parent struct is at 'base' as BYTE_MEMBER */
+static void mark_member_bytes(u8* bytes, const glsl_layout_node_t* node, u32 base)
+{
+	u32 element_count = 1;
+	for(u32 i = 0; i < node->array_dimension_count; i++)
+		element_count *= node->array_lengths[i];
+	for(u32 i = 0; i < element_count; i++)
+	{
+		/* offset of element i, the innermost dimension varying fastest */
+		u32 offset = base + node->offset;
+		for(u32 j = node->array_dimension_count, index = i; j > 0; j--)
+		{
+			offset += (index % node->array_lengths[j - 1]) * node->array_strides[j - 1];
+			index /= node->array_lengths[j - 1];
+		}
+		if(node->type == GLSL_TYPE_UNDEFINED)
+			for(u32 j = 0; j < node->child_count; j++)
+				mark_member_bytes(bytes, &node->children[j], offset);
+		else
+			for(u32 j = 0; j < node->element_size; j++)
+				bytes[offset + j] |= BYTE_MEMBER;
+	}
+}
+
+static glsl_layout_change_t compare_nodes(const glsl_layout_node_t* old_node, const glsl_layout_node_t* new_node)
+{
+	if((old_node->type != new_node->type) || (old_node->array_dimension_count != new_node->array_dimension_count))
+		return GLSL_LAYOUT_CHANGE_RETYPED;
+	/* the transpose of a square matrix has the same layout type, but its bytes can't be copied as they are either */
+	if((columnsof_glsl_type(old_node->type) > 1) && (old_node->is_row_major != new_node->is_row_major))
+		return GLSL_LAYOUT_CHANGE_RETYPED;
+	bool is_moved = (old_node->offset != new_node->offset) || (old_node->element_size != new_node->element_size);
+	for(u32 i = 0; i < old_node->array_dimension_count; i++)
+	{
+		if(old_node->array_lengths[i] != new_node->array_lengths[i])
+			return GLSL_LAYOUT_CHANGE_RESIZED;
+		if(old_node->array_strides[i] != new_node->array_strides[i])
+			is_moved = true;
+	}
+	return is_moved ? GLSL_LAYOUT_CHANGE_MOVED : GLSL_LAYOUT_CHANGE_NONE;
+}
+
+static void diff_structs(migration_builder_t* builder, const glsl_layout_node_t* old_struct, const glsl_layout_node_t* new_struct, u32 old_base, u32 new_base, bool is_recorded);
+
+/* copies a run of 'run_length' elements of the innermost array dimension 'dimension' of a non-struct member (1 element if it isn't an array) */
+static void migrate_elements(migration_builder_t* builder, const glsl_layout_node_t* old_node, const glsl_layout_node_t* new_node, u32 old_offset, u32 new_offset, u32 run_length, u32 dimension)
+{
+	glsl_type_t layout_type = layout_typeof_glsl_type(new_node->type, new_node->is_row_major);
+	/* matrices are rows of their columns (or rows if row_major), 'row_size' bytes each */
+	u32 column_count = columnsof_glsl_type(layout_type);
+	u32 row_size = sizeof_glsl_type(layout_type, GLSL_MEMORY_LAYOUT_SCALAR) / column_count;
+	u32 old_column_stride = old_node->element_size / column_count;
+	u32 new_column_stride = new_node->element_size / column_count;
+	bool is_array = dimension < new_node->array_dimension_count;
+	u32 old_stride = is_array ? old_node->array_strides[dimension] : 0;
+	u32 new_stride = is_array ? new_node->array_strides[dimension] : 0;
+
+	/* columns spaced differently (e.g. mat3 from std140 to scalar) are copied one element at a time */
+	if(old_column_stride != new_column_stride)
+	{
+		for(u32 i = 0; i < run_length; i++)
+			add_op(builder, (glsl_copy_op_t)
+			{
+				.dst_offset = new_offset + i * new_stride,
+				.src_offset = old_offset + i * old_stride,
+				.row_size = row_size,
+				.row_count = column_count,
+				.dst_stride = new_column_stride,
+				.src_stride = old_column_stride
+			});
+		return;
+	}
+
+	/* otherwise an element is a single row, padding between its columns included */
+	glsl_copy_op_t op =
+	{
+		.dst_offset = new_offset,
+		.src_offset = old_offset,
+		.row_size = (column_count - 1) * new_column_stride + row_size,
+		.row_count = run_length,
+		.dst_stride = new_stride,
+		.src_stride = old_stride
+	};
+	/* and so is a run of identically strided elements */
+	if((op.row_count > 1) && (op.dst_stride == op.src_stride))
+	{
+		op.row_size += (op.row_count - 1) * op.dst_stride;
+		op.row_count = 1;
+	}
+	if(op.row_count == 1)
+	{
+		op.dst_stride = op.row_size;
+		op.src_stride = op.row_size;
+	}
+	add_op(builder, op);
+}
+
+/* copies every element present in both the old and the new member, which are at 'old_offset' and 'new_offset' in their instances */
+static void migrate_member(migration_builder_t* builder, const glsl_layout_node_t* old_node, const glsl_layout_node_t* new_node, u32 old_offset, u32 new_offset, bool is_recorded)
+{
+	u32 dimension_count = new_node->array_dimension_count;
+	bool is_struct = new_node->type == GLSL_TYPE_UNDEFINED;
+	/* non-struct members copy their innermost dimension as runs, structs are migrated element by element */
+	u32 outer_count = (is_struct || (dimension_count == 0)) ? dimension_count : (dimension_count - 1);
+	u32 lengths[GLSL_MAX_ARRAY_DIMENSIONS + 1];
+	for(u32 i = 0; i < dimension_count; i++)
+		lengths[i] = (old_node->array_lengths[i] < new_node->array_lengths[i]) ? old_node->array_lengths[i] : new_node->array_lengths[i];
+	u32 run_length = (outer_count < dimension_count) ? lengths[outer_count] : 1;
+
+	u32 indices[GLSL_MAX_ARRAY_DIMENSIONS] = { 0 };
+	while(!builder->is_failed)
+	{
+		u32 old_element = old_offset;
+		u32 new_element = new_offset;
+		bool is_first = true;
+		for(u32 i = 0; i < outer_count; i++)
+		{
+			old_element += indices[i] * old_node->array_strides[i];
+			new_element += indices[i] * new_node->array_strides[i];
+			is_first = is_first && (indices[i] == 0);
+		}
+		if(is_struct)
+			diff_structs(builder, old_node, new_node, old_element, new_element, is_recorded && is_first);
+		else
+			migrate_elements(builder, old_node, new_node, old_element, new_element, run_length, outer_count);
+
+		/* next element of the outer dimensions, innermost first */
+		u32 i = outer_count;
+		while((i > 0) && (++indices[i - 1] == lengths[i - 1]))
+			indices[--i] = 0;
+		if(i == 0)
+			break;
+	}
+}
+
+/* diffs the members of two structs whose elements are at 'old_base' and 'new_base' in their instances, entries are recorded for the first element only */
+static void diff_structs(migration_builder_t* builder, const glsl_layout_node_t* old_struct, const glsl_layout_node_t* new_struct, u32 old_base, u32 new_base, bool is_recorded)
+{
+	for(u32 i = 0; i < new_struct->child_count; i++)
+	{
+		const glsl_layout_node_t* new_node = &new_struct->children[i];
+		const glsl_layout_node_t* old_node = glsl_layout_node_find_child(old_struct, new_node->name, (u32)strlen(new_node->name));
+		if(old_node == NULL)
+		{
+			if(is_recorded)
+				add_entry(builder, GLSL_LAYOUT_CHANGE_ADDED, NULL, new_node);
+			continue;
+		}
+		glsl_layout_change_t change = compare_nodes(old_node, new_node);
+		if(is_recorded)
+			add_entry(builder, change, old_node, new_node);
+		if(change != GLSL_LAYOUT_CHANGE_RETYPED)
+			migrate_member(builder, old_node, new_node, old_base + old_node->offset, new_base + new_node->offset, is_recorded);
+	}
+	if(!is_recorded)
+		return;
+	for(u32 i = 0; i < old_struct->child_count; i++)
+	{
+		const glsl_layout_node_t* old_node = &old_struct->children[i];
+		if(glsl_layout_node_find_child(new_struct, old_node->name, (u32)strlen(old_node->name)) == NULL)
+			add_entry(builder, GLSL_LAYOUT_CHANGE_REMOVED, old_node, NULL);
+	}
+}
+
+static int compare_ops(const void* a, const void* b)
+{
+	const glsl_copy_op_t* op_a = a;
+	const glsl_copy_op_t* op_b = b;
+	return (op_a->dst_offset < op_b->dst_offset) ? -1 : ((op_a->dst_offset > op_b->dst_offset) ? 1 : 0);
+}
+
+/* runs with equal source and destination are skipped in place, the others move down (towards lower addresses) or up */
+static s32 get_op_direction(const glsl_copy_op_t* op)
+{
+	if(op->dst_offset != op->src_offset)
+		return (op->dst_offset < op->src_offset) ? -1 : 1;
+	if((op->row_count == 1) || (op->dst_stride == op->src_stride))
+		return 0;
+	return (op->dst_stride < op->src_stride) ? -1 : 1;
+}
+
+static inline u32 get_span_end(u32 offset, u32 stride, const glsl_copy_op_t* op)
+{
+	return offset + (op->row_count - 1) * stride + op->row_size;
+}
+
+static inline bool is_overlapping(u32 begin_a, u32 end_a, u32 begin_b, u32 end_b)
+{
+	return (begin_a < end_b) && (begin_b < end_a);
+}
+
+/* in place, runs moving down are executed first in ascending order and runs moving up then in descending order (see execute_ops_in_place()),
+ * which is safe if no run overwrites the source of a run executed after it and every run can be moved row by row */
+static bool is_in_place_safe(const glsl_copy_op_t* ops, u32 op_count)
+{
+	/* execution order, as indices into 'ops' */
+	u32* order = malloc(sizeof(u32) * op_count + 1);
+	if(order == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the layout migration");
+		return false;
+	}
+	u32 order_count = 0;
+	for(u32 i = 0; i < op_count; i++)
+		if(get_op_direction(&ops[i]) < 0)
+			order[order_count++] = i;
+	for(u32 i = op_count; i > 0; i--)
+		if(get_op_direction(&ops[i - 1]) > 0)
+			order[order_count++] = i - 1;
+
+	bool is_safe = true;
+	for(u32 i = 0; is_safe && (i < order_count); i++)
+	{
+		const glsl_copy_op_t* op = &ops[order[i]];
+		u32 dst_end = get_span_end(op->dst_offset, op->dst_stride, op);
+		/* rows moving down in ascending order (or up in descending order) only overwrite rows already moved if they don't spread out (or in) */
+		bool is_self_safe = (op->row_count == 1) || ((get_op_direction(op) < 0) ? (op->dst_stride <= op->src_stride) : (op->dst_stride >= op->src_stride));
+		if(!is_self_safe && is_overlapping(op->dst_offset, dst_end, op->src_offset, get_span_end(op->src_offset, op->src_stride, op)))
+			is_safe = false;
+		for(u32 j = i + 1; is_safe && (j < order_count); j++)
+		{
+			const glsl_copy_op_t* next = &ops[order[j]];
+			if(is_overlapping(op->dst_offset, dst_end, next->src_offset, get_span_end(next->src_offset, next->src_stride, next)))
+				is_safe = false;
+		}
+	}
+	free(order);
+	return is_safe;
+}
+
+GLSLCOM_API glsl_layout_migration_t* glsl_layout_migration_create(const glsl_layout_tree_t* old_tree, const glsl_layout_tree_t* new_tree, const glsl_allocator_t* allocator)
+{
+	u32 max_entry_count = count_nodes(&old_tree->root) + count_nodes(&new_tree->root);
+	u32 new_size = new_tree->root.size;
+	migration_builder_t builder = { 0 };
+	builder.entries = malloc(sizeof(glsl_layout_diff_entry_t) * max_entry_count + new_size);
+	if(builder.entries == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the layout migration");
+		return NULL;
+	}
+	builder.bytes = (u8*)(builder.entries + max_entry_count);
+	memset(builder.bytes, 0, new_size);
+	for(u32 i = 0; i < new_tree->root.child_count; i++)
+		mark_member_bytes(builder.bytes, &new_tree->root.children[i], 0);
+	diff_structs(&builder, &old_tree->root, &new_tree->root, 0, 0, true);
+	if(builder.is_failed)
+	{
+		free(builder.ops);
+		free(builder.entries);
+		return NULL;
+	}
+	for(u32 i = 0; i < builder.op_count; i++)
+		mark_bytes(builder.bytes, &builder.ops[i], BYTE_COPIED);
+
+	/* ordered by destination, so adjacent members which keep their relative placement merge into single runs */
+	if(builder.op_count > 0)
+		qsort(builder.ops, builder.op_count, sizeof(glsl_copy_op_t), compare_ops);
+	glsl_copy_plan_t* plan = glsl_copy_plan_create_from_ops(builder.ops, builder.op_count, allocator);
+	free(builder.ops);
+	if(plan == NULL)
+	{
+		free(builder.entries);
+		return NULL;
+	}
+	for(u32 i = 0; i < plan->op_count; i++)
+		mark_bytes(builder.bytes, &plan->ops[i], BYTE_WRITTEN);
+
+	/* bytes of members which aren't carried over are zeroed, and so is padding no merged run writes over */
+	for(u32 i = 0; i < new_size; i++)
+		builder.bytes[i] = ((builder.bytes[i] & BYTE_COPIED) == 0) && (((builder.bytes[i] & BYTE_MEMBER) != 0) || ((builder.bytes[i] & BYTE_WRITTEN) == 0));
+	u32 zero_range_count = 0;
+	for(u32 i = 0; i < new_size; i++)
+		if((builder.bytes[i] != 0) && ((i == 0) || (builder.bytes[i - 1] == 0)))
+			zero_range_count++;
+
+	glsl_layout_migration_t* migration = glsl_allocator_alloc_object(allocator, sizeof(glsl_layout_migration_t) + sizeof(glsl_layout_diff_entry_t) * builder.entry_count + sizeof(glsl_layout_range_t) * zero_range_count);
+	if(migration == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_migration_t");
+		glsl_copy_plan_destroy(plan);
+		free(builder.entries);
+		return NULL;
+	}
+	glsl_layout_diff_entry_t* entries = (glsl_layout_diff_entry_t*)(migration + 1);
+	glsl_layout_range_t* zero_ranges = (glsl_layout_range_t*)(entries + builder.entry_count);
+	memcpy(entries, builder.entries, sizeof(glsl_layout_diff_entry_t) * builder.entry_count);
+	for(u32 i = 0, j = 0; i < new_size; i++)
+	{
+		if(builder.bytes[i] == 0)
+			continue;
+		if((i == 0) || (builder.bytes[i - 1] == 0))
+			zero_ranges[j++] = (glsl_layout_range_t) { i, 0 };
+		zero_ranges[j - 1].size++;
+	}
+	free(builder.entries);
+
+	bool is_identity = (old_tree->layout == new_tree->layout) && (old_tree->root.size == new_size);
+	for(u32 i = 0; is_identity && (i < builder.entry_count); i++)
+		is_identity = entries[i].change == GLSL_LAYOUT_CHANGE_NONE;
+
+	*migration = (glsl_layout_migration_t)
+	{
+		.old_tree = old_tree,
+		.new_tree = new_tree,
+		.entry_count = builder.entry_count,
+		.entries = entries,
+		.old_size = old_tree->root.size,
+		.new_size = new_size,
+		.is_identity = is_identity,
+		.is_in_place = is_in_place_safe(plan->ops, plan->op_count),
+		.plan = plan,
+		.zero_range_count = zero_range_count,
+		.zero_ranges = zero_ranges
+	};
+	return migration;
+}
+
+GLSLCOM_API void glsl_layout_migration_destroy(glsl_layout_migration_t* migration)
+{
+	glsl_copy_plan_destroy(migration->plan);
+	glsl_allocator_free_object(migration);
+}
+
+GLSLCOM_API const glsl_layout_diff_entry_t* glsl_layout_migration_find(const glsl_layout_migration_t* migration, const char* name)
+{
+	u32 name_length = (u32)strlen(name);
+	const glsl_layout_node_t* node = glsl_layout_node_find_child(&migration->new_tree->root, name, name_length);
+	if(node == NULL)
+		node = glsl_layout_node_find_child(&migration->old_tree->root, name, name_length);
+	if(node == NULL)
+		return NULL;
+	for(u32 i = 0; i < migration->entry_count; i++)
+		if((migration->entries[i].new_node == node) || (migration->entries[i].old_node == node))
+			return &migration->entries[i];
+	return NULL;
+}
+
+static void fill_zero_ranges(const glsl_layout_migration_t* migration, u8* dst)
+{
+	for(u32 i = 0; i < migration->zero_range_count; i++)
+		memset(dst + migration->zero_ranges[i].offset, 0, migration->zero_ranges[i].size);
+}
+
+#ifdef GLSLCOM_INSTRUMENTATION
+/* returns the number of bytes fill_zero_ranges() writes into each instance */
+static u64 get_zero_byte_count(const glsl_layout_migration_t* migration)
+{
+	u64 count = 0;
+	for(u32 i = 0; i < migration->zero_range_count; i++)
+		count += migration->zero_ranges[i].size;
+	return count;
+}
+#endif /* GLSLCOM_INSTRUMENTATION */
+
+static void move_rows(const glsl_copy_op_t* op, u8* data, bool is_descending)
+{
+	for(u32 i = 0; i < op->row_count; i++)
+	{
+		u32 row = is_descending ? (op->row_count - 1 - i) : i;
+		memmove(data + op->dst_offset + row * op->dst_stride, data + op->src_offset + row * op->src_stride, op->row_size);
+	}
+}
+
+static void execute_ops_in_place(const glsl_copy_plan_t* plan, u8* data)
+{
+	for(u32 i = 0; i < plan->op_count; i++)
+		if(get_op_direction(&plan->ops[i]) < 0)
+			move_rows(&plan->ops[i], data, false);
+	for(u32 i = plan->op_count; i > 0; i--)
+		if(get_op_direction(&plan->ops[i - 1]) > 0)
+			move_rows(&plan->ops[i - 1], data, true);
+}
+
+static void migrate(const glsl_layout_migration_t* migration, void* dst, u32 dst_stride, const void* src, u32 src_stride, u64 count)
+{
+	_ASSERT((dst_stride >= migration->new_size) && (src_stride >= migration->old_size));
+	u8* _dst = dst;
+	const u8* _src = src;
+	if(migration->is_identity && (dst_stride == src_stride))
+	{
+		memcpy(_dst, _src, count * dst_stride);
+		return;
+	}
+	for(u64 i = 0; i < count; i++)
+	{
+		glsl_copy_plan_execute(migration->plan, _dst, _src);
+		fill_zero_ranges(migration, _dst);
+		_dst += dst_stride;
+		_src += src_stride;
+	}
+	GLSL_INSTRUMENT_PADDING(get_zero_byte_count(migration) * count);
+}
+
+GLSLCOM_API void glsl_layout_migration_execute(const glsl_layout_migration_t* migration, void* dst, u32 dst_stride, const void* src, u32 src_stride, u64 count)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	migrate(migration, dst, dst_stride, src, src_stride, count);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_LAYOUT_MIGRATION, count * dst_stride);
+}
+
+static void migrate_in_place(const glsl_layout_migration_t* migration, void* data, u32 old_stride, u32 new_stride, u64 count)
+{
+	_ASSERT((new_stride >= migration->new_size) && (old_stride >= migration->old_size));
+	u8* _data = data;
+	if(old_stride == new_stride)
+	{
+		if(migration->is_identity)
+			return;
+		if(migration->is_in_place)
+		{
+			for(u64 i = 0; i < count; i++)
+			{
+				execute_ops_in_place(migration->plan, _data);
+				fill_zero_ranges(migration, _data);
+				_data += new_stride;
+			}
+			GLSL_INSTRUMENT_PADDING(get_zero_byte_count(migration) * count);
+			return;
+		}
+	}
+
+	/* each old instance is saved before its new instance overwrites it; growing instances are migrated from the last one down
+	 * and shrinking ones from the first one up, so a new instance never overwrites an old instance not yet saved */
+	u8* scratch = malloc(migration->old_size + 1);
+	if(scratch == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for a scratch instance of the layout migration");
+		return;
+	}
+	bool is_growing = new_stride > old_stride;
+	for(u64 i = 0; i < count; i++)
+	{
+		u64 index = is_growing ? (count - 1 - i) : i;
+		memcpy(scratch, _data + index * old_stride, migration->old_size);
+		u8* dst = _data + index * new_stride;
+		glsl_copy_plan_execute(migration->plan, dst, scratch);
+		fill_zero_ranges(migration, dst);
+	}
+	free(scratch);
+	GLSL_INSTRUMENT_PADDING(get_zero_byte_count(migration) * count);
+}
+
+GLSLCOM_API void glsl_layout_migration_execute_in_place(const glsl_layout_migration_t* migration, void* data, u32 old_stride, u32 new_stride, u64 count)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	migrate_in_place(migration, data, old_stride, new_stride, count);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_LAYOUT_MIGRATION, (migration->is_identity && (old_stride == new_stride)) ? 0 : (count * new_stride));
+}
@@ -0,0 +1,387 @@
+#include <glslcommon/glsl_layout_tree.h>
+#include <glslcommon/glsl_fingerprint.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memset, memcpy, strlen, strncmp */
+#include <stdint.h> /* UINT32_MAX */
+
+/* the whole tree (nodes, sorted child indices and names) lives in one memory block carved by the builder */
+typedef struct tree_builder_t
+{
+	glsl_memory_layout_t layout;
+	glsl_layout_node_t* next_node;
+	u32* next_index;
+	char* next_char;
+	/* scratch memory, freed once the tree is built */
+	u64* next_element_count;
+	glsl_type_layout_traits_t* next_traits;
+	glsl_member_layout_t* next_member;
+} tree_builder_t;
+
+/* validates the description and counts the nodes and name characters the tree will need */
+static bool count_struct(const glsl_struct_desc_t* desc, u32 depth, u32* node_count, u32* char_count)
+{
+	if(depth >= GLSL_LAYOUT_TREE_MAX_DEPTH)
+	{
+		debug_log_error("[GLSLCommon] Structs are nested deeper than GLSL_LAYOUT_TREE_MAX_DEPTH (or a struct contains itself)");
+		return false;
+	}
+	if((desc == NULL) || (desc->member_count == 0))
+	{
+		debug_log_error("[GLSLCommon] A struct must have at least one member");
+		return false;
+	}
+	for(u32 i = 0; i < desc->member_count; i++)
+	{
+		const glsl_member_desc_t* member = &desc->members[i];
+		if(member->array_dimension_count > GLSL_MAX_ARRAY_DIMENSIONS)
+		{
+			debug_log_error("[GLSLCommon] Member %s has more than GLSL_MAX_ARRAY_DIMENSIONS array dimensions", member->name);
+			return false;
+		}
+		for(u32 j = 0; j < member->array_dimension_count; j++)
+		{
+			if(member->array_lengths[j] == 0)
+			{
+				debug_log_error("[GLSLCommon] Array dimension %u of member %s has zero length", j, member->name);
+				return false;
+			}
+		}
+		*node_count += 1;
+		*char_count += (u32)strlen(member->name) + 1;
+		if(member->type == GLSL_TYPE_UNDEFINED)
+		{
+			if(!count_struct(member->struct_desc, depth + 1, node_count, char_count))
+				return false;
+		}
+	}
+	return true;
+}
+
+static const char* copy_name(tree_builder_t* builder, const char* name)
+{
+	u32 length = (u32)strlen(name) + 1;
+	char* copy = builder->next_char;
+	memcpy(copy, name, length);
+	builder->next_char += length;
+	return copy;
+}
+
+static s32 compare_names(const char* a, const char* b, u32 b_length)
+{
+	s32 result = strncmp(a, b, b_length);
+	if(result != 0)
+		return result;
+	/* 'b' is a prefix of 'a' (or equal to it) */
+	return (a[b_length] == 0) ? 0 : 1;
+}
+
+static inline u64 u64_round_next_multiple(u64 value, u64 multiple)
+{
+	return ((value + multiple - 1) / multiple) * multiple;
+}
+
+/* insertion sort, there is no portable qsort with a context (to reach the names), and this only runs once per struct */
+static void sort_children(const glsl_layout_node_t* children, u32* indices, u32 count)
+{
+	for(u32 i = 0; i < count; i++)
+		indices[i] = i;
+	for(u32 i = 1; i < count; i++)
+	{
+		u32 index = indices[i];
+		const char* name = children[index].name;
+		u32 j = i;
+		for(; (j > 0) && (strcmp(children[indices[j - 1]].name, name) > 0); j--)
+			indices[j] = indices[j - 1];
+		indices[j] = index;
+	}
+}
+
+/* builds the children of 'node' from 'desc', returns false if the struct (or any of its members) is larger than 4 GiB */
+static bool build_struct(tree_builder_t* builder, const glsl_struct_desc_t* desc, glsl_layout_node_t* node, glsl_struct_layout_t* out_layout, u64* out_fingerprint)
+{
+	u32 member_count = desc->member_count;
+	glsl_layout_node_t* children = builder->next_node;
+	builder->next_node += member_count;
+	u32* sorted_children = builder->next_index;
+	builder->next_index += member_count;
+	glsl_type_layout_traits_t* type_traits = builder->next_traits;
+	builder->next_traits += member_count;
+	glsl_member_layout_t* members = builder->next_member;
+	builder->next_member += member_count;
+
+	/* element counts of the members, the member layouts are computed for one element so that nothing below is done in u32 */
+	u64* element_counts = builder->next_element_count;
+	builder->next_element_count += member_count;
+
+	for(u32 i = 0; i < member_count; i++)
+	{
+		const glsl_member_desc_t* member = &desc->members[i];
+		glsl_layout_node_t* child = &children[i];
+		memset(child, 0, sizeof(glsl_layout_node_t));
+		child->name = copy_name(builder, member->name);
+		child->type = member->type;
+		child->is_row_major = member->is_row_major;
+		child->array_dimension_count = member->array_dimension_count;
+
+		/* an array of arrays is laid out exactly like a one dimensional array of all its elements */
+		u64 element_count = 1;
+		for(u32 j = 0; j < member->array_dimension_count; j++)
+		{
+			child->array_lengths[j] = member->array_lengths[j];
+			element_count *= member->array_lengths[j];
+			if(element_count > UINT32_MAX)
+			{
+				debug_log_error("[GLSLCommon] Member %s has more than 2^32 - 1 array elements", member->name);
+				return false;
+			}
+		}
+		element_counts[i] = element_count;
+
+		glsl_type_layout_traits_t* traits = &type_traits[i];
+		memset(traits, 0, sizeof(glsl_type_layout_traits_t));
+		traits->type = member->type;
+		traits->is_array = member->array_dimension_count > 0;
+		traits->array_length = 1;
+		traits->is_row_major = member->is_row_major;
+		if(member->type == GLSL_TYPE_UNDEFINED)
+		{
+			/* the fingerprint of the struct is kept in the child until it becomes that of the member */
+			glsl_struct_layout_t struct_layout;
+			if(!build_struct(builder, member->struct_desc, child, &struct_layout, &child->fingerprint))
+				return false;
+			traits->align = struct_layout.align;
+			traits->size = struct_layout.size;
+			child->element_size = struct_layout.size;
+		}
+		else
+			child->element_size = sizeof_glsl_type(layout_typeof_glsl_type(member->type, member->is_row_major), builder->layout);
+	}
+
+	/* the alignments and array strides don't depend on the array lengths, the offsets and sizes are accumulated in u64 below */
+	glsl_struct_layout_t struct_layout = layoutof_glsl_type_struct(type_traits, member_count, builder->layout, members);
+
+	u64 offset = 0;
+	u64 fingerprint = glsl_fingerprint_struct_begin(builder->layout, member_count);
+	for(u32 i = 0; i < member_count; i++)
+	{
+		glsl_layout_node_t* child = &children[i];
+		u64 size = (child->array_dimension_count > 0) ? ((u64)members[i].array_stride * element_counts[i]) : members[i].size;
+		offset = u64_round_next_multiple(offset, members[i].align);
+		if((size > UINT32_MAX) || ((offset + size) > UINT32_MAX))
+		{
+			debug_log_error("[GLSLCommon] Member %s ends beyond 4 GiB, sizes and offsets must fit in 32 bits", child->name);
+			return false;
+		}
+		child->offset = (u32)offset;
+		child->align = members[i].align;
+		child->size = (u32)size;
+		offset += size;
+		/* the innermost dimension steps by the array stride, every outer one by the size of the whole inner array */
+		u32 dimension_count = child->array_dimension_count;
+		if(dimension_count > 0)
+		{
+			child->array_strides[dimension_count - 1] = members[i].array_stride;
+			for(u32 j = dimension_count - 1; j > 0; j--)
+				child->array_strides[j - 1] = child->array_strides[j] * child->array_lengths[j];
+		}
+		child->fingerprint = glsl_fingerprint_member(child->type, child->is_row_major, child->fingerprint, child->size, dimension_count, child->array_lengths, child->array_strides);
+		fingerprint = glsl_fingerprint_struct_add(fingerprint, child->offset, child->fingerprint);
+	}
+	u64 struct_size = u64_round_next_multiple(offset, struct_layout.align);
+	if(struct_size > UINT32_MAX)
+	{
+		debug_log_error("[GLSLCommon] Struct %s is larger than 4 GiB, sizes and offsets must fit in 32 bits", (desc->name == NULL) ? "" : desc->name);
+		return false;
+	}
+	struct_layout.size = (u32)struct_size;
+	struct_layout.array_stride = (u32)struct_size;
+	*out_fingerprint = glsl_fingerprint_struct_end(fingerprint, struct_layout.align, struct_layout.size);
+
+	sort_children(children, sorted_children, member_count);
+	node->child_count = member_count;
+	node->children = children;
+	node->sorted_children = sorted_children;
+	*out_layout = struct_layout;
+	return true;
+}
+
+static glsl_layout_tree_t* tree_create(const glsl_struct_desc_t* block_desc, glsl_memory_layout_t layout, const glsl_allocator_t* allocator)
+{
+	u32 node_count = 0;
+	u32 char_count = 0;
+	if(!count_struct(block_desc, 0, &node_count, &char_count))
+		return NULL;
+	const char* block_name = (block_desc->name == NULL) ? "" : block_desc->name;
+	char_count += (u32)strlen(block_name) + 1;
+
+	glsl_layout_tree_t* tree = glsl_allocator_alloc_object(allocator, sizeof(glsl_layout_tree_t) + (sizeof(glsl_layout_node_t) + sizeof(u32)) * node_count + char_count);
+	if(tree == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_layout_tree_t");
+		return NULL;
+	}
+	/* the inputs and outputs of layoutof_glsl_type_struct() for every struct, one slice per struct just like the nodes */
+	void* scratch = malloc((sizeof(u64) + sizeof(glsl_type_layout_traits_t) + sizeof(glsl_member_layout_t)) * node_count);
+	if(scratch == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_type_layout_traits_t");
+		glsl_allocator_free_object(tree);
+		return NULL;
+	}
+
+	tree_builder_t builder;
+	builder.layout = layout;
+	builder.next_node = (glsl_layout_node_t*)(tree + 1);
+	builder.next_index = (u32*)(builder.next_node + node_count);
+	builder.next_char = (char*)(builder.next_index + node_count);
+	builder.next_element_count = (u64*)scratch;
+	builder.next_traits = (glsl_type_layout_traits_t*)(builder.next_element_count + node_count);
+	builder.next_member = (glsl_member_layout_t*)(builder.next_traits + node_count);
+
+	tree->layout = layout;
+	glsl_layout_node_t* root = &tree->root;
+	memset(root, 0, sizeof(glsl_layout_node_t));
+	root->name = copy_name(&builder, block_name);
+	root->type = GLSL_TYPE_UNDEFINED;
+	glsl_struct_layout_t struct_layout;
+	bool is_built = build_struct(&builder, block_desc, root, &struct_layout, &root->fingerprint);
+	free(scratch);
+	if(!is_built)
+	{
+		glsl_allocator_free_object(tree);
+		return NULL;
+	}
+	root->align = struct_layout.align;
+	root->size = struct_layout.size;
+	root->element_size = struct_layout.size;
+	_ASSERT(builder.next_char == ((char*)(builder.next_index) + char_count));
+	return tree;
+}
+
+GLSLCOM_API glsl_layout_tree_t* glsl_layout_tree_create(const glsl_struct_desc_t* block_desc, glsl_memory_layout_t layout, const glsl_allocator_t* allocator)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	glsl_layout_tree_t* tree = tree_create(block_desc, layout, allocator);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_LAYOUT_TREE_CREATE, 0);
+	return tree;
+}
+
+GLSLCOM_API void glsl_layout_tree_destroy(glsl_layout_tree_t* tree)
+{
+	glsl_allocator_free_object(tree);
+}
+
+GLSLCOM_API const glsl_layout_node_t* glsl_layout_node_find_child(const glsl_layout_node_t* node, const char* name, u32 name_length)
+{
+	u32 low = 0;
+	u32 high = node->child_count;
+	while(low < high)
+	{
+		u32 mid = low + ((high - low) >> 1);
+		const glsl_layout_node_t* child = &node->children[node->sorted_children[mid]];
+		s32 result = compare_names(child->name, name, name_length);
+		if(result == 0)
+			return child;
+		if(result < 0)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return NULL;
+}
+
+static bool is_name_char(char c)
+{
+	return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9')) || (c == '_');
+}
+
+/* walks 'path' down the tree, "[]" (a runtime index) is only accepted if 'out_accessor->strides' is to be filled, i.e. 'allow_runtime_indices' is true */
+static bool resolve_path(const glsl_layout_tree_t* tree, const char* path, bool allow_runtime_indices, glsl_layout_accessor_t* out_accessor)
+{
+	const glsl_layout_node_t* node = &tree->root;
+	u32 offset = 0;
+	u32 indexed_dimension_count = 0;
+	u32 index_count = 0;
+	const char* ptr = path;
+	for(;;)
+	{
+		/* members of an array can only be accessed after indexing all of its dimensions */
+		if(indexed_dimension_count != node->array_dimension_count)
+			return false;
+
+		const char* name = ptr;
+		while(is_name_char(*ptr))
+			ptr++;
+		const glsl_layout_node_t* child = (ptr == name) ? NULL : glsl_layout_node_find_child(node, name, (u32)(ptr - name));
+		if(child == NULL)
+			return false;
+		node = child;
+		offset += node->offset;
+		indexed_dimension_count = 0;
+
+		while(*ptr == '[')
+		{
+			ptr++;
+			if(indexed_dimension_count == node->array_dimension_count)
+				return false;
+			u32 length = node->array_lengths[indexed_dimension_count];
+			u32 stride = node->array_strides[indexed_dimension_count];
+			if(*ptr == ']')
+			{
+				if(!allow_runtime_indices || (index_count == GLSL_LAYOUT_ACCESSOR_MAX_INDICES))
+					return false;
+				out_accessor->strides[index_count] = stride;
+				out_accessor->lengths[index_count] = length;
+				index_count++;
+			}
+			else
+			{
+				u32 index = 0;
+				const char* digits = ptr;
+				for(; (*ptr >= '0') && (*ptr <= '9'); ptr++)
+				{
+					index = index * 10 + (u32)(*ptr - '0');
+					if(index >= length)
+						return false;
+				}
+				if((ptr == digits) || (*ptr != ']'))
+					return false;
+				offset += index * stride;
+			}
+			ptr++;
+			indexed_dimension_count++;
+		}
+
+		if(*ptr == 0)
+			break;
+		if(*ptr != '.')
+			return false;
+		ptr++;
+	}
+
+	out_accessor->node = node;
+	out_accessor->base_offset = offset;
+	out_accessor->indexed_dimension_count = indexed_dimension_count;
+	out_accessor->index_count = index_count;
+	return true;
+}
+
+GLSLCOM_API bool glsl_layout_tree_resolve(const glsl_layout_tree_t* tree, const char* path, glsl_layout_location_t* out_location)
+{
+	glsl_layout_accessor_t accessor;
+	if(!resolve_path(tree, path, false, &accessor))
+		return false;
+	out_location->node = accessor.node;
+	out_location->offset = accessor.base_offset;
+	out_location->indexed_dimension_count = accessor.indexed_dimension_count;
+	return true;
+}
+
+GLSLCOM_API bool glsl_layout_tree_get_accessor(const glsl_layout_tree_t* tree, const char* path, glsl_layout_accessor_t* out_accessor)
+{
+	return resolve_path(tree, path, true, out_accessor);
+}
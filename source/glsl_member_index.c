@@ -0,0 +1,426 @@
+#include <glslcommon/glsl_member_index.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdlib.h> /* malloc, calloc, free */
+#include <string.h> /* memcpy, memset, strlen, strncmp */
+
+/* keys are spread over (count / GLSL_MEMBER_INDEX_BUCKET_LOAD) buckets, each bucket stores one displacement */
+#define GLSL_MEMBER_INDEX_BUCKET_LOAD 2
+/* a bucket whose keys can't be placed with this many displacements fails the build, which needs an astronomically unlucky key set */
+#define GLSL_MEMBER_INDEX_MAX_DISPLACEMENT (1u << 20)
+
+struct glsl_member_index_t
+{
+	u32 count;
+	u32 bucket_count;
+	const u32* displacements;
+	/* entries are stored at their hash slot */
+	const glsl_member_index_entry_t* entries;
+};
+
+/* splitmix64 finalizer */
+static u64 mix_u64(u64 x)
+{
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ull;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebull;
+	x ^= x >> 31;
+	return x;
+}
+
+GLSLCOM_API u64 glsl_member_index_hash(const char* name, u32 name_length)
+{
+	/* FNV-1a */
+	u64 hash = 0xcbf29ce484222325ull;
+	for(u32 i = 0; i < name_length; i++)
+	{
+		hash ^= (u8)name[i];
+		hash *= 0x100000001b3ull;
+	}
+	return mix_u64(hash);
+}
+
+static inline u32 get_bucket(u64 hash, u32 bucket_count)
+{
+	return (u32)((hash >> 32) % bucket_count);
+}
+
+static inline u32 get_slot(u64 hash, u32 displacement, u32 count)
+{
+	return (u32)(mix_u64(hash + displacement * 0x9e3779b97f4a7c15ull) % count);
+}
+
+/* the index is allocated as one memory block: header, displacements, entries and then the names */
+static glsl_member_index_t* index_alloc(u32 count, u32 char_count, const glsl_allocator_t* allocator)
+{
+	u32 bucket_count = (count + GLSL_MEMBER_INDEX_BUCKET_LOAD - 1) / GLSL_MEMBER_INDEX_BUCKET_LOAD;
+	if(bucket_count == 0)
+		bucket_count = 1;
+	u32 displacements_size = (u32)U32_NEXT_MULTIPLE(sizeof(u32) * bucket_count, sizeof(u64));
+	u64 size = sizeof(glsl_member_index_t) + displacements_size + sizeof(glsl_member_index_entry_t) * count + char_count;
+	glsl_member_index_t* index = glsl_allocator_alloc_object(allocator, size);
+	if(index == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_member_index_t");
+		return NULL;
+	}
+	memset(index, 0, size);
+	index->count = count;
+	index->bucket_count = bucket_count;
+	index->displacements = (u32*)(index + 1);
+	index->entries = (glsl_member_index_entry_t*)((u8*)(index + 1) + displacements_size);
+	return index;
+}
+
+static char* index_get_names(glsl_member_index_t* index)
+{
+	return (char*)(index->entries + index->count);
+}
+
+/* finds a displacement for every bucket (largest buckets first) such that all keys land in distinct slots,
+ * then moves every entry of 'keys' into its slot; returns false if two keys have the same hash */
+static bool index_build(glsl_member_index_t* index, const glsl_member_index_entry_t* keys)
+{
+	u32 count = index->count;
+	u32 bucket_count = index->bucket_count;
+	/* bucket_starts[b] .. bucket_starts[b + 1] is the range of 'bucket_keys' which hash into bucket 'b' */
+	u32* bucket_starts = calloc((bucket_count + 1) * 2 + count * 2, sizeof(u32));
+	bool* is_slot_taken = calloc(count, sizeof(bool));
+	if((bucket_starts == NULL) || (is_slot_taken == NULL))
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the member index build");
+		return false;
+	}
+	u32* bucket_order = bucket_starts + bucket_count + 1;
+	u32* bucket_keys = bucket_order + bucket_count + 1;
+	u32* bucket_slots = bucket_keys + count;
+	u32* displacements = (u32*)index->displacements;
+	glsl_member_index_entry_t* entries = (glsl_member_index_entry_t*)index->entries;
+
+	for(u32 i = 0; i < count; i++)
+		bucket_starts[get_bucket(keys[i].hash, bucket_count) + 1]++;
+	u32 max_bucket_size = 0;
+	for(u32 i = 0; i < bucket_count; i++)
+	{
+		if(max_bucket_size < bucket_starts[i + 1])
+			max_bucket_size = bucket_starts[i + 1];
+		bucket_starts[i + 1] += bucket_starts[i];
+	}
+	/* bucket_order temporarily holds the fill cursor of each bucket */
+	memcpy(bucket_order, bucket_starts, sizeof(u32) * bucket_count);
+	for(u32 i = 0; i < count; i++)
+		bucket_keys[bucket_order[get_bucket(keys[i].hash, bucket_count)]++] = i;
+
+	/* buckets sorted by size (largest first), bucket sizes are tiny so this is a counting sort by size */
+	u32 order_count = 0;
+	for(u32 size = max_bucket_size; size > 0; size--)
+		for(u32 i = 0; i < bucket_count; i++)
+			if((bucket_starts[i + 1] - bucket_starts[i]) == size)
+				bucket_order[order_count++] = i;
+
+	bool is_success = true;
+	for(u32 i = 0; (i < order_count) && is_success; i++)
+	{
+		u32 bucket = bucket_order[i];
+		u32 start = bucket_starts[bucket];
+		u32 size = bucket_starts[bucket + 1] - start;
+		for(u32 j = 0; j < size; j++)
+		{
+			for(u32 k = 0; k < j; k++)
+			{
+				if(keys[bucket_keys[start + j]].hash == keys[bucket_keys[start + k]].hash)
+				{
+					debug_log_error("[GLSLCommon] Member %s is indexed twice (or its hash collides with %s)", keys[bucket_keys[start + j]].name, keys[bucket_keys[start + k]].name);
+					is_success = false;
+				}
+			}
+		}
+
+		u32 displacement = 0;
+		for(; is_success && (displacement < GLSL_MEMBER_INDEX_MAX_DISPLACEMENT); displacement++)
+		{
+			u32 placed_count = 0;
+			for(; placed_count < size; placed_count++)
+			{
+				u32 slot = get_slot(keys[bucket_keys[start + placed_count]].hash, displacement, count);
+				if(is_slot_taken[slot])
+					break;
+				is_slot_taken[slot] = true;
+				bucket_slots[placed_count] = slot;
+			}
+			if(placed_count == size)
+				break;
+			/* undo the partial placement and try the next displacement */
+			for(u32 j = 0; j < placed_count; j++)
+				is_slot_taken[bucket_slots[j]] = false;
+		}
+		if(displacement == GLSL_MEMBER_INDEX_MAX_DISPLACEMENT)
+		{
+			debug_log_error("[GLSLCommon] Failed to find a perfect hash for the member names");
+			is_success = false;
+		}
+		if(!is_success)
+			break;
+		displacements[bucket] = displacement;
+		for(u32 j = 0; j < size; j++)
+			entries[bucket_slots[j]] = keys[bucket_keys[start + j]];
+	}
+
+	free(is_slot_taken);
+	free(bucket_starts);
+	return is_success;
+}
+
+GLSLCOM_API glsl_member_index_t* glsl_member_index_create(const char* const* names, const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, u32 member_count, const glsl_allocator_t* allocator)
+{
+	u32 char_count = 0;
+	for(u32 i = 0; i < member_count; i++)
+		char_count += (u32)strlen(names[i]) + 1;
+
+	glsl_member_index_t* index = index_alloc(member_count, char_count, allocator);
+	glsl_member_index_entry_t* keys = malloc(sizeof(glsl_member_index_entry_t) * member_count + 1);
+	if((index == NULL) || (keys == NULL))
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_member_index_t");
+		return NULL;
+	}
+
+	char* name = index_get_names(index);
+	for(u32 i = 0; i < member_count; i++)
+	{
+		u32 name_length = (u32)strlen(names[i]);
+		memcpy(name, names[i], name_length + 1);
+		glsl_member_index_entry_t* key = &keys[i];
+		key->name = name;
+		key->hash = glsl_member_index_hash(name, name_length);
+		key->type = type_traits[i].type;
+		key->is_row_major = type_traits[i].is_row_major;
+		key->offset = members[i].offset;
+		key->size = members[i].size;
+		key->array_length = type_traits[i].is_array ? ((type_traits[i].array_length == 0) ? 1 : type_traits[i].array_length) : 0;
+		key->array_stride = members[i].array_stride;
+		name += name_length + 1;
+	}
+
+	bool is_success = index_build(index, keys);
+	free(keys);
+	if(!is_success)
+	{
+		glsl_allocator_free_object(index);
+		return NULL;
+	}
+	return index;
+}
+
+/* the tree is walked twice: first only counting entries and name characters ('keys' is NULL), then filling 'keys' */
+typedef struct tree_walker_t
+{
+	char path[GLSL_MEMBER_INDEX_MAX_PATH_LENGTH];
+	glsl_member_index_entry_t* keys;
+	char* next_char;
+	u32 key_count;
+	u32 char_count;
+} tree_walker_t;
+
+static bool walk_node(tree_walker_t* walker, const glsl_layout_node_t* node, u32 offset, u32 path_length, u32 indexed_dimension_count, u64 outer_array_hash);
+
+static bool walk_children(tree_walker_t* walker, const glsl_layout_node_t* node, u32 offset, u32 path_length, u64 outer_array_hash)
+{
+	/* members of the block itself have no prefix */
+	if(path_length > 0)
+	{
+		if((path_length + 1) >= GLSL_MEMBER_INDEX_MAX_PATH_LENGTH)
+			return false;
+		walker->path[path_length++] = '.';
+	}
+	for(u32 i = 0; i < node->child_count; i++)
+	{
+		const glsl_layout_node_t* child = &node->children[i];
+		u32 name_length = (u32)strlen(child->name);
+		if((path_length + name_length) >= GLSL_MEMBER_INDEX_MAX_PATH_LENGTH)
+			return false;
+		memcpy(walker->path + path_length, child->name, name_length);
+		if(!walk_node(walker, child, offset + child->offset, path_length + name_length, 0, outer_array_hash))
+			return false;
+	}
+	return true;
+}
+
+static bool walk_node(tree_walker_t* walker, const glsl_layout_node_t* node, u32 offset, u32 path_length, u32 indexed_dimension_count, u64 outer_array_hash)
+{
+	/* a (partially indexed) member or array element */
+	walker->path[path_length] = 0;
+	u64 hash = 0;
+	if(walker->keys != NULL)
+	{
+		glsl_member_index_entry_t* key = &walker->keys[walker->key_count];
+		memcpy(walker->next_char, walker->path, path_length + 1);
+		hash = glsl_member_index_hash(walker->path, path_length);
+		key->name = walker->next_char;
+		key->hash = hash;
+		key->type = node->type;
+		key->is_row_major = node->is_row_major;
+		key->outer_array_hash = outer_array_hash;
+		key->offset = offset;
+		if(indexed_dimension_count < node->array_dimension_count)
+		{
+			key->array_length = node->array_lengths[indexed_dimension_count];
+			key->array_stride = node->array_strides[indexed_dimension_count];
+			key->size = key->array_length * key->array_stride;
+		}
+		else
+		{
+			key->array_length = 0;
+			key->array_stride = 0;
+			key->size = node->element_size;
+		}
+		walker->next_char += path_length + 1;
+	}
+	walker->key_count++;
+	walker->char_count += path_length + 1;
+
+	if(node->type != GLSL_TYPE_UNDEFINED)
+		return true;
+	/* the elements of a struct array are indexed once, as "[]" at the offset of element 0, the entry just made holds the length and stride of the dimension */
+	if(indexed_dimension_count < node->array_dimension_count)
+	{
+		if((path_length + 2) >= GLSL_MEMBER_INDEX_MAX_PATH_LENGTH)
+			return false;
+		walker->path[path_length] = '[';
+		walker->path[path_length + 1] = ']';
+		return walk_node(walker, node, offset, path_length + 2, indexed_dimension_count + 1, hash);
+	}
+	return walk_children(walker, node, offset, path_length, outer_array_hash);
+}
+
+GLSLCOM_API glsl_member_index_t* glsl_member_index_create_from_tree(const glsl_layout_tree_t* tree, const glsl_allocator_t* allocator)
+{
+	tree_walker_t walker = { 0 };
+	/* the root (the block itself) isn't indexed, paths start at its members */
+	if(!walk_children(&walker, &tree->root, 0, 0, 0))
+	{
+		debug_log_error("[GLSLCommon] A member path of block %s is longer than GLSL_MEMBER_INDEX_MAX_PATH_LENGTH", tree->root.name);
+		return NULL;
+	}
+
+	u32 key_count = walker.key_count;
+	glsl_member_index_t* index = index_alloc(key_count, walker.char_count, allocator);
+	glsl_member_index_entry_t* keys = malloc(sizeof(glsl_member_index_entry_t) * key_count + 1);
+	if((index == NULL) || (keys == NULL))
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_member_index_t");
+		return NULL;
+	}
+	walker.keys = keys;
+	walker.next_char = index_get_names(index);
+	walker.key_count = 0;
+	walker.char_count = 0;
+	walk_children(&walker, &tree->root, 0, 0, 0);
+	_ASSERT(walker.key_count == key_count);
+
+	bool is_success = index_build(index, keys);
+	free(keys);
+	if(!is_success)
+	{
+		glsl_allocator_free_object(index);
+		return NULL;
+	}
+	return index;
+}
+
+GLSLCOM_API void glsl_member_index_destroy(glsl_member_index_t* index)
+{
+	glsl_allocator_free_object(index);
+}
+
+GLSLCOM_API u32 glsl_member_index_get_count(const glsl_member_index_t* index)
+{
+	return index->count;
+}
+
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_get_entries(const glsl_member_index_t* index)
+{
+	return index->entries;
+}
+
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_find_prehashed(const glsl_member_index_t* index, u64 hash)
+{
+	if(index->count == 0)
+		return NULL;
+	u32 displacement = index->displacements[get_bucket(hash, index->bucket_count)];
+	const glsl_member_index_entry_t* entry = &index->entries[get_slot(hash, displacement, index->count)];
+	return (entry->hash == hash) ? entry : NULL;
+}
+
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_find_n(const glsl_member_index_t* index, const char* name, u32 name_length)
+{
+	const glsl_member_index_entry_t* entry = glsl_member_index_find_prehashed(index, glsl_member_index_hash(name, name_length));
+	if((entry == NULL) || (strncmp(entry->name, name, name_length) != 0) || (entry->name[name_length] != 0))
+		return NULL;
+	return entry;
+}
+
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_find(const glsl_member_index_t* index, const char* name)
+{
+	return glsl_member_index_find_n(index, name, (u32)strlen(name));
+}
+
+GLSLCOM_API bool glsl_member_index_split_path(const char* path, char* out_path, u32* out_path_length, u32* out_indices, u32* out_index_count)
+{
+	u32 length = 0;
+	u32 index_count = 0;
+	for(const char* ptr = path; *ptr != 0; ptr++)
+	{
+		if((length + 1) >= GLSL_MEMBER_INDEX_MAX_PATH_LENGTH)
+			return false;
+		out_path[length++] = *ptr;
+		if(*ptr != '[')
+			continue;
+		if((ptr[1] < '0') || (ptr[1] > '9') || (index_count == GLSL_MEMBER_INDEX_MAX_INDICES))
+			return false;
+		u64 value = 0;
+		for(ptr++; (*ptr >= '0') && (*ptr <= '9'); ptr++)
+		{
+			value = value * 10 + (u64)(*ptr - '0');
+			if(value > 0xffffffffull)
+				return false;
+		}
+		if(*ptr != ']')
+			return false;
+		out_indices[index_count++] = (u32)value;
+		/* the ']' is copied by the next iteration */
+		ptr--;
+	}
+	out_path[length] = 0;
+	*out_path_length = length;
+	*out_index_count = index_count;
+	return true;
+}
+
+GLSLCOM_API const glsl_member_index_entry_t* glsl_member_index_resolve(const glsl_member_index_t* index, const char* path, u32* out_offset)
+{
+	char normalized_path[GLSL_MEMBER_INDEX_MAX_PATH_LENGTH];
+	u32 indices[GLSL_MEMBER_INDEX_MAX_INDICES];
+	u32 path_length;
+	u32 index_count;
+	if(!glsl_member_index_split_path(path, normalized_path, &path_length, indices, &index_count))
+		return NULL;
+	const glsl_member_index_entry_t* entry = glsl_member_index_find_n(index, normalized_path, path_length);
+	if(entry == NULL)
+		return NULL;
+	/* one multiply-add per index, innermost first, each "[]" links to the entry of the array it indexes */
+	u32 offset = entry->offset;
+	u64 outer_array_hash = entry->outer_array_hash;
+	for(u32 i = index_count; i > 0; i--)
+	{
+		const glsl_member_index_entry_t* array = (outer_array_hash == 0) ? NULL : glsl_member_index_find_prehashed(index, outer_array_hash);
+		if((array == NULL) || (indices[i - 1] >= array->array_length))
+			return NULL;
+		offset += indices[i - 1] * array->array_stride;
+		outer_array_hash = array->outer_array_hash;
+	}
+	*out_offset = offset;
+	return entry;
+}
@@ -0,0 +1,116 @@
+#include <glslcommon/glsl_member_order.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdlib.h> /* malloc, free */
+
+/* a run of members with the same alignment in the sorted member list, 'cursor' is the next one to place */
+typedef struct align_bucket_t
+{
+	u32 align;
+	u32 cursor;
+	u32 end;
+} align_bucket_t;
+
+/* padded size of the struct if its members are placed in 'order' */
+static u32 get_ordered_size(const glsl_member_layout_t* members, const u32* order, u32 count, u32 struct_align)
+{
+	u32 offset = 0;
+	for(u32 i = 0; i < count; i++)
+		offset = u32_round_next_multiple(offset, members[order[i]].align) + members[order[i]].size;
+	return u32_round_next_multiple(offset, struct_align);
+}
+
+GLSLCOM_API glsl_struct_layout_t glsl_optimize_member_order(const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout, u32* out_order, u32* out_remap)
+{
+	_ASSERT(type_traits_count > 0);
+	u32 count = type_traits_count;
+
+	/* alignment and size of a member don't depend on its position, so the declared layout provides them for every order */
+	glsl_member_layout_t* members = malloc(sizeof(glsl_member_layout_t) * count + sizeof(u32) * count * 2 + sizeof(align_bucket_t) * count);
+	if(members == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for member order");
+		return (glsl_struct_layout_t) { 0 };
+	}
+	u32* sorted = (u32*)(members + count);
+	u32* greedy = sorted + count;
+	align_bucket_t* buckets = (align_bucket_t*)(greedy + count);
+	glsl_struct_layout_t struct_layout = layoutof_glsl_type_struct(type_traits, count, layout, members);
+
+	/* one bucket per distinct alignment (there are only a handful of them), sorted by descending alignment */
+	u32 bucket_count = 0;
+	for(u32 i = 0; i < count; i++)
+	{
+		u32 j = 0;
+		while((j < bucket_count) && (buckets[j].align != members[i].align))
+			j++;
+		if(j == bucket_count)
+		{
+			for(j = bucket_count++; (j > 0) && (buckets[j - 1].align < members[i].align); j--)
+				buckets[j] = buckets[j - 1];
+			buckets[j] = (align_bucket_t) { members[i].align, 0, 0 };
+		}
+		buckets[j].end++;
+	}
+	/* members sorted by descending alignment, stable (counting sort over the buckets) */
+	for(u32 i = 0, begin = 0; i < bucket_count; i++)
+	{
+		buckets[i].cursor = begin;
+		begin += buckets[i].end;
+		buckets[i].end = buckets[i].cursor;
+	}
+	for(u32 i = 0; i < count; i++)
+	{
+		u32 j = 0;
+		while(buckets[j].align != members[i].align)
+			j++;
+		sorted[buckets[j].end++] = i;
+	}
+
+	/* at each step the first bucket (the most aligned one) needing no padding wins, otherwise the one needing the least */
+	u32 offset = 0;
+	for(u32 i = 0; i < count; i++)
+	{
+		u32 best = ~0u;
+		u32 best_padding = ~0u;
+		for(u32 j = 0; j < bucket_count; j++)
+		{
+			if(buckets[j].cursor == buckets[j].end)
+				continue;
+			u32 padding = u32_round_next_multiple(offset, buckets[j].align) - offset;
+			if(padding < best_padding)
+			{
+				best = j;
+				best_padding = padding;
+				if(padding == 0)
+					break;
+			}
+		}
+		_ASSERT(best != ~0u);
+		u32 member = sorted[buckets[best].cursor++];
+		greedy[i] = member;
+		offset += best_padding + members[member].size;
+	}
+
+	/* the greedy placement is usually the smallest, but falls back to the plain sorted order or the declared order whenever those are as small */
+	u32 greedy_size = u32_round_next_multiple(offset, struct_layout.align);
+	u32 sorted_size = get_ordered_size(members, sorted, count, struct_layout.align);
+	const u32* order = NULL;
+	if((struct_layout.size > greedy_size) || (struct_layout.size > sorted_size))
+	{
+		order = (sorted_size <= greedy_size) ? sorted : greedy;
+		struct_layout.size = (sorted_size <= greedy_size) ? sorted_size : greedy_size;
+		struct_layout.array_stride = struct_layout.size;
+	}
+
+	for(u32 i = 0; i < count; i++)
+	{
+		u32 member = (order == NULL) ? i : order[i];
+		out_order[i] = member;
+		if(out_remap != NULL)
+			out_remap[member] = i;
+	}
+	free(members);
+	return struct_layout;
+}
@@ -0,0 +1,455 @@
+#include <glslcommon/glsl_pack.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <string.h> /* memcpy, memset */
+
+#if defined(__SSE2__) || defined(_M_X64)
+#	define GLSLCOM_PACK_SSE2
+#	include <emmintrin.h>
+#endif
+
+/* AVX2 kernels are compiled with a per-function target attribute and selected at runtime,
+ * so the library itself can still be built for (and run on) baseline x86-64 */
+#if defined(GLSLCOM_PACK_SSE2) && defined(__GNUC__)
+#	define GLSLCOM_PACK_AVX2
+#	include <immintrin.h>
+#	define GLSLCOM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static void pack_strided_generic(u8* dst, u32 dst_stride, const u8* src, u32 element_size, u32 count)
+{
+	for(u32 i = 0; i < count; i++)
+	{
+		memcpy(dst, src, element_size);
+		memset(dst + element_size, 0, dst_stride - element_size);
+		dst += dst_stride;
+		src += element_size;
+	}
+}
+
+#ifdef GLSLCOM_PACK_SSE2
+/* float[] --> 16 byte stride */
+static void pack_4_to_16_sse2(u8* dst, const u8* src, u32 count)
+{
+	const __m128 zero = _mm_setzero_ps();
+	u32 i = 0;
+	for(; (i + 4) <= count; i += 4)
+	{
+		__m128 v = _mm_loadu_ps((const float*)(src + i * 4));
+		_mm_storeu_ps((float*)(dst + (i + 0) * 16), _mm_move_ss(zero, v));
+		_mm_storeu_ps((float*)(dst + (i + 1) * 16), _mm_move_ss(zero, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+		_mm_storeu_ps((float*)(dst + (i + 2) * 16), _mm_move_ss(zero, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+		_mm_storeu_ps((float*)(dst + (i + 3) * 16), _mm_move_ss(zero, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+	}
+	for(; i < count; i++)
+		_mm_storeu_ps((float*)(dst + i * 16), _mm_load_ss((const float*)(src + i * 4)));
+}
+
+/* vec2[] (and mat2 columns) --> 16 byte stride */
+static void pack_8_to_16_sse2(u8* dst, const u8* src, u32 count)
+{
+	for(u32 i = 0; i < count; i++)
+		_mm_storeu_si128((__m128i*)(dst + i * 16), _mm_loadl_epi64((const __m128i*)(src + i * 8)));
+}
+
+/* vec3[] (and mat3 columns) --> vec4 slots */
+static void pack_12_to_16_sse2(u8* dst, const u8* src, u32 count)
+{
+	const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	u32 i = 0;
+	for(; (i + 4) <= count; i += 4)
+	{
+		const float* s = (const float*)(src + i * 12);
+		__m128 v0 = _mm_loadu_ps(s);		/* x0 y0 z0 x1 */
+		__m128 v1 = _mm_loadu_ps(s + 4);	/* y1 z1 x2 y2 */
+		__m128 v2 = _mm_loadu_ps(s + 8);	/* z2 x3 y3 z3 */
+		__m128 t = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 3, 3)); /* x1 x1 y1 z1 */
+		_mm_storeu_ps((float*)(dst + (i + 0) * 16), _mm_and_ps(v0, mask));
+		_mm_storeu_ps((float*)(dst + (i + 1) * 16), _mm_and_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 3, 2, 1)), mask));
+		_mm_storeu_ps((float*)(dst + (i + 2) * 16), _mm_and_ps(_mm_shuffle_ps(v1, v2, _MM_SHUFFLE(0, 0, 3, 2)), mask));
+		_mm_storeu_ps((float*)(dst + (i + 3) * 16), _mm_and_ps(_mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 2, 1)), mask));
+	}
+	/* a 16 byte load of the last elements would read past the end of 'src' */
+	pack_strided_generic(dst + i * 16, 16, src + i * 12, 12, count - i);
+}
+
+/* 16 byte stride --> float[] */
+static void unpack_16_to_4_sse2(u8* dst, const u8* src, u32 count)
+{
+	u32 i = 0;
+	/* the last element is left to the scalar loop, as a 16 byte load of it may read past the end of 'src' */
+	for(; (i + 4) < count; i += 4)
+	{
+		__m128 ab = _mm_unpacklo_ps(_mm_loadu_ps((const float*)(src + (i + 0) * 16)), _mm_loadu_ps((const float*)(src + (i + 1) * 16)));
+		__m128 cd = _mm_unpacklo_ps(_mm_loadu_ps((const float*)(src + (i + 2) * 16)), _mm_loadu_ps((const float*)(src + (i + 3) * 16)));
+		_mm_storeu_ps((float*)(dst + i * 4), _mm_movelh_ps(ab, cd));
+	}
+	for(; i < count; i++)
+		memcpy(dst + i * 4, src + i * 16, 4);
+}
+
+/* 16 byte stride --> vec2[] */
+static void unpack_16_to_8_sse2(u8* dst, const u8* src, u32 count)
+{
+	u32 i = 0;
+	for(; (i + 2) < count; i += 2)
+	{
+		__m128d a = _mm_load_sd((const double*)(src + (i + 0) * 16));
+		__m128d b = _mm_load_sd((const double*)(src + (i + 1) * 16));
+		_mm_storeu_pd((double*)(dst + i * 8), _mm_unpacklo_pd(a, b));
+	}
+	for(; i < count; i++)
+		memcpy(dst + i * 8, src + i * 16, 8);
+}
+
+/* vec4 slots --> vec3[] */
+static void unpack_16_to_12_sse2(u8* dst, const u8* src, u32 count)
+{
+	u32 i = 0;
+	for(; (i + 4) < count; i += 4)
+	{
+		__m128 a = _mm_loadu_ps((const float*)(src + (i + 0) * 16));
+		__m128 b = _mm_loadu_ps((const float*)(src + (i + 1) * 16));
+		__m128 c = _mm_loadu_ps((const float*)(src + (i + 2) * 16));
+		__m128 d = _mm_loadu_ps((const float*)(src + (i + 3) * 16));
+		__m128 t0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 2, 2)); /* z0 z0 x1 x1 */
+		__m128 t1 = _mm_shuffle_ps(c, d, _MM_SHUFFLE(0, 0, 2, 2)); /* z2 z2 x3 x3 */
+		float* _dst = (float*)(dst + i * 12);
+		_mm_storeu_ps(_dst, _mm_shuffle_ps(a, t0, _MM_SHUFFLE(2, 0, 1, 0)));		/* x0 y0 z0 x1 */
+		_mm_storeu_ps(_dst + 4, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 1)));	/* y1 z1 x2 y2 */
+		_mm_storeu_ps(_dst + 8, _mm_shuffle_ps(t1, d, _MM_SHUFFLE(2, 1, 2, 0)));	/* z2 x3 y3 z3 */
+	}
+	for(; i < count; i++)
+		memcpy(dst + i * 12, src + i * 16, 12);
+}
+
+/* loads a matrix row of 'column_count' (2 to 4) floats, the other lanes are 0 */
+static inline __m128 load_row_sse2(const float* row, u32 column_count)
+{
+	switch(column_count)
+	{
+		case 2: return _mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)row));
+		case 3: return _mm_movelh_ps(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)row)), _mm_load_ss(row + 2));
+		default: return _mm_loadu_ps(row);
+	}
+}
+
+/* stores a column of 'row_count' (2 to 4) floats, 'column_stride' is either 16 (the lanes past the column are 0) or exactly the column */
+static inline void store_column_sse2(u8* dst, __m128 column, u32 row_count, u32 column_stride)
+{
+	if(column_stride == 16)
+	{
+		_mm_storeu_ps((float*)dst, column);
+		return;
+	}
+	_mm_storel_epi64((__m128i*)dst, _mm_castps_si128(column));
+	if(row_count == 3)
+		_mm_store_ss((float*)dst + 2, _mm_movehl_ps(column, column));
+}
+
+/* row major matrices of 'row_count' rows and 'column_count' columns --> column major, every matrix is transposed in registers */
+static inline void pack_transposed_loop_sse2(u8* dst, u32 dst_stride, const float* src, u32 column_count, u32 row_count, u32 column_stride, u32 count)
+{
+	const __m128 zero = _mm_setzero_ps();
+	u32 src_size = column_count * row_count;
+	for(u32 i = 0; i < count; i++)
+	{
+		/* rows past 'row_count' are 0, so are the lanes of the columns past it */
+		__m128 r0 = load_row_sse2(src, column_count);
+		__m128 r1 = load_row_sse2(src + column_count, column_count);
+		__m128 r2 = (row_count > 2) ? load_row_sse2(src + 2 * column_count, column_count) : zero;
+		__m128 r3 = (row_count > 3) ? load_row_sse2(src + 3 * column_count, column_count) : zero;
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		store_column_sse2(dst, r0, row_count, column_stride);
+		store_column_sse2(dst + column_stride, r1, row_count, column_stride);
+		if(column_count > 2)
+			store_column_sse2(dst + 2 * column_stride, r2, row_count, column_stride);
+		if(column_count > 3)
+			store_column_sse2(dst + 3 * column_stride, r3, row_count, column_stride);
+		dst += dst_stride;
+		src += src_size;
+	}
+}
+
+static void pack_transposed_sse2(u8* dst, u32 dst_stride, const float* src, u32 column_count, u32 row_count, u32 column_stride, u32 count)
+{
+	u32 matrix_size = column_count * column_stride;
+	/* zero the padding between the matrices first (there is none after the last one), the kernels only write the matrices */
+	if(dst_stride > matrix_size)
+		for(u32 i = 0; (i + 1) < count; i++)
+			memset(dst + i * dst_stride + matrix_size, 0, dst_stride - matrix_size);
+	/* the shapes of transforms get loops of their own, with the shape known at compile time */
+	if((column_stride == 16) && (row_count == 4) && (column_count == 4))
+		pack_transposed_loop_sse2(dst, dst_stride, src, 4, 4, 16, count);
+	else if((column_stride == 16) && (row_count == 4) && (column_count == 3))
+		pack_transposed_loop_sse2(dst, dst_stride, src, 3, 4, 16, count);
+	else if((column_stride == 16) && (row_count == 3) && (column_count == 4))
+		pack_transposed_loop_sse2(dst, dst_stride, src, 4, 3, 16, count);
+	else
+		pack_transposed_loop_sse2(dst, dst_stride, src, column_count, row_count, column_stride, count);
+}
+#endif /* GLSLCOM_PACK_SSE2 */
+
+#ifdef GLSLCOM_PACK_AVX2
+/* float[] --> 16 byte stride, 8 elements per iteration */
+GLSLCOM_TARGET_AVX2 static void pack_4_to_16_avx2(u8* dst, const u8* src, u32 count)
+{
+	const __m256 mask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0));
+	u32 i = 0;
+	for(; (i + 8) <= count; i += 8)
+	{
+		__m256 v = _mm256_loadu_ps((const float*)(src + i * 4));
+		_mm256_storeu_ps((float*)(dst + (i + 0) * 16), _mm256_and_ps(_mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1)), mask));
+		_mm256_storeu_ps((float*)(dst + (i + 2) * 16), _mm256_and_ps(_mm256_permutevar8x32_ps(v, _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3)), mask));
+		_mm256_storeu_ps((float*)(dst + (i + 4) * 16), _mm256_and_ps(_mm256_permutevar8x32_ps(v, _mm256_setr_epi32(4, 4, 4, 4, 5, 5, 5, 5)), mask));
+		_mm256_storeu_ps((float*)(dst + (i + 6) * 16), _mm256_and_ps(_mm256_permutevar8x32_ps(v, _mm256_setr_epi32(6, 6, 6, 6, 7, 7, 7, 7)), mask));
+	}
+	pack_4_to_16_sse2(dst + i * 16, src + i * 4, count - i);
+}
+
+/* vec3[] (and mat3 columns) --> vec4 slots, 2 elements per store */
+GLSLCOM_TARGET_AVX2 static void pack_12_to_16_avx2(u8* dst, const u8* src, u32 count)
+{
+	const __m256 mask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0));
+	const __m256i index = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+	u32 i = 0;
+	/* each iteration loads 8 floats but consumes only 6, so stop while a 3rd element still follows */
+	for(; (i + 3) <= count; i += 2)
+	{
+		__m256 v = _mm256_loadu_ps((const float*)(src + i * 12));
+		_mm256_storeu_ps((float*)(dst + i * 16), _mm256_and_ps(_mm256_permutevar8x32_ps(v, index), mask));
+	}
+	pack_12_to_16_sse2(dst + i * 16, src + i * 12, count - i);
+}
+
+static bool cpu_supports_avx2(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+#endif /* GLSLCOM_PACK_AVX2 */
+
+/* packs 'count' elements, each followed by its padding up to 'dst_stride' */
+static void pack_strided_padded(void* dst, u32 dst_stride, const void* src, u32 element_size, u32 count)
+{
+	if(dst_stride == element_size)
+	{
+		memcpy(dst, src, (size_t)element_size * count);
+		return;
+	}
+#ifdef GLSLCOM_PACK_SSE2
+	if(dst_stride == 16)
+	{
+		switch(element_size)
+		{
+			case 4:
+			{
+#ifdef GLSLCOM_PACK_AVX2
+				if(cpu_supports_avx2())
+				{
+					pack_4_to_16_avx2(dst, src, count);
+					return;
+				}
+#endif
+				pack_4_to_16_sse2(dst, src, count);
+				return;
+			}
+			case 8:
+			{
+				pack_8_to_16_sse2(dst, src, count);
+				return;
+			}
+			case 12:
+			{
+#ifdef GLSLCOM_PACK_AVX2
+				if(cpu_supports_avx2())
+				{
+					pack_12_to_16_avx2(dst, src, count);
+					return;
+				}
+#endif
+				pack_12_to_16_sse2(dst, src, count);
+				return;
+			}
+			default:
+				break;
+		}
+	}
+#endif /* GLSLCOM_PACK_SSE2 */
+	pack_strided_generic(dst, dst_stride, src, element_size, count);
+}
+
+/* returns the number of bytes spanned by 'count' elements 'stride' bytes apart, the last one isn't followed by padding */
+static inline u64 get_strided_extent(u32 stride, u32 element_size, u32 count)
+{
+	return (count == 0) ? 0 : ((u64)(count - 1) * stride + element_size);
+}
+
+GLSLCOM_API void glsl_pack_strided(void* dst, u32 dst_stride, const void* src, u32 element_size, u32 count)
+{
+	_ASSERT(dst_stride >= element_size);
+	if(count == 0)
+		return;
+	GLSL_INSTRUMENT_BEGIN();
+	/* the padding of the last element lies past the end of the destination, so only its data is written */
+	u32 padded_count = count - 1;
+	pack_strided_padded(dst, dst_stride, src, element_size, padded_count);
+	memcpy((u8*)dst + (u64)padded_count * dst_stride, (const u8*)src + (u64)padded_count * element_size, element_size);
+	GLSL_INSTRUMENT_PADDING((u64)(dst_stride - element_size) * padded_count);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_PACK_STRIDED, get_strided_extent(dst_stride, element_size, count));
+}
+
+static void unpack_strided(void* dst, const void* src, u32 src_stride, u32 element_size, u32 count)
+{
+	_ASSERT(src_stride >= element_size);
+	if(src_stride == element_size)
+	{
+		memcpy(dst, src, (size_t)element_size * count);
+		return;
+	}
+#ifdef GLSLCOM_PACK_SSE2
+	if(src_stride == 16)
+	{
+		switch(element_size)
+		{
+			case 4: unpack_16_to_4_sse2(dst, src, count); return;
+			case 8: unpack_16_to_8_sse2(dst, src, count); return;
+			case 12: unpack_16_to_12_sse2(dst, src, count); return;
+			default: break;
+		}
+	}
+#endif /* GLSLCOM_PACK_SSE2 */
+	u8* _dst = dst;
+	const u8* _src = src;
+	for(u32 i = 0; i < count; i++)
+		memcpy(_dst + i * element_size, _src + i * src_stride, element_size);
+}
+
+GLSLCOM_API void glsl_unpack_strided(void* dst, const void* src, u32 src_stride, u32 element_size, u32 count)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	unpack_strided(dst, src, src_stride, element_size, count);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_UNPACK_STRIDED, (u64)element_size * count);
+}
+
+/* packs a member as an array of its rows (see glsl_pack_member()), returns the number of bytes read from 'src' and its extent in 'dst' in 'out_extent' */
+static u32 pack_member(void* dst, const glsl_member_layout_t* member, glsl_type_layout_traits_t type_traits, const void* src, u32* out_extent)
+{
+	u32 element_count = type_traits.is_array ? ((type_traits.array_length == 0) ? 1 : type_traits.array_length) : 1;
+	u32 element_size = (type_traits.type == GLSL_TYPE_UNDEFINED) ? type_traits.size : sizeof_glsl_type(type_traits.type, GLSL_MEMORY_LAYOUT_SCALAR);
+	u32 element_stride = type_traits.is_array ? member->array_stride : member->size;
+
+	/* a matrix (or an array of matrices) is packed as an array of its column vectors, MAT3 --> array of VEC3, a row_major one as an array of its row vectors */
+	u32 column_count = columnsof_glsl_type(layout_typeof_glsl_type(type_traits.type, type_traits.is_row_major));
+	u32 row_count = element_count * column_count;
+	u32 row_size = element_size / column_count;
+	u32 row_stride = element_stride / column_count;
+
+	glsl_pack_strided((u8*)dst + member->offset, row_stride, src, row_size, row_count);
+	*out_extent = (u32)get_strided_extent(row_stride, row_size, row_count);
+	return row_size * row_count;
+}
+
+GLSLCOM_API u32 glsl_pack_member(void* dst, const glsl_member_layout_t* member, glsl_type_layout_traits_t type_traits, const void* src)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	u32 extent;
+	u32 read_size = pack_member(dst, member, type_traits, src, &extent);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_PACK_MEMBER, extent);
+	return read_size;
+}
+
+GLSLCOM_API u32 glsl_pack_struct(void* dst, const glsl_type_layout_traits_t* type_traits, const glsl_member_layout_t* members, u32 type_traits_count, const glsl_struct_layout_t* struct_layout, const void* src)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	u8* _dst = dst;
+	const u8* _src = src;
+	u32 cursor = 0;
+	for(u32 i = 0; i < type_traits_count; i++)
+	{
+		/* zero fill the padding in between the members */
+		_ASSERT(members[i].offset >= cursor);
+		memset(_dst + cursor, 0, members[i].offset - cursor);
+		GLSL_INSTRUMENT_PADDING(members[i].offset - cursor);
+		/* the padding of the last element (or matrix column) of the member is zero filled along with the gap to the next member */
+		u32 extent;
+		_src += pack_member(dst, &members[i], type_traits[i], _src, &extent);
+		cursor = members[i].offset + extent;
+	}
+	_ASSERT(struct_layout->size >= cursor);
+	memset(_dst + cursor, 0, struct_layout->size - cursor);
+	GLSL_INSTRUMENT_PADDING(struct_layout->size - cursor);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_PACK_STRUCT, struct_layout->size);
+	return (u32)(_src - (const u8*)src);
+}
+
+#ifndef GLSLCOM_PACK_SSE2
+static void pack_transposed_generic(u8* dst, u32 dst_stride, const f32* src, u32 column_count, u32 row_count, u32 column_stride, u32 count)
+{
+	for(u32 i = 0; i < count; i++)
+	{
+		/* the last matrix is not followed by padding up to 'dst_stride' */
+		memset(dst, 0, ((i + 1) < count) ? dst_stride : (column_count * column_stride));
+		for(u32 column = 0; column < column_count; column++)
+			for(u32 row = 0; row < row_count; row++)
+				memcpy(dst + column * column_stride + row * 4, &src[row * column_count + column], 4);
+		dst += dst_stride;
+		src += column_count * row_count;
+	}
+}
+#endif /* GLSLCOM_PACK_SSE2 */
+
+static void pack_matrices(void* dst, u32 dst_stride, const f32* src, glsl_type_t type, bool is_row_major, glsl_memory_layout_t layout, u32 count)
+{
+	u32 column_count = columnsof_glsl_type(type);
+	u32 row_count = rowsof_glsl_type(type);
+	/* float matrices only */
+	_ASSERT((column_count > 1) && (sizeof_glsl_type(type, GLSL_MEMORY_LAYOUT_SCALAR) == (column_count * row_count * 4)));
+	/* the vectors of the matrix (columns, or rows for row_major) are padded to the stride of their vector type */
+	glsl_type_t layout_type = layout_typeof_glsl_type(type, is_row_major);
+	u32 vector_count = columnsof_glsl_type(layout_type);
+	u32 vector_stride = sizeof_glsl_type(layout_type, layout) / vector_count;
+	u32 matrix_size = vector_count * vector_stride;
+	_ASSERT(dst_stride >= matrix_size);
+	if(count == 0)
+		return;
+	u8* _dst = dst;
+	if(is_row_major)
+	{
+		/* glsl_pack_strided() leaves the padding of the last row it writes, which is still part of the matrix */
+		u32 row_padding = vector_stride - column_count * 4;
+		/* the rows are already in order, the matrices are just arrays of row vectors */
+		if(dst_stride == matrix_size)
+		{
+			glsl_pack_strided(_dst, vector_stride, src, column_count * 4, row_count * count);
+			memset(_dst + (u64)dst_stride * count - row_padding, 0, row_padding);
+			GLSL_INSTRUMENT_PADDING(row_padding);
+			return;
+		}
+		for(u32 i = 0; i < count; i++)
+		{
+			glsl_pack_strided(_dst, vector_stride, src + i * column_count * row_count, column_count * 4, row_count);
+			/* the last matrix is not followed by padding up to 'dst_stride' */
+			u32 end = ((i + 1) < count) ? dst_stride : matrix_size;
+			memset(_dst + matrix_size - row_padding, 0, end - matrix_size + row_padding);
+			_dst += dst_stride;
+		}
+		GLSL_INSTRUMENT_PADDING((u64)row_padding * count + (u64)(dst_stride - matrix_size) * (count - 1));
+		return;
+	}
+	/* everything but the components of the matrices is zero-filled */
+	GLSL_INSTRUMENT_PADDING(get_strided_extent(dst_stride, matrix_size, count) - (u64)column_count * row_count * 4 * count);
+#ifdef GLSLCOM_PACK_SSE2
+	pack_transposed_sse2(_dst, dst_stride, src, column_count, row_count, vector_stride, count);
+#else
+	pack_transposed_generic(_dst, dst_stride, src, column_count, row_count, vector_stride, count);
+#endif /* GLSLCOM_PACK_SSE2 */
+}
+
+GLSLCOM_API void glsl_pack_matrices(void* dst, u32 dst_stride, const f32* src, glsl_type_t type, bool is_row_major, glsl_memory_layout_t layout, u32 count)
+{
+	GLSL_INSTRUMENT_BEGIN();
+	pack_matrices(dst, dst_stride, src, type, is_row_major, layout, count);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_PACK_MATRICES, get_strided_extent(dst_stride, sizeof_glsl_type(layout_typeof_glsl_type(type, is_row_major), layout), count));
+}
@@ -0,0 +1,274 @@
+#include <glslcommon/glsl_push_constant.h>
+#include <glslcommon/glsl_member_order.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memcpy, strcmp, strlen */
+
+/* offsets and sizes of push constant ranges must be multiples of 4 */
+#define GLSL_PUSH_CONSTANT_RANGE_ALIGN 4
+
+/* a distinct member of the blocks */
+typedef struct packer_member_t
+{
+	const char* name;
+	glsl_type_layout_traits_t type_traits;
+	u32 stage_flags;
+	u32 align;
+	u32 size;
+	/* placed in the push constants, otherwise spilled */
+	bool is_included;
+	u32 offset;
+} packer_member_t;
+
+/* scratch memory of place_members() */
+typedef struct packer_scratch_t
+{
+	u32* sorted;
+	u32* group_order;
+	glsl_type_layout_traits_t* group_traits;
+} packer_scratch_t;
+
+static inline u32 lowest_bit(u32 flags)
+{
+	return flags & (~flags + 1);
+}
+
+static inline u32 highest_bit(u32 flags)
+{
+	u32 bit = lowest_bit(flags);
+	while((flags & ~(bit * 2 - 1)) != 0)
+		bit *= 2;
+	return bit;
+}
+
+/* groups of stages are ordered by their first stage and then by their last stage,
+ * so members of the vertex stage only come first, then those shared by the vertex stage and later stages, and so on */
+static s32 compare_stage_groups(u32 a, u32 b)
+{
+	if(lowest_bit(a) != lowest_bit(b))
+		return (lowest_bit(a) < lowest_bit(b)) ? -1 : 1;
+	if(highest_bit(a) != highest_bit(b))
+		return (highest_bit(a) < highest_bit(b)) ? -1 : 1;
+	return (a < b) ? -1 : ((a > b) ? 1 : 0);
+}
+
+static bool is_same_type(const glsl_type_layout_traits_t* a, const glsl_type_layout_traits_t* b)
+{
+	if((a->type != b->type) || (a->is_array != b->is_array))
+		return false;
+	/* a matrix declared row_major in one stage and column major in another would be read transposed */
+	if((columnsof_glsl_type(a->type) > 1) && (a->is_row_major != b->is_row_major))
+		return false;
+	if(a->is_array && (((a->array_length == 0) ? 1 : a->array_length) != ((b->array_length == 0) ? 1 : b->array_length)))
+		return false;
+	return (a->type != GLSL_TYPE_UNDEFINED) || ((a->align == b->align) && (a->size == b->size));
+}
+
+/* assigns offsets to the included members, returns the size of the push constants */
+static u32 place_members(packer_member_t* members, u32 member_count, glsl_memory_layout_t layout, const packer_scratch_t* scratch)
+{
+	/* included members sorted (stable) by stage group, groups are tiny so insertion sort it is */
+	u32 included_count = 0;
+	for(u32 i = 0; i < member_count; i++)
+	{
+		if(!members[i].is_included)
+			continue;
+		u32 j = included_count++;
+		for(; (j > 0) && (compare_stage_groups(members[scratch->sorted[j - 1]].stage_flags, members[i].stage_flags) > 0); j--)
+			scratch->sorted[j] = scratch->sorted[j - 1];
+		scratch->sorted[j] = i;
+	}
+
+	u32 offset = 0;
+	for(u32 begin = 0, end = 0; begin < included_count; begin = end)
+	{
+		u32 stage_flags = members[scratch->sorted[begin]].stage_flags;
+		for(end = begin + 1; (end < included_count) && (members[scratch->sorted[end]].stage_flags == stage_flags); end++);
+		for(u32 i = begin; i < end; i++)
+			scratch->group_traits[i - begin] = members[scratch->sorted[i]].type_traits;
+		glsl_optimize_member_order(scratch->group_traits, end - begin, layout, scratch->group_order, NULL);
+		for(u32 i = begin; i < end; i++)
+		{
+			packer_member_t* member = &members[scratch->sorted[begin + scratch->group_order[i - begin]]];
+			member->offset = u32_round_next_multiple(offset, member->align);
+			offset = member->offset + member->size;
+		}
+	}
+	return u32_round_next_multiple(offset, GLSL_PUSH_CONSTANT_RANGE_ALIGN);
+}
+
+GLSLCOM_API glsl_push_constant_layout_t* glsl_push_constant_layout_create(const glsl_push_constant_block_t* blocks, u32 block_count, glsl_memory_layout_t layout, u32 max_size, const glsl_allocator_t* allocator)
+{
+	u32 declared_count = 0;
+	for(u32 i = 0; i < block_count; i++)
+		declared_count += blocks[i].member_count;
+
+	packer_member_t* members = malloc((sizeof(packer_member_t) + sizeof(u32) * 2 + sizeof(glsl_type_layout_traits_t) + sizeof(glsl_member_layout_t)) * declared_count + 1);
+	if(members == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the push constant layout");
+		return NULL;
+	}
+	glsl_type_layout_traits_t* traits = (glsl_type_layout_traits_t*)(members + declared_count);
+	glsl_member_layout_t* member_layouts = (glsl_member_layout_t*)(traits + declared_count);
+	packer_scratch_t scratch = { (u32*)(member_layouts + declared_count), (u32*)(member_layouts + declared_count) + declared_count, traits };
+
+	/* distinct members, by name, in the order they are first declared */
+	u32 member_count = 0;
+	u32 char_count = 0;
+	for(u32 i = 0; i < block_count; i++)
+	{
+		const glsl_push_constant_block_t* block = &blocks[i];
+		for(u32 j = 0; j < block->member_count; j++)
+		{
+			u32 k = 0;
+			while((k < member_count) && (strcmp(members[k].name, block->names[j]) != 0))
+				k++;
+			if(k == member_count)
+			{
+				members[member_count++] = (packer_member_t) { .name = block->names[j], .type_traits = block->type_traits[j], .stage_flags = block->stage_flags };
+				char_count += (u32)strlen(block->names[j]) + 1;
+				continue;
+			}
+			if((members[k].stage_flags & block->stage_flags) != 0)
+			{
+				debug_log_error("[GLSLCommon] Push constant %s is declared twice in the same stage", block->names[j]);
+				free(members);
+				return NULL;
+			}
+			if(!is_same_type(&members[k].type_traits, &block->type_traits[j]))
+			{
+				debug_log_error("[GLSLCommon] Push constant %s is declared with different types in different stages", block->names[j]);
+				free(members);
+				return NULL;
+			}
+			members[k].stage_flags |= block->stage_flags;
+		}
+	}
+
+	/* alignment and size of a member don't depend on its position */
+	for(u32 i = 0; i < member_count; i++)
+		traits[i] = members[i].type_traits;
+	if(member_count > 0)
+		layoutof_glsl_type_struct(traits, member_count, layout, member_layouts);
+	for(u32 i = 0; i < member_count; i++)
+	{
+		members[i].align = member_layouts[i].align;
+		members[i].size = member_layouts[i].size;
+	}
+
+	/* admit the members one by one, a member which makes the push constants exceed 'max_size' spills (but smaller ones after it may still fit) */
+	for(u32 i = 0; i < member_count; i++)
+	{
+		members[i].is_included = true;
+		if(place_members(members, member_count, layout, &scratch) > max_size)
+			members[i].is_included = false;
+	}
+	u32 size = place_members(members, member_count, layout, &scratch);
+
+	/* the spilled members form a block of their own */
+	u32 spill_count = 0;
+	u32 spill_stage_flags = 0;
+	for(u32 i = 0; i < member_count; i++)
+	{
+		if(members[i].is_included)
+			continue;
+		traits[spill_count++] = members[i].type_traits;
+		spill_stage_flags |= members[i].stage_flags;
+	}
+	glsl_struct_layout_t spill_layout = { 0 };
+	if(spill_count > 0)
+		spill_layout = layoutof_glsl_type_struct(traits, spill_count, layout, member_layouts);
+	for(u32 i = 0, j = 0; i < member_count; i++)
+		if(!members[i].is_included)
+			members[i].offset = member_layouts[j++].offset;
+
+	/* one range per stage, covering every push constant the stage declares; stages with equal ranges share them */
+	glsl_push_constant_range_t ranges[32];
+	u32 range_count = 0;
+	for(u32 bit = 0; bit < 32; bit++)
+	{
+		u32 stage = 1u << bit;
+		u32 begin = ~0u;
+		u32 end = 0;
+		for(u32 i = 0; i < member_count; i++)
+		{
+			if(!members[i].is_included || ((members[i].stage_flags & stage) == 0))
+				continue;
+			if(begin > members[i].offset)
+				begin = members[i].offset;
+			if(end < (members[i].offset + members[i].size))
+				end = members[i].offset + members[i].size;
+		}
+		if(begin == ~0u)
+			continue;
+		begin -= begin % GLSL_PUSH_CONSTANT_RANGE_ALIGN;
+		end = u32_round_next_multiple(end, GLSL_PUSH_CONSTANT_RANGE_ALIGN);
+		u32 i = 0;
+		while((i < range_count) && ((ranges[i].offset != begin) || (ranges[i].size != (end - begin))))
+			i++;
+		if(i == range_count)
+		{
+			/* sorted by offset */
+			for(; (i > 0) && ((ranges[i - 1].offset > begin) || ((ranges[i - 1].offset == begin) && (ranges[i - 1].size > (end - begin)))); i--)
+				ranges[i] = ranges[i - 1];
+			ranges[i] = (glsl_push_constant_range_t) { 0, begin, end - begin };
+			range_count++;
+		}
+		ranges[i].stage_flags |= stage;
+	}
+
+	glsl_push_constant_layout_t* push_constant_layout = glsl_allocator_alloc_object(allocator, sizeof(glsl_push_constant_layout_t) + sizeof(glsl_push_constant_member_t) * member_count + sizeof(glsl_push_constant_range_t) * range_count + char_count);
+	if(push_constant_layout == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_push_constant_layout_t");
+		free(members);
+		return NULL;
+	}
+	glsl_push_constant_member_t* out_members = (glsl_push_constant_member_t*)(push_constant_layout + 1);
+	glsl_push_constant_range_t* out_ranges = (glsl_push_constant_range_t*)(out_members + member_count);
+	char* name = (char*)(out_ranges + range_count);
+	for(u32 i = 0; i < member_count; i++)
+	{
+		u32 name_length = (u32)strlen(members[i].name);
+		memcpy(name, members[i].name, name_length + 1);
+		out_members[i] = (glsl_push_constant_member_t)
+		{
+			.name = name,
+			.stage_flags = members[i].stage_flags,
+			.is_spilled = !members[i].is_included,
+			.offset = members[i].offset,
+			.size = members[i].size
+		};
+		name += name_length + 1;
+	}
+	memcpy(out_ranges, ranges, sizeof(glsl_push_constant_range_t) * range_count);
+	*push_constant_layout = (glsl_push_constant_layout_t)
+	{
+		.member_count = member_count,
+		.members = out_members,
+		.range_count = range_count,
+		.ranges = out_ranges,
+		.size = size,
+		.spill_count = spill_count,
+		.spill_stage_flags = spill_stage_flags,
+		.spill_size = spill_layout.size
+	};
+	free(members);
+	return push_constant_layout;
+}
+
+GLSLCOM_API void glsl_push_constant_layout_destroy(glsl_push_constant_layout_t* layout)
+{
+	glsl_allocator_free_object(layout);
+}
+
+GLSLCOM_API const glsl_push_constant_member_t* glsl_push_constant_layout_find(const glsl_push_constant_layout_t* layout, const char* name)
+{
+	for(u32 i = 0; i < layout->member_count; i++)
+		if(strcmp(layout->members[i].name, name) == 0)
+			return &layout->members[i];
+	return NULL;
+}
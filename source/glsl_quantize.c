@@ -0,0 +1,384 @@
+#include <glslcommon/glsl_quantize.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <string.h> /* memcpy */
+
+#if defined(__SSE2__) || defined(_M_X64)
+#	define GLSLCOM_QUANTIZE_SSE2
+#	include <emmintrin.h>
+#endif
+
+/* F16C kernels are compiled with a per-function target attribute and selected at runtime, same as the AVX2 kernels of glsl_pack.c */
+#if defined(GLSLCOM_QUANTIZE_SSE2) && defined(__GNUC__)
+#	define GLSLCOM_QUANTIZE_F16C
+#	include <immintrin.h>
+#	define GLSLCOM_TARGET_F16C __attribute__((target("f16c")))
+#endif
+
+static inline u32 f32_as_u32(f32 value) { u32 bits; memcpy(&bits, &value, sizeof(bits)); return bits; }
+static inline f32 u32_as_f32(u32 bits) { f32 value; memcpy(&value, &bits, sizeof(value)); return value; }
+
+/* rounds to nearest even for |value| < 2^22, which is what cvtps2dq does in the default rounding mode */
+static inline s32 round_to_s32(f32 value)
+{
+	const f32 magic = 12582912.0f; /* 1.5 * 2^23 */
+	return (s32)((value + magic) - magic);
+}
+
+/* the comparisons are ordered such that NaN clamps to 'low', as maxps does */
+static inline f32 clamp_f32(f32 value, f32 low, f32 high)
+{
+	value = (value > low) ? value : low;
+	return (value < high) ? value : high;
+}
+
+GLSLCOM_API u16 glsl_f32_to_f16(f32 value)
+{
+	u32 bits = f32_as_u32(value);
+	u32 sign = bits & 0x80000000u;
+	bits ^= sign;
+	u16 half;
+	/* 65520 and above round to infinity, NaN becomes the quiet NaN */
+	if(bits >= ((127u + 16u) << 23))
+		half = (bits > (255u << 23)) ? 0x7e00 : 0x7c00;
+	/* below 2^-14 the result is a denormal (or zero), adding 0.5 shifts the mantissa into place and rounds it with the FPU */
+	else if(bits < (113u << 23))
+	{
+		const u32 denormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+		half = (u16)(f32_as_u32(u32_as_f32(bits) + u32_as_f32(denormal_magic)) - denormal_magic);
+	}
+	else
+	{
+		u32 mantissa_odd = (bits >> 13) & 1u;
+		/* rebias the exponent and round to nearest even, a carry out of the mantissa correctly bumps the exponent */
+		bits += ((u32)(15 - 127) << 23) + 0xfffu + mantissa_odd;
+		half = (u16)(bits >> 13);
+	}
+	return half | (u16)(sign >> 16);
+}
+
+GLSLCOM_API f32 glsl_f16_to_f32(u16 value)
+{
+	const u32 shifted_exponent = 0x7c00u << 13;
+	u32 bits = ((u32)value & 0x7fffu) << 13;
+	u32 exponent = bits & shifted_exponent;
+	bits += (127u - 15u) << 23;
+	/* infinity and NaN keep the maximum exponent */
+	if(exponent == shifted_exponent)
+		bits += (128u - 16u) << 23;
+	/* denormals are renormalized by the FPU */
+	else if(exponent == 0)
+		bits = f32_as_u32(u32_as_f32(bits + (1u << 23)) - u32_as_f32(113u << 23));
+	return u32_as_f32(bits | (((u32)value & 0x8000u) << 16));
+}
+
+GLSLCOM_API s16 glsl_f32_to_snorm16(f32 value) { return (s16)round_to_s32(clamp_f32(value, -1.0f, 1.0f) * 32767.0f); }
+GLSLCOM_API s8 glsl_f32_to_snorm8(f32 value) { return (s8)round_to_s32(clamp_f32(value, -1.0f, 1.0f) * 127.0f); }
+GLSLCOM_API u16 glsl_f32_to_unorm16(f32 value) { return (u16)round_to_s32(clamp_f32(value, 0.0f, 1.0f) * 65535.0f); }
+GLSLCOM_API u8 glsl_f32_to_unorm8(f32 value) { return (u8)round_to_s32(clamp_f32(value, 0.0f, 1.0f) * 255.0f); }
+
+/* Vulkan: f = max(c / (2^(b - 1) - 1), -1.0) for snorm and f = c / (2^b - 1) for unorm */
+GLSLCOM_API f32 glsl_snorm16_to_f32(s16 value) { f32 f = (f32)value / 32767.0f; return (f < -1.0f) ? -1.0f : f; }
+GLSLCOM_API f32 glsl_snorm8_to_f32(s8 value) { f32 f = (f32)value / 127.0f; return (f < -1.0f) ? -1.0f : f; }
+GLSLCOM_API f32 glsl_unorm16_to_f32(u16 value) { return (f32)value / 65535.0f; }
+GLSLCOM_API f32 glsl_unorm8_to_f32(u8 value) { return (f32)value / 255.0f; }
+
+#ifdef GLSLCOM_QUANTIZE_SSE2
+static inline __m128i quantize_4_sse2(const f32* src, __m128 low, __m128 high, __m128 scale)
+{
+	return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src), low), high), scale));
+}
+
+/* each returns the number of components it has encoded, the remaining ones are encoded by the scalar loop */
+static u32 quantize_snorm16_sse2(s16* dst, const f32* src, u32 count)
+{
+	const __m128 low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(32767.0f);
+	u32 i = 0;
+	for(; (i + 8) <= count; i += 8)
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(quantize_4_sse2(src + i, low, high, scale), quantize_4_sse2(src + i + 4, low, high, scale)));
+	return i;
+}
+
+static u32 quantize_unorm16_sse2(u16* dst, const f32* src, u32 count)
+{
+	const __m128 low = _mm_setzero_ps(), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(65535.0f);
+	/* SSE2 has only the signed saturating pack, so the values are biased into the s16 range and the bias is flipped back afterwards */
+	const __m128i bias = _mm_set1_epi32(32768);
+	const __m128i flip = _mm_set1_epi16((s16)0x8000);
+	u32 i = 0;
+	for(; (i + 8) <= count; i += 8)
+	{
+		__m128i a = _mm_sub_epi32(quantize_4_sse2(src + i, low, high, scale), bias);
+		__m128i b = _mm_sub_epi32(quantize_4_sse2(src + i + 4, low, high, scale), bias);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(_mm_packs_epi32(a, b), flip));
+	}
+	return i;
+}
+
+static u32 quantize_snorm8_sse2(s8* dst, const f32* src, u32 count)
+{
+	const __m128 low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(127.0f);
+	u32 i = 0;
+	for(; (i + 16) <= count; i += 16)
+	{
+		__m128i a = _mm_packs_epi32(quantize_4_sse2(src + i, low, high, scale), quantize_4_sse2(src + i + 4, low, high, scale));
+		__m128i b = _mm_packs_epi32(quantize_4_sse2(src + i + 8, low, high, scale), quantize_4_sse2(src + i + 12, low, high, scale));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi16(a, b));
+	}
+	return i;
+}
+
+static u32 quantize_unorm8_sse2(u8* dst, const f32* src, u32 count)
+{
+	const __m128 low = _mm_setzero_ps(), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(255.0f);
+	u32 i = 0;
+	for(; (i + 16) <= count; i += 16)
+	{
+		__m128i a = _mm_packs_epi32(quantize_4_sse2(src + i, low, high, scale), quantize_4_sse2(src + i + 4, low, high, scale));
+		__m128i b = _mm_packs_epi32(quantize_4_sse2(src + i + 8, low, high, scale), quantize_4_sse2(src + i + 12, low, high, scale));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(a, b));
+	}
+	return i;
+}
+
+/* 16 bit values are widened to s32 by placing them in the upper halves and shifting them back down */
+static u32 dequantize_snorm16_sse2(f32* dst, const s16* src, u32 count)
+{
+	const __m128 low = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(32767.0f);
+	u32 i = 0;
+	for(; (i + 8) <= count; i += 8)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_ps(dst + i, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), scale), low));
+		_mm_storeu_ps(dst + i + 4, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), scale), low));
+	}
+	return i;
+}
+
+static u32 dequantize_unorm16_sse2(f32* dst, const u16* src, u32 count)
+{
+	const __m128 scale = _mm_set1_ps(65535.0f);
+	const __m128i zero = _mm_setzero_si128();
+	u32 i = 0;
+	for(; (i + 8) <= count; i += 8)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_ps(dst + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), scale));
+		_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), scale));
+	}
+	return i;
+}
+
+/* bytes are widened the same way, repeated into all four bytes of an s32 and shifted back down */
+static u32 dequantize_snorm8_sse2(f32* dst, const s8* src, u32 count)
+{
+	const __m128 low = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(127.0f);
+	u32 i = 0;
+	for(; (i + 16) <= count; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(v, v);
+		__m128i hi = _mm_unpackhi_epi8(v, v);
+		_mm_storeu_ps(dst + i, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 24)), scale), low));
+		_mm_storeu_ps(dst + i + 4, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 24)), scale), low));
+		_mm_storeu_ps(dst + i + 8, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 24)), scale), low));
+		_mm_storeu_ps(dst + i + 12, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 24)), scale), low));
+	}
+	return i;
+}
+
+static u32 dequantize_unorm8_sse2(f32* dst, const u8* src, u32 count)
+{
+	const __m128 scale = _mm_set1_ps(255.0f);
+	const __m128i zero = _mm_setzero_si128();
+	u32 i = 0;
+	for(; (i + 16) <= count; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_ps(dst + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+		_mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+	}
+	return i;
+}
+#endif /* GLSLCOM_QUANTIZE_SSE2 */
+
+#ifdef GLSLCOM_QUANTIZE_F16C
+GLSLCOM_TARGET_F16C static u32 quantize_half_f16c(u16* dst, const f32* src, u32 count)
+{
+	u32 i = 0;
+	for(; (i + 8) <= count; i += 8)
+	{
+		__m128i a = _mm_cvtps_ph(_mm_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+		__m128i b = _mm_cvtps_ph(_mm_loadu_ps(src + i + 4), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi64(a, b));
+	}
+	return i;
+}
+
+GLSLCOM_TARGET_F16C static u32 dequantize_half_f16c(f32* dst, const u16* src, u32 count)
+{
+	u32 i = 0;
+	for(; (i + 8) <= count; i += 8)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_ps(dst + i, _mm_cvtph_ps(v));
+		_mm_storeu_ps(dst + i + 4, _mm_cvtph_ps(_mm_unpackhi_epi64(v, v)));
+	}
+	return i;
+}
+
+static bool cpu_supports_f16c(void)
+{
+	return __builtin_cpu_supports("f16c");
+}
+#endif /* GLSLCOM_QUANTIZE_F16C */
+
+GLSLCOM_API void glsl_quantize(void* dst, const f32* src, u32 component_count, glsl_component_encoding_t encoding)
+{
+	_ASSERT((dst != NULL) || (component_count == 0));
+	GLSL_INSTRUMENT_BEGIN();
+	u32 i = 0;
+	switch(encoding)
+	{
+		case GLSL_COMPONENT_ENCODING_NATIVE:
+		{
+			memcpy(dst, src, sizeof(f32) * component_count);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_HALF:
+		{
+			u16* out = (u16*)dst;
+#ifdef GLSLCOM_QUANTIZE_F16C
+			if(cpu_supports_f16c())
+				i = quantize_half_f16c(out, src, component_count);
+#endif
+			for(; i < component_count; i++)
+				out[i] = glsl_f32_to_f16(src[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_SNORM16:
+		{
+			s16* out = (s16*)dst;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = quantize_snorm16_sse2(out, src, component_count);
+#endif
+			for(; i < component_count; i++)
+				out[i] = glsl_f32_to_snorm16(src[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_SNORM8:
+		{
+			s8* out = (s8*)dst;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = quantize_snorm8_sse2(out, src, component_count);
+#endif
+			for(; i < component_count; i++)
+				out[i] = glsl_f32_to_snorm8(src[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_UNORM16:
+		{
+			u16* out = (u16*)dst;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = quantize_unorm16_sse2(out, src, component_count);
+#endif
+			for(; i < component_count; i++)
+				out[i] = glsl_f32_to_unorm16(src[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_UNORM8:
+		{
+			u8* out = (u8*)dst;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = quantize_unorm8_sse2(out, src, component_count);
+#endif
+			for(; i < component_count; i++)
+				out[i] = glsl_f32_to_unorm8(src[i]);
+			break;
+		}
+		default:
+		{
+			debug_log_error("[GLSLCommon] Invalid glsl_component_encoding_t is provided");
+			break;
+		}
+	}
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_QUANTIZE, (u64)sizeof_glsl_component_encoding(encoding) * component_count);
+}
+
+GLSLCOM_API void glsl_dequantize(f32* dst, const void* src, u32 component_count, glsl_component_encoding_t encoding)
+{
+	_ASSERT((src != NULL) || (component_count == 0));
+	GLSL_INSTRUMENT_BEGIN();
+	u32 i = 0;
+	switch(encoding)
+	{
+		case GLSL_COMPONENT_ENCODING_NATIVE:
+		{
+			memcpy(dst, src, sizeof(f32) * component_count);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_HALF:
+		{
+			const u16* in = (const u16*)src;
+#ifdef GLSLCOM_QUANTIZE_F16C
+			if(cpu_supports_f16c())
+				i = dequantize_half_f16c(dst, in, component_count);
+#endif
+			for(; i < component_count; i++)
+				dst[i] = glsl_f16_to_f32(in[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_SNORM16:
+		{
+			const s16* in = (const s16*)src;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = dequantize_snorm16_sse2(dst, in, component_count);
+#endif
+			for(; i < component_count; i++)
+				dst[i] = glsl_snorm16_to_f32(in[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_SNORM8:
+		{
+			const s8* in = (const s8*)src;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = dequantize_snorm8_sse2(dst, in, component_count);
+#endif
+			for(; i < component_count; i++)
+				dst[i] = glsl_snorm8_to_f32(in[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_UNORM16:
+		{
+			const u16* in = (const u16*)src;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = dequantize_unorm16_sse2(dst, in, component_count);
+#endif
+			for(; i < component_count; i++)
+				dst[i] = glsl_unorm16_to_f32(in[i]);
+			break;
+		}
+		case GLSL_COMPONENT_ENCODING_UNORM8:
+		{
+			const u8* in = (const u8*)src;
+#ifdef GLSLCOM_QUANTIZE_SSE2
+			i = dequantize_unorm8_sse2(dst, in, component_count);
+#endif
+			for(; i < component_count; i++)
+				dst[i] = glsl_unorm8_to_f32(in[i]);
+			break;
+		}
+		default:
+		{
+			debug_log_error("[GLSLCommon] Invalid glsl_component_encoding_t is provided");
+			break;
+		}
+	}
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_DEQUANTIZE, (u64)sizeof(f32) * component_count);
+}
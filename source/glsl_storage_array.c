@@ -0,0 +1,98 @@
+#include <glslcommon/glsl_storage_array.h>
+#include <glslcommon/glsl_pack.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memcpy */
+
+/* glsl_copy_plan_execute_array() and glsl_pack_strided() take u32 counts, larger appends are split into batches of this many elements */
+#define STORAGE_ARRAY_MAX_BATCH_COUNT (1u << 20)
+
+GLSLCOM_API glsl_storage_array_layout_t glsl_storage_array_layout(const glsl_type_layout_traits_t* header_traits, u32 header_count, glsl_type_layout_traits_t element_traits, glsl_memory_layout_t layout, glsl_member_layout_t* out_header_members)
+{
+	/* the array is laid out as the last member of the block, with one element */
+	glsl_type_layout_traits_t* traits = malloc((sizeof(glsl_type_layout_traits_t) + sizeof(glsl_member_layout_t)) * (header_count + 1));
+	if(traits == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for the storage array layout");
+		return (glsl_storage_array_layout_t) { 0 };
+	}
+	glsl_member_layout_t* members = (glsl_member_layout_t*)(traits + header_count + 1);
+	if(header_count > 0)
+		memcpy(traits, header_traits, sizeof(glsl_type_layout_traits_t) * header_count);
+	traits[header_count] = element_traits;
+	traits[header_count].is_array = true;
+	traits[header_count].array_length = 1;
+	glsl_struct_layout_t struct_layout = layoutof_glsl_type_struct(traits, header_count + 1, layout, members);
+
+	glsl_storage_array_layout_t array_layout;
+	array_layout.header_size = members[header_count].offset;
+	array_layout.element_stride = members[header_count].array_stride;
+	array_layout.align = struct_layout.align;
+	if(out_header_members != NULL)
+		memcpy(out_header_members, members, sizeof(glsl_member_layout_t) * header_count);
+	free(traits);
+	return array_layout;
+}
+
+GLSLCOM_API bool glsl_storage_array_layout_from_tree(const glsl_layout_tree_t* tree, glsl_storage_array_layout_t* out_layout)
+{
+	const glsl_layout_node_t* root = &tree->root;
+	if((root->child_count == 0) || (root->children[root->child_count - 1].array_dimension_count == 0))
+	{
+		debug_log_error("[GLSLCommon] Block %s doesn't end in an array", (root->name != NULL) ? root->name : "");
+		return false;
+	}
+	const glsl_layout_node_t* array = &root->children[root->child_count - 1];
+	out_layout->header_size = array->offset;
+	out_layout->element_stride = array->array_strides[0];
+	out_layout->align = root->align;
+	return true;
+}
+
+GLSLCOM_API void glsl_storage_array_writer_init(glsl_storage_array_writer_t* writer, const glsl_storage_array_layout_t* layout, void* mapped_data, u64 buffer_size, const glsl_copy_plan_t* plan)
+{
+	_ASSERT(layout->element_stride > 0);
+#ifdef GLSLCOM_DEBUG
+	if((plan != NULL) && (plan->dst_size > layout->element_stride))
+		debug_log_fetal_error("[GLSLCommon] Copy plan writes %u bytes, more than the element stride %u of the storage array", plan->dst_size, layout->element_stride);
+#endif /* GLSLCOM_DEBUG */
+	writer->elements = (u8*)mapped_data + layout->header_size;
+	writer->element_stride = layout->element_stride;
+	writer->plan = plan;
+	writer->capacity = glsl_storage_array_get_capacity(layout, buffer_size);
+	writer->count = 0;
+}
+
+GLSLCOM_API u64 glsl_storage_array_append(glsl_storage_array_writer_t* writer, const void* src, u32 src_stride, u64 count)
+{
+	_ASSERT((writer->plan != NULL) || (src_stride <= writer->element_stride));
+	GLSL_INSTRUMENT_BEGIN();
+	if(count > (writer->capacity - writer->count))
+		count = writer->capacity - writer->count;
+	u8* dst = writer->elements + writer->count * writer->element_stride;
+	const u8* _src = src;
+	u32 stride = writer->element_stride;
+	/* identical strides without a plan are a single copy */
+	if((writer->plan == NULL) && (src_stride == stride))
+		memcpy(dst, _src, count * stride);
+	else
+	{
+		for(u64 remaining = count; remaining > 0;)
+		{
+			u32 batch_count = (remaining < STORAGE_ARRAY_MAX_BATCH_COUNT) ? (u32)remaining : STORAGE_ARRAY_MAX_BATCH_COUNT;
+			if(writer->plan != NULL)
+				glsl_copy_plan_execute_array(writer->plan, dst, stride, _src, src_stride, batch_count);
+			else
+				glsl_pack_strided(dst, stride, _src, src_stride, batch_count);
+			dst += (u64)batch_count * stride;
+			_src += (u64)batch_count * src_stride;
+			remaining -= batch_count;
+		}
+	}
+	writer->count += count;
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_STORAGE_ARRAY_APPEND, count * stride);
+	return count;
+}
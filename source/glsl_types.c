@@ -1,4 +1,5 @@
 #include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_instrument.h>
 #include <glslcommon/debug.h>
 #include <glslcommon/assert.h> /* _ASSERT */
 
@@ -15,37 +16,6 @@ A structure has a scalar alignment equal to the largest scalar alignment of any
 
 A matrix type inherits scalar alignment from the equivalent array declaration.
  */
-static u32 alignof_glsl_type_scalar(glsl_type_t type, bool is_array)
-{
-    switch(type)
-    {
-        case GLSL_TYPE_FLOAT            : /* IEEE 745 double precision float has 32 bits */
-        case GLSL_TYPE_INT              : /* GLSL spec states 32-bits for int */
-        case GLSL_TYPE_UINT             : return 4; /* GLSL spec states 32-bits for uint */
-        case GLSL_TYPE_DOUBLE           : return 8; /* IEEE 745 double precision float has 64 bits */
-        case GLSL_TYPE_IVEC4            :
-        case GLSL_TYPE_UVEC4            :
-        case GLSL_TYPE_IVEC3            :
-        case GLSL_TYPE_UVEC3            :
-        case GLSL_TYPE_IVEC2            :
-        case GLSL_TYPE_UVEC2            :
-        case GLSL_TYPE_VEC2             :
-        case GLSL_TYPE_VEC3             :
-        case GLSL_TYPE_VEC4             : return 4; /* Scalar Alignment: A vector type has a scalar alignment equal to that of its component type. */
-        case GLSL_TYPE_DVEC2            :
-        case GLSL_TYPE_DVEC3            :
-        case GLSL_TYPE_DVEC4            : return 8; /* Scalar Alignment: A vector type has a scalar alignment equal to that of its component type. */
-        case GLSL_TYPE_MAT2             :
-        case GLSL_TYPE_MAT3             :
-        case GLSL_TYPE_MAT4             : return 4; /* Recursively MAT2 --> array of VEC2, MAT3 --> array of VEC3, MAT4 --> array of VEC4 */
-        case GLSL_TYPE_DMAT2            :
-        case GLSL_TYPE_DMAT3            :
-        case GLSL_TYPE_DMAT4            : return 8; /* Recursively DMAT2 --> array of DVEC2, DMAT3 --> array of DVEC3, DMAT4 --> array of DVEC4 */
-        default                         : debug_log_fetal_error("alignment is not defined for glsl type \"%u\"\n", type);
-    };
-    return 0;
-}
-
 /*  Base Alignment:
 The base alignment of the type of an OpTypeStruct member is defined recursively as follows:
 
@@ -61,37 +31,6 @@ A structure has a base alignment equal to the largest base alignment of any of i
 
 A matrix type inherits base alignment from the equivalent array declaration.
 */
-static u32 alignof_glsl_type_base(glsl_type_t type, bool is_array)
-{
-    switch(type)
-    {
-        case GLSL_TYPE_FLOAT            : /* IEEE 745 double precision float has 32 bits */
-        case GLSL_TYPE_INT              : /* GLSL spec states 32-bits for int */
-        case GLSL_TYPE_UINT             : return 4; /* GLSL spec states 32-bits for uint */
-        case GLSL_TYPE_DOUBLE           : return 8; /* IEEE 745 double precision float has 64 bits */
-        case GLSL_TYPE_IVEC2            :
-        case GLSL_TYPE_UVEC2            :
-        case GLSL_TYPE_VEC2             : return 8; /* Base Alignment: A two-component vector has a base alignment equal to twice its scalar alignment. */
-        case GLSL_TYPE_DVEC2            : return 16; /* Base Alignment: A two-component vector has a base alignment equal to twice its scalar alignment. */
-        case GLSL_TYPE_IVEC4            :
-        case GLSL_TYPE_UVEC4            :
-        case GLSL_TYPE_IVEC3            :
-        case GLSL_TYPE_UVEC3            :
-        case GLSL_TYPE_VEC3             :
-        case GLSL_TYPE_VEC4             : return 16; /* Base Alignment: A three- or four-component vector has a base alignment equal to four times its scalar alignment. */
-        case GLSL_TYPE_DVEC3            :
-        case GLSL_TYPE_DVEC4            : return 32; /* Base Alignment: A three- or four-component vector has a base alignment equal to four times its scalar alignment. */
-        case GLSL_TYPE_MAT2             : return 8; /* MAT2 --> array of VEC2 */
-        case GLSL_TYPE_MAT3             :
-        case GLSL_TYPE_MAT4             : return 16; /* Base Alignment: A matrix type inherits base alignment from the equivalent array declaration. */
-        case GLSL_TYPE_DMAT2            : return 16; /* Recursively DMAT2 --> array of DVEC2 */
-        case GLSL_TYPE_DMAT3            :
-        case GLSL_TYPE_DMAT4            : return 32; /* BaseAlignment: MAT3 --> array of VEC3, MAT4 --> array of VEC4 */
-        default                         : debug_log_fetal_error("alignment is not defined for glsl type \"%u\"\n", type);
-    };
-    return 0;
-}
-
 /* Extended Alignment:
 The extended alignment of the type of an OpTypeStruct member is similarly defined as follows:
 
@@ -101,92 +40,95 @@ An array or structure type has an extended alignment equal to the largest extend
 
 A matrix type inherits extended alignment from the equivalent array declaration.
 */
-static u32 alignof_glsl_type_extended(glsl_type_t type, bool is_array)
+#define GLSL_ALIGN_ENTRY(LAYOUT, type, NAME, size) [type] = GLSL_##LAYOUT##_##NAME##_ALIGN,
+#define GLSL_ARR_ALIGN_ENTRY(LAYOUT, type, NAME, size) [type] = GLSL_##LAYOUT##_##NAME##_ARR_ALIGN,
+#define GLSL_SIZE_ENTRY(LAYOUT, type, NAME, size) [type] = (size),
+/* consecutive elements of an array must start at a multiple of the array's alignment */
+#define GLSL_ARR_STRIDE_ENTRY(LAYOUT, type, NAME, size) [type] = U32_NEXT_MULTIPLE((size), GLSL_##LAYOUT##_##NAME##_ARR_ALIGN),
+
+GLSLCOM_API const u32 glsl_type_align_table[GLSL_MEMORY_LAYOUT_MAX][2][GLSL_TYPE_MAX] =
 {
-    switch(type)
-    {
-        case GLSL_TYPE_FLOAT            : /* IEEE 745 double precision float has 32 bits */
-        case GLSL_TYPE_INT              : /* GLSL spec states 32-bits for int */
-        case GLSL_TYPE_UINT             : return is_array ? 16 : 4; /* GLSL spec states 32-bits for uint */
-        case GLSL_TYPE_DOUBLE           : return is_array ? 16 : 8; /* IEEE 745 double precision float has 64 bits */
-        case GLSL_TYPE_IVEC2            :
-        case GLSL_TYPE_UVEC2            :
-        case GLSL_TYPE_VEC2             : return is_array ? 16 : 8; /* Base Alignment: A two-component vector has a base alignment equal to twice its scalar alignment. */
-        case GLSL_TYPE_DVEC2            : return 16; /* Base Alignment: A two-component vector has a base alignment equal to twice its scalar alignment. */
-        case GLSL_TYPE_IVEC4            :
-        case GLSL_TYPE_UVEC4            :
-        case GLSL_TYPE_IVEC3            :
-        case GLSL_TYPE_UVEC3            :
-        case GLSL_TYPE_VEC3             :
-        case GLSL_TYPE_VEC4             : return 16; /* Base Alignment: A three- or four-component vector has a base alignment equal to four times its scalar alignment. */
-        case GLSL_TYPE_DVEC3            :
-        case GLSL_TYPE_DVEC4            : return 32; /* Base Alignment: A three- or four-component vector has a base alignment equal to four times its scalar alignment. */
-        case GLSL_TYPE_MAT2             : return is_array ? 16 : 8; /* MAT2 --> array of VEC2 */
-        case GLSL_TYPE_MAT3             :
-        case GLSL_TYPE_MAT4             : return 16; /* Base Alignment: A matrix type inherits base alignment from the equivalent array declaration. */
-        case GLSL_TYPE_DMAT2            : return 16; /* Recursively MAT2 --> array of VEC2 */
-        case GLSL_TYPE_DMAT3            :
-        case GLSL_TYPE_DMAT4            : return 32; /* BaseAlignment: MAT3 --> array of VEC3, MAT4 --> array of VEC4 */
-        default                         : debug_log_fetal_error("alignment is not defined for glsl type \"%u\"\n", type);
-    };
-    return 0;
-}
+    [GLSL_MEMORY_LAYOUT_SCALAR] = { { GLSL_TYPE_LAYOUT_LIST(GLSL_ALIGN_ENTRY, SCALAR) }, { GLSL_TYPE_LAYOUT_LIST(GLSL_ARR_ALIGN_ENTRY, SCALAR) } },
+    [GLSL_MEMORY_LAYOUT_BASE] = { { GLSL_TYPE_LAYOUT_LIST(GLSL_ALIGN_ENTRY, STD430) }, { GLSL_TYPE_LAYOUT_LIST(GLSL_ARR_ALIGN_ENTRY, STD430) } },
+    [GLSL_MEMORY_LAYOUT_EXTENDED] = { { GLSL_TYPE_LAYOUT_LIST(GLSL_ALIGN_ENTRY, STD140) }, { GLSL_TYPE_LAYOUT_LIST(GLSL_ARR_ALIGN_ENTRY, STD140) } }
+};
 
-GLSLCOM_API u32 alignof_glsl_type(glsl_type_t type, glsl_memory_layout_t layout)
+GLSLCOM_API const u32 glsl_type_size_table[GLSL_MEMORY_LAYOUT_MAX][2][GLSL_TYPE_MAX] =
 {
-    switch(layout)
+    [GLSL_MEMORY_LAYOUT_SCALAR] = { { GLSL_TYPE_LAYOUT_LIST(GLSL_SIZE_ENTRY, SCALAR) }, { GLSL_TYPE_LAYOUT_LIST(GLSL_ARR_STRIDE_ENTRY, SCALAR) } },
+    [GLSL_MEMORY_LAYOUT_BASE] = { { GLSL_TYPE_LAYOUT_LIST(GLSL_SIZE_ENTRY, STD430) }, { GLSL_TYPE_LAYOUT_LIST(GLSL_ARR_STRIDE_ENTRY, STD430) } },
+    [GLSL_MEMORY_LAYOUT_EXTENDED] = { { GLSL_TYPE_LAYOUT_LIST(GLSL_SIZE_ENTRY, STD140) }, { GLSL_TYPE_LAYOUT_LIST(GLSL_ARR_STRIDE_ENTRY, STD140) } }
+};
+
+GLSLCOM_API u32 glsl_type_table_lookup(const u32 table[GLSL_MEMORY_LAYOUT_MAX][2][GLSL_TYPE_MAX], glsl_memory_layout_t layout, bool is_array, glsl_type_t type)
+{
+    if(layout >= GLSL_MEMORY_LAYOUT_MAX)
     {
-        case GLSL_MEMORY_LAYOUT_SCALAR:
-        {
-            return alignof_glsl_type_scalar(type, false);
-        }
-        case GLSL_MEMORY_LAYOUT_BASE:
-        {
-            return alignof_glsl_type_base(type, false);
-        }
-        case GLSL_MEMORY_LAYOUT_EXTENDED:
-        {
-            return alignof_glsl_type_extended(type, false);
-        }
-        default:
-        {
-            debug_log_fetal_error("[GLSLCommon] Invalid glsl_memory_layout_t is provided");
-            return 0;
-        }
+        debug_log_fetal_error("[GLSLCommon] Invalid glsl_memory_layout_t is provided");
+        return 0;
     }
+    if((type >= GLSL_TYPE_MAX) || (table[layout][is_array][type] == 0))
+    {
+        debug_log_fetal_error("%s is not defined for glsl type \"%u\"\n", (table == glsl_type_align_table) ? "alignment" : "size", type);
+        return 0;
+    }
+    return table[layout][is_array][type];
 }
 
-GLSLCOM_API u32 alignof_glsl_type_array(glsl_type_t type, glsl_memory_layout_t layout)
+/* resolves 'count' types through one row of a lookup table, out of range types would read past the end of the row */
+static void lookup_glsl_types(const u32* table, const glsl_type_t* types, u32 count, u32* out_values)
 {
-    switch(layout)
+    for(u32 i = 0; i < count; i++)
     {
-        case GLSL_MEMORY_LAYOUT_SCALAR:
+        if(types[i] >= GLSL_TYPE_MAX)
         {
-            return alignof_glsl_type_scalar(type, true);
-        }
-        case GLSL_MEMORY_LAYOUT_BASE:
-        {
-            return alignof_glsl_type_base(type, true);
-        }
-        case GLSL_MEMORY_LAYOUT_EXTENDED:
-        {
-            return alignof_glsl_type_extended(type, true);
-        }
-        default:
-        {
-            debug_log_fetal_error("[GLSLCommon] Invalid glsl_memory_layout_t is provided");
-            return 0;
+            debug_log_fetal_error("[GLSLCommon] Invalid glsl type \"%u\"\n", types[i]);
+            out_values[i] = 0;
         }
+        else
+            out_values[i] = table[types[i]];
     }
 }
 
+static bool check_layout(glsl_memory_layout_t layout)
+{
+    if(layout < GLSL_MEMORY_LAYOUT_MAX)
+        return true;
+    debug_log_fetal_error("[GLSLCommon] Invalid glsl_memory_layout_t is provided");
+    return false;
+}
+
+GLSLCOM_API void alignof_glsl_types(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_aligns)
+{
+    if(check_layout(layout))
+        lookup_glsl_types(glsl_type_align_table[layout][false], types, count, out_aligns);
+}
+
+GLSLCOM_API void alignof_glsl_types_array(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_aligns)
+{
+    if(check_layout(layout))
+        lookup_glsl_types(glsl_type_align_table[layout][true], types, count, out_aligns);
+}
+
+GLSLCOM_API void sizeof_glsl_types(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_sizes)
+{
+    if(check_layout(layout))
+        lookup_glsl_types(glsl_type_size_table[layout][false], types, count, out_sizes);
+}
+
+GLSLCOM_API void strideof_glsl_types_array(const glsl_type_t* types, u32 count, glsl_memory_layout_t layout, u32* out_strides)
+{
+    if(check_layout(layout))
+        lookup_glsl_types(glsl_type_size_table[layout][true], types, count, out_strides);
+}
+
 static u32 get_align_from_type_traits(glsl_type_layout_traits_t type_traits, glsl_memory_layout_t layout)
 {
     if(type_traits.type == GLSL_TYPE_UNDEFINED)
         return type_traits.align;
-    if(type_traits.is_array)
-        return alignof_glsl_type_array(type_traits.type, layout);
-    return alignof_glsl_type(type_traits.type, layout);
+    /* checked lookup even in release builds, an undefined alignment (e.g. of an opaque type) would otherwise be a division by zero */
+    glsl_type_t type = layout_typeof_glsl_type(type_traits.type, type_traits.is_row_major);
+    return glsl_type_table_lookup(glsl_type_align_table, layout, type_traits.is_array, type);
 }
 
 GLSLCOM_API u32 alignof_glsl_type_struct(glsl_type_layout_traits_callback_t callback, void* user_data, u32 type_traits_count, glsl_memory_layout_t layout)
@@ -223,35 +165,67 @@ GLSLCOM_API u32 alignof_glsl_type_struct(glsl_type_layout_traits_callback_t call
     }
 }
 
-GLSLCOM_API u32 sizeof_glsl_type(glsl_type_t type, glsl_memory_layout_t layout)
+static glsl_member_layout_t get_member_layout_from_type_traits(glsl_type_layout_traits_t type_traits, glsl_memory_layout_t layout)
+{
+    glsl_member_layout_t member = { 0 };
+    u32 element_size;
+    if(type_traits.type == GLSL_TYPE_UNDEFINED)
+    {
+        if(type_traits.align == 0)
+            debug_log_fetal_error("[GLSLCommon] Alignment of a member of GLSL_TYPE_UNDEFINED type must not be 0");
+        member.align = type_traits.align;
+        /* Extended Alignment: An array has an extended alignment rounded up to a multiple of 16 */
+        if(type_traits.is_array && (layout == GLSL_MEMORY_LAYOUT_EXTENDED))
+            member.align = u32_round_next_multiple(member.align, 16);
+        element_size = type_traits.size;
+    }
+    else
+    {
+        member.align = get_align_from_type_traits(type_traits, layout);
+        element_size = glsl_type_table_lookup(glsl_type_size_table, layout, false, layout_typeof_glsl_type(type_traits.type, type_traits.is_row_major));
+    }
+
+    if(type_traits.is_array)
+    {
+        /* consecutive elements of an array must start at a multiple of the array's alignment */
+        member.array_stride = u32_round_next_multiple(element_size, member.align);
+        member.size = member.array_stride * ((type_traits.array_length == 0) ? 1 : type_traits.array_length);
+    }
+    else
+        member.size = element_size;
+    return member;
+}
+
+GLSLCOM_API glsl_struct_layout_t layoutof_glsl_type_struct(const glsl_type_layout_traits_t* type_traits, u32 type_traits_count, glsl_memory_layout_t layout, glsl_member_layout_t* out_members)
 {
-	switch(type)
-	{
-        case GLSL_TYPE_FLOAT            : /* IEEE 745 double precision float has 32 bits */
-        case GLSL_TYPE_INT              : /* GLSL spec states 32-bits for int */
-        case GLSL_TYPE_UINT             : return 4; /* GLSL spec states 32-bits for uint */
-        case GLSL_TYPE_DOUBLE           : return 8; /* IEEE 745 double precision float has 64 bits */
-        case GLSL_TYPE_IVEC2            :
-        case GLSL_TYPE_UVEC2            :
-        case GLSL_TYPE_VEC2             : return 8;
-        case GLSL_TYPE_DVEC2            : return 16;
-        case GLSL_TYPE_IVEC4            :
-        case GLSL_TYPE_UVEC4            :
-        case GLSL_TYPE_VEC4             : return 16;
-        case GLSL_TYPE_IVEC3            :
-        case GLSL_TYPE_UVEC3            :
-        case GLSL_TYPE_VEC3             : return 12;
-        case GLSL_TYPE_DVEC3            : return 24;
-        case GLSL_TYPE_DVEC4            : return 32;
-        case GLSL_TYPE_MAT2             : return 16;
-        case GLSL_TYPE_MAT3             : return 36;
-        case GLSL_TYPE_MAT4             : return 64;
-        case GLSL_TYPE_DMAT2            : return 32;
-        case GLSL_TYPE_DMAT3            : return 72;
-        case GLSL_TYPE_DMAT4            : return 128;
-        default                         : debug_log_fetal_error("size is not defined for glsl type \"%u\"\n", type);
-	};
-    return 0;
+    _ASSERT(type_traits_count > 0);
+    GLSL_INSTRUMENT_BEGIN();
+
+    u32 offset = 0;
+    u32 max_align = 1;
+    for(u32 i = 0; i < type_traits_count; i++)
+    {
+        AUTO member = get_member_layout_from_type_traits(type_traits[i], layout);
+        offset = u32_round_next_multiple(offset, member.align);
+        member.offset = offset;
+        offset += member.size;
+        if(max_align < member.align)
+            max_align = member.align;
+        if(out_members != NULL)
+            out_members[i] = member;
+    }
+
+    /* Extended Alignment: A structure has an extended alignment rounded up to a multiple of 16 */
+    if(layout == GLSL_MEMORY_LAYOUT_EXTENDED)
+        max_align = u32_round_next_multiple(max_align, 16);
+
+    glsl_struct_layout_t struct_layout;
+    struct_layout.align = max_align;
+    /* the struct is padded at the end so that the member following it (or the next array element) starts at a multiple of its alignment */
+    struct_layout.size = u32_round_next_multiple(offset, max_align);
+    struct_layout.array_stride = struct_layout.size;
+    GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_LAYOUTOF_STRUCT, 0);
+    return struct_layout;
 }
 
 /* copied from vulkan_core.h*/
@@ -540,42 +514,80 @@ typedef enum VkFormat {
     VK_FORMAT_MAX_ENUM = 0x7FFFFFFF
 } VkFormat;
 
-GLSLCOM_API u32 vkformatof_glsl_type(glsl_type_t type)
+GLSLCOM_API const u32 glsl_type_vkformat_table[GLSL_TYPE_MAX] =
+{
+	[GLSL_TYPE_U8] 		= VK_FORMAT_R8_UINT,
+	[GLSL_TYPE_U16] 	= VK_FORMAT_R16_UINT,
+	[GLSL_TYPE_U32]		= VK_FORMAT_R32_UINT,
+	[GLSL_TYPE_U64] 	= VK_FORMAT_R64_UINT,
+	[GLSL_TYPE_S8] 		= VK_FORMAT_R8_SINT,
+	[GLSL_TYPE_S16] 	= VK_FORMAT_R16_SINT,
+	[GLSL_TYPE_S32] 	= VK_FORMAT_R32_SINT,
+	[GLSL_TYPE_S64] 	= VK_FORMAT_R64_SINT,
+	[GLSL_TYPE_F32] 	= VK_FORMAT_R32_SFLOAT,
+	[GLSL_TYPE_F64] 	= VK_FORMAT_R64_SFLOAT,
+	[GLSL_TYPE_VEC2] 	= VK_FORMAT_R32G32_SFLOAT,
+	[GLSL_TYPE_VEC3] 	= VK_FORMAT_R32G32B32_SFLOAT,
+	[GLSL_TYPE_VEC4] 	= VK_FORMAT_R32G32B32A32_SFLOAT,
+	/* a matrix is fetched as one attribute (location) per column, so its format is the format of a column */
+	[GLSL_TYPE_MAT2] 	= VK_FORMAT_R32G32_SFLOAT,
+	[GLSL_TYPE_MAT3] 	= VK_FORMAT_R32G32B32_SFLOAT,
+	[GLSL_TYPE_MAT4]	= VK_FORMAT_R32G32B32A32_SFLOAT,
+
+	[GLSL_TYPE_IVEC2] 	= VK_FORMAT_R32G32_SINT,
+	[GLSL_TYPE_IVEC3] 	= VK_FORMAT_R32G32B32_SINT,
+	[GLSL_TYPE_IVEC4] 	= VK_FORMAT_R32G32B32A32_SINT,
+	[GLSL_TYPE_UVEC2] 	= VK_FORMAT_R32G32_UINT,
+	[GLSL_TYPE_UVEC3] 	= VK_FORMAT_R32G32B32_UINT,
+	[GLSL_TYPE_UVEC4] 	= VK_FORMAT_R32G32B32A32_UINT,
+	[GLSL_TYPE_DVEC2] 	= VK_FORMAT_R64G64_SFLOAT,
+	[GLSL_TYPE_DVEC3] 	= VK_FORMAT_R64G64B64_SFLOAT,
+	[GLSL_TYPE_DVEC4] 	= VK_FORMAT_R64G64B64A64_SFLOAT,
+	[GLSL_TYPE_DMAT2] 	= VK_FORMAT_R64G64_SFLOAT,
+	[GLSL_TYPE_DMAT3] 	= VK_FORMAT_R64G64B64_SFLOAT,
+	[GLSL_TYPE_DMAT4] 	= VK_FORMAT_R64G64B64A64_SFLOAT,
+
+	[GLSL_TYPE_F16] 	= VK_FORMAT_R16_SFLOAT,
+	[GLSL_TYPE_F16VEC2] = VK_FORMAT_R16G16_SFLOAT,
+	[GLSL_TYPE_F16VEC3] = VK_FORMAT_R16G16B16_SFLOAT,
+	[GLSL_TYPE_F16VEC4] = VK_FORMAT_R16G16B16A16_SFLOAT,
+	[GLSL_TYPE_I16VEC2] = VK_FORMAT_R16G16_SINT,
+	[GLSL_TYPE_I16VEC3] = VK_FORMAT_R16G16B16_SINT,
+	[GLSL_TYPE_I16VEC4] = VK_FORMAT_R16G16B16A16_SINT,
+	[GLSL_TYPE_U16VEC2] = VK_FORMAT_R16G16_UINT,
+	[GLSL_TYPE_U16VEC3] = VK_FORMAT_R16G16B16_UINT,
+	[GLSL_TYPE_U16VEC4] = VK_FORMAT_R16G16B16A16_UINT,
+	[GLSL_TYPE_I8VEC2] 	= VK_FORMAT_R8G8_SINT,
+	[GLSL_TYPE_I8VEC3] 	= VK_FORMAT_R8G8B8_SINT,
+	[GLSL_TYPE_I8VEC4] 	= VK_FORMAT_R8G8B8A8_SINT,
+	[GLSL_TYPE_U8VEC2] 	= VK_FORMAT_R8G8_UINT,
+	[GLSL_TYPE_U8VEC3] 	= VK_FORMAT_R8G8B8_UINT,
+	[GLSL_TYPE_U8VEC4] 	= VK_FORMAT_R8G8B8A8_UINT,
+
+	[GLSL_TYPE_MAT2X3] 	= VK_FORMAT_R32G32B32_SFLOAT,
+	[GLSL_TYPE_MAT2X4] 	= VK_FORMAT_R32G32B32A32_SFLOAT,
+	[GLSL_TYPE_MAT3X2] 	= VK_FORMAT_R32G32_SFLOAT,
+	[GLSL_TYPE_MAT3X4] 	= VK_FORMAT_R32G32B32A32_SFLOAT,
+	[GLSL_TYPE_MAT4X2] 	= VK_FORMAT_R32G32_SFLOAT,
+	[GLSL_TYPE_MAT4X3] 	= VK_FORMAT_R32G32B32_SFLOAT
+
+	/* opaque types (blocks, samplers and subpass inputs) have no VkFormat, so they remain VK_FORMAT_UNDEFINED */
+};
+
+#define GLSL_ENCODED_FORMAT_ENTRIES(R, RG, RGB, RGBA) \
+	{ [GLSL_TYPE_FLOAT] = (R), [GLSL_TYPE_VEC2] = (RG), [GLSL_TYPE_VEC3] = (RGB), [GLSL_TYPE_VEC4] = (RGBA) }
+
+GLSLCOM_API const u32 glsl_type_encoded_vkformat_table[GLSL_COMPONENT_ENCODING_MAX][GLSL_TYPE_MAX] =
+{
+	/* GLSL_COMPONENT_ENCODING_NATIVE is glsl_type_vkformat_table */
+	[GLSL_COMPONENT_ENCODING_HALF] 		= GLSL_ENCODED_FORMAT_ENTRIES(VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT),
+	[GLSL_COMPONENT_ENCODING_SNORM16] 	= GLSL_ENCODED_FORMAT_ENTRIES(VK_FORMAT_R16_SNORM, VK_FORMAT_R16G16_SNORM, VK_FORMAT_R16G16B16_SNORM, VK_FORMAT_R16G16B16A16_SNORM),
+	[GLSL_COMPONENT_ENCODING_SNORM8] 	= GLSL_ENCODED_FORMAT_ENTRIES(VK_FORMAT_R8_SNORM, VK_FORMAT_R8G8_SNORM, VK_FORMAT_R8G8B8_SNORM, VK_FORMAT_R8G8B8A8_SNORM),
+	[GLSL_COMPONENT_ENCODING_UNORM16] 	= GLSL_ENCODED_FORMAT_ENTRIES(VK_FORMAT_R16_UNORM, VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16B16_UNORM, VK_FORMAT_R16G16B16A16_UNORM),
+	[GLSL_COMPONENT_ENCODING_UNORM8] 	= GLSL_ENCODED_FORMAT_ENTRIES(VK_FORMAT_R8_UNORM, VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_R8G8B8A8_UNORM)
+};
+
+GLSLCOM_API void vkformatof_glsl_types(const glsl_type_t* types, u32 count, u32* out_formats)
 {
-	switch(type)
-	{
-		case GLSL_TYPE_U8 	: return VK_FORMAT_R8_UINT;
-		case GLSL_TYPE_U16 	: return VK_FORMAT_R16_UINT;
-		case GLSL_TYPE_U32	: return VK_FORMAT_R32_UINT;
-		case GLSL_TYPE_U64 	: return VK_FORMAT_R64_UINT;
-		case GLSL_TYPE_S8 	: return VK_FORMAT_R8_SINT;
-		case GLSL_TYPE_S16 	: return VK_FORMAT_R16_SINT;
-		case GLSL_TYPE_S32 	: return VK_FORMAT_R32_SINT;
-		case GLSL_TYPE_S64 	: return VK_FORMAT_R64_SINT;
-		case GLSL_TYPE_F32 	: return VK_FORMAT_R32_SFLOAT;
-		case GLSL_TYPE_F64 	: return VK_FORMAT_R64_SFLOAT;
-		case GLSL_TYPE_VEC2 : return VK_FORMAT_R32G32_SFLOAT;
-		case GLSL_TYPE_VEC3 : return VK_FORMAT_R32G32B32_SFLOAT;
-		case GLSL_TYPE_VEC4 : return VK_FORMAT_R32G32B32A32_SFLOAT;
-		case GLSL_TYPE_MAT2 : return VK_FORMAT_R32G32B32A32_SFLOAT;;
-		case GLSL_TYPE_MAT3 : return VK_FORMAT_R32G32B32A32_SFLOAT;
-		case GLSL_TYPE_MAT4	: return VK_FORMAT_R32G32B32A32_SFLOAT;
-
-		case GLSL_TYPE_IVEC2 : return VK_FORMAT_R32G32_SINT;
-		case GLSL_TYPE_IVEC3 : return VK_FORMAT_R32G32B32_SINT;
-		case GLSL_TYPE_IVEC4 : return VK_FORMAT_R32G32B32A32_SINT;
-		case GLSL_TYPE_UVEC2 : return VK_FORMAT_R32G32_UINT;
-		case GLSL_TYPE_UVEC3 : return VK_FORMAT_R32G32B32_UINT;
-		case GLSL_TYPE_UVEC4 : return VK_FORMAT_R32G32B32A32_UINT;
-
-		case GLSL_TYPE_BLOCK 			:
-		case GLSL_TYPE_UNIFORM_BUFFER 	:
-		case GLSL_TYPE_STORAGE_BUFFER 	:
-		case GLSL_TYPE_PUSH_CONSTANT 	:
-		case GLSL_TYPE_SAMPLER_2D		:
-		case GLSL_TYPE_SAMPLER_3D		:
-		case GLSL_TYPE_SAMPLER_CUBE		:
-		case GLSL_TYPE_SUBPASS_INPUT	: return VK_FORMAT_UNDEFINED;
-	}
-	return VK_FORMAT_UNDEFINED;
+    lookup_glsl_types(glsl_type_vkformat_table, types, count, out_formats);
 }
@@ -0,0 +1,152 @@
+#include <glslcommon/glsl_uniform_ring.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <stdatomic.h> /* atomic_uint_least64_t, atomic_compare_exchange_weak_explicit */
+#include <stdlib.h> /* calloc, free */
+
+struct glsl_uniform_ring_t
+{
+	u8* mapped_data;
+	/* a multiple of chunk_size, so chunks never wrap around the end of the buffer */
+	u32 size;
+	u32 min_offset_alignment;
+	u32 chunk_size;
+	u32 frame_count;
+	u32 frame_slot;
+	/* number of glsl_uniform_ring_begin_frame() calls */
+	u64 frame;
+	/* positions in the ring only grow, (position % size) is the offset in the buffer;
+	 * [tail, head) is the memory of the frames in flight, head is only moved by chunk acquisitions (by any thread) */
+	atomic_uint_least64_t head;
+	/* only moved by glsl_uniform_ring_begin_frame(), when no thread allocates */
+	u64 tail;
+	/* head at the end of the frame which last used each slot */
+	u64* frame_ends;
+};
+
+static inline bool is_power_of_two(u32 value)
+{
+	return (value != 0) && ((value & (value - 1)) == 0);
+}
+
+GLSLCOM_API glsl_uniform_ring_t* glsl_uniform_ring_create(void* mapped_data, u32 size, u32 min_offset_alignment, u32 chunk_size, u32 frame_count)
+{
+	if(!is_power_of_two(min_offset_alignment) || !is_power_of_two(chunk_size) || (chunk_size < min_offset_alignment) || (size < chunk_size) || (frame_count == 0))
+	{
+		debug_log_error("[GLSLCommon] Invalid uniform ring parameters: size %u, minimum offset alignment %u, chunk size %u, frame count %u", size, min_offset_alignment, chunk_size, frame_count);
+		return NULL;
+	}
+	glsl_uniform_ring_t* ring = calloc(1, sizeof(glsl_uniform_ring_t) + sizeof(u64) * frame_count);
+	if(ring == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_uniform_ring_t");
+		return NULL;
+	}
+	ring->mapped_data = mapped_data;
+	ring->size = size - (size % chunk_size);
+	ring->min_offset_alignment = min_offset_alignment;
+	ring->chunk_size = chunk_size;
+	ring->frame_count = frame_count;
+	atomic_init(&ring->head, 0);
+	ring->frame_ends = (u64*)(ring + 1);
+	return ring;
+}
+
+GLSLCOM_API void glsl_uniform_ring_destroy(glsl_uniform_ring_t* ring)
+{
+	free(ring);
+}
+
+GLSLCOM_API void glsl_uniform_ring_begin_frame(glsl_uniform_ring_t* ring, u32 frame_slot)
+{
+	_ASSERT(frame_slot < ring->frame_count);
+	u64 head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	ring->frame_ends[ring->frame_slot] = head;
+	/* the GPU is done with everything allocated up to the end of the frame which last used this slot */
+	if(ring->tail < ring->frame_ends[frame_slot])
+		ring->tail = ring->frame_ends[frame_slot];
+	ring->frame_slot = frame_slot;
+	ring->frame++;
+}
+
+GLSLCOM_API u32 glsl_uniform_ring_get_used_size(const glsl_uniform_ring_t* ring)
+{
+	return (u32)(atomic_load_explicit(&((glsl_uniform_ring_t*)ring)->head, memory_order_relaxed) - ring->tail);
+}
+
+GLSLCOM_API glsl_uniform_block_alloc_t glsl_uniform_ring_get_block_alloc(const glsl_uniform_ring_t* ring, glsl_struct_layout_t struct_layout, u32 count)
+{
+	_ASSERT(is_power_of_two(struct_layout.align));
+	glsl_uniform_block_alloc_t block_alloc;
+	block_alloc.size = (count <= 1) ? struct_layout.size : (struct_layout.array_stride * count);
+	block_alloc.align = (struct_layout.align > ring->min_offset_alignment) ? struct_layout.align : ring->min_offset_alignment;
+	return block_alloc;
+}
+
+GLSLCOM_API void glsl_uniform_ring_chunk_reset(glsl_uniform_ring_chunk_t* chunk, glsl_uniform_ring_t* ring)
+{
+	chunk->ring = ring;
+	chunk->mapped_data = ring->mapped_data;
+	chunk->cursor = 0;
+	chunk->end = 0;
+	chunk->frame = ring->frame;
+}
+
+#ifdef GLSLCOM_DEBUG
+GLSLCOM_API void glsl_uniform_ring_check_chunk(const glsl_uniform_ring_chunk_t* chunk)
+{
+	if((chunk->ring == NULL) || (chunk->frame != chunk->ring->frame))
+		debug_log_fetal_error("[GLSLCommon] Uniform ring chunk is used without being reset in the current frame");
+}
+#endif /* GLSLCOM_DEBUG */
+
+/* moves the head past 'span_size' bytes (a multiple of the chunk size) which don't wrap around the end of the buffer,
+ * returns false if that would overwrite the memory of a frame in flight */
+static bool acquire_span(glsl_uniform_ring_t* ring, u32 span_size, u64* out_start)
+{
+	u64 head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	for(;;)
+	{
+		u64 start = head;
+		u32 offset = (u32)(start % ring->size);
+		/* the end of the buffer is skipped, it only happens for spans of several chunks */
+		if((ring->size - offset) < span_size)
+			start += ring->size - offset;
+		u64 end = start + span_size;
+		if((end - ring->tail) > ring->size)
+			return false;
+		if(atomic_compare_exchange_weak_explicit(&ring->head, &head, end, memory_order_relaxed, memory_order_relaxed))
+		{
+			*out_start = start;
+			return true;
+		}
+	}
+}
+
+GLSLCOM_API void* glsl_uniform_ring_alloc_slow(glsl_uniform_ring_chunk_t* chunk, u32 size, u32 align, u32* out_offset)
+{
+	glsl_uniform_ring_t* ring = chunk->ring;
+	/* chunks start at multiples of the chunk size, so they satisfy any smaller alignment */
+	if(!is_power_of_two(align) || (align > ring->chunk_size))
+	{
+		debug_log_error("[GLSLCommon] Uniform ring alignment %u must be a power of two no larger than the chunk size %u", align, ring->chunk_size);
+		return NULL;
+	}
+	u64 span_size = (size <= ring->chunk_size) ? ring->chunk_size : U32_NEXT_MULTIPLE((u64)size, ring->chunk_size);
+	u64 start;
+	if((span_size > ring->size) || !acquire_span(ring, (u32)span_size, &start))
+	{
+		debug_log_error("[GLSLCommon] Uniform ring of %u bytes is full, %u bytes are used by the frames in flight", ring->size, glsl_uniform_ring_get_used_size(ring));
+		return NULL;
+	}
+	u32 offset = (u32)(start % ring->size);
+	/* larger allocations get a run of chunks of their own, the current chunk keeps its free space */
+	if(span_size == ring->chunk_size)
+	{
+		chunk->cursor = offset + size;
+		chunk->end = offset + span_size;
+	}
+	*out_offset = offset;
+	return ring->mapped_data + offset;
+}
@@ -0,0 +1,173 @@
+#include <glslcommon/glsl_vertex_layout.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+
+static u32 get_input_binding(const glsl_vertex_input_t* inputs, u32 index, glsl_vertex_stream_mode_t stream_mode)
+{
+	switch(stream_mode)
+	{
+		case GLSL_VERTEX_STREAMS_INTERLEAVED: return 0;
+		case GLSL_VERTEX_STREAMS_SPLIT: return index;
+		default: return inputs[index].binding;
+	}
+}
+
+/* size (in bytes) of a component of the input as stored in the vertex buffer */
+static u32 get_input_component_size(const glsl_vertex_input_t* input)
+{
+	if(input->encoding == GLSL_COMPONENT_ENCODING_NATIVE)
+		return alignof_glsl_type(input->type, GLSL_SCALAR);
+	return sizeof_glsl_component_encoding(input->encoding);
+}
+
+/* returns the index of 'binding' in the sorted 'bindings' */
+static u32 find_binding(const glsl_vertex_binding_desc_t* bindings, u32 binding_count, u32 binding)
+{
+	u32 low = 0;
+	u32 high = binding_count;
+	while(low < high)
+	{
+		u32 mid = low + ((high - low) >> 1);
+		if(bindings[mid].binding < binding)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	_ASSERT((low < binding_count) && (bindings[low].binding == binding));
+	return low;
+}
+
+GLSLCOM_API glsl_vertex_layout_t* glsl_vertex_layout_create(const glsl_vertex_input_t* inputs, u32 input_count, glsl_vertex_stream_mode_t stream_mode, const glsl_allocator_t* allocator)
+{
+	u32 attribute_count = 0;
+	for(u32 i = 0; i < input_count; i++)
+	{
+		glsl_type_t type = inputs[i].type;
+		/* the table is read directly, as the debug lookups treat undefined sizes as fatal errors */
+		if((type == GLSL_TYPE_UNDEFINED) || (type >= GLSL_TYPE_MAX_NON_OPAQUE) || ((u32)inputs[i].encoding >= GLSL_COMPONENT_ENCODING_MAX)
+			|| (vkformatof_glsl_type_encoded(type, inputs[i].encoding) == 0) || (glsl_type_size_table[GLSL_SCALAR][false][type] == 0))
+		{
+			debug_log_error("[GLSLCommon] Vertex input %u has a type which can't be a vertex input", i);
+			return NULL;
+		}
+		attribute_count += columnsof_glsl_type(type);
+	}
+
+	glsl_vertex_layout_t* layout = glsl_allocator_alloc_object(allocator, sizeof(glsl_vertex_layout_t)
+										+ sizeof(glsl_vertex_attribute_desc_t) * attribute_count
+										+ sizeof(glsl_vertex_binding_desc_t) * input_count
+										+ sizeof(u32) * input_count * 3);
+	if(layout == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for glsl_vertex_layout_t");
+		return NULL;
+	}
+	glsl_vertex_attribute_desc_t* attributes = (glsl_vertex_attribute_desc_t*)(layout + 1);
+	glsl_vertex_binding_desc_t* bindings = (glsl_vertex_binding_desc_t*)(attributes + attribute_count);
+	u32* input_locations = (u32*)(bindings + input_count);
+	u32* input_bindings = input_locations + input_count;
+	u32* input_offsets = input_bindings + input_count;
+
+	/* unique bindings sorted by binding number (insertion sort, there are only a handful of them),
+	 * 'stride' accumulates the packed size and 'input_rate' the rate of the first input of the binding until the strides are final */
+	u32 binding_count = 0;
+	for(u32 i = 0; i < input_count; i++)
+	{
+		u32 binding = get_input_binding(inputs, i, stream_mode);
+		input_bindings[i] = binding;
+		u32 j = binding_count;
+		while((j > 0) && (bindings[j - 1].binding >= binding))
+			j--;
+		if((j < binding_count) && (bindings[j].binding == binding))
+		{
+			if(bindings[j].input_rate != (u32)inputs[i].input_rate)
+			{
+				debug_log_error("[GLSLCommon] Vertex input %u has a different input rate than the other inputs of binding %u", i, binding);
+				glsl_allocator_free_object(layout);
+				return NULL;
+			}
+			continue;
+		}
+		for(u32 k = binding_count; k > j; k--)
+			bindings[k] = bindings[k - 1];
+		bindings[j].binding = binding;
+		bindings[j].stride = 0;
+		bindings[j].input_rate = (u32)inputs[i].input_rate;
+		binding_count++;
+	}
+
+	/* explicit locations are kept, automatic ones continue after the highest location assigned so far */
+	u32 next_location = 0;
+	for(u32 i = 0; i < input_count; i++)
+	{
+		u32 location = (inputs[i].location == GLSL_VERTEX_LOCATION_AUTO) ? next_location : inputs[i].location;
+		input_locations[i] = location;
+		u32 end = location + locationsof_glsl_type(inputs[i].type);
+		if(next_location < end)
+			next_location = end;
+	}
+	for(u32 i = 0; i < input_count; i++)
+	{
+		u32 end = input_locations[i] + locationsof_glsl_type(inputs[i].type);
+		for(u32 j = 0; j < i; j++)
+		{
+			if((input_locations[i] < (input_locations[j] + locationsof_glsl_type(inputs[j].type))) && (input_locations[j] < end))
+			{
+				debug_log_error("[GLSLCommon] Locations of vertex inputs %u and %u overlap", j, i);
+				glsl_allocator_free_object(layout);
+				return NULL;
+			}
+		}
+	}
+
+	u32 attribute_index = 0;
+	for(u32 i = 0; i < input_count; i++)
+	{
+		glsl_type_t type = inputs[i].type;
+		glsl_vertex_binding_desc_t* binding = &bindings[find_binding(bindings, binding_count, input_bindings[i])];
+		u32 align = get_input_component_size(&inputs[i]);
+		u32 offset = u32_round_next_multiple(binding->stride, align);
+		input_offsets[i] = offset;
+
+		u32 column_count = columnsof_glsl_type(type);
+		u32 column_size = sizeof_glsl_type_encoded(type, inputs[i].encoding) / column_count;
+		u32 column_locations = locationsof_glsl_type(type) / column_count;
+		for(u32 j = 0; j < column_count; j++)
+		{
+			glsl_vertex_attribute_desc_t* attribute = &attributes[attribute_index++];
+			attribute->location = input_locations[i] + j * column_locations;
+			attribute->binding = binding->binding;
+			attribute->format = vkformatof_glsl_type_encoded(type, inputs[i].encoding);
+			attribute->offset = offset + j * column_size;
+		}
+		binding->stride = offset + column_count * column_size;
+	}
+
+	/* each vertex (or instance) of a binding starts at a multiple of the largest component size in it, and of 4 bytes */
+	for(u32 i = 0; i < binding_count; i++)
+	{
+		u32 max_align = 4;
+		for(u32 j = 0; j < input_count; j++)
+		{
+			u32 align = get_input_component_size(&inputs[j]);
+			if((input_bindings[j] == bindings[i].binding) && (max_align < align))
+				max_align = align;
+		}
+		bindings[i].stride = u32_round_next_multiple(bindings[i].stride, max_align);
+	}
+
+	layout->attribute_count = attribute_count;
+	layout->attributes = attributes;
+	layout->binding_count = binding_count;
+	layout->bindings = bindings;
+	layout->input_locations = input_locations;
+	layout->input_bindings = input_bindings;
+	layout->input_offsets = input_offsets;
+	return layout;
+}
+
+GLSLCOM_API void glsl_vertex_layout_destroy(glsl_vertex_layout_t* layout)
+{
+	glsl_allocator_free_object(layout);
+}
@@ -0,0 +1,269 @@
+#include <glslcommon/glsl_vertex_stream.h>
+#include <glslcommon/glsl_instrument.h>
+#include <glslcommon/debug.h>
+#include <glslcommon/assert.h> /* _ASSERT */
+
+#include <string.h> /* memcpy */
+
+#if defined(__SSE2__) || defined(_M_X64)
+#	define GLSLCOM_VERTEX_STREAM_SSE2
+#	include <emmintrin.h>
+#endif
+
+/* vertices are (de)interleaved in blocks of this many, so the streams and the vertices of a block stay in the L1 cache while every stream is copied */
+#define VERTEX_BLOCK_SIZE 256
+/* jobs start at multiples of this many vertices, so no two jobs write into the same cache line of the streams */
+#define VERTEX_JOB_GRANULARITY 64
+
+/* copies 'count' elements of 'SIZE' bytes, a constant size lets the compiler turn memcpy into a few moves */
+#define COPY_STRIDED_CASE(SIZE) \
+	case SIZE: \
+	{ \
+		for(u32 i = 0; i < count; i++) \
+			memcpy(dst + i * dst_stride, src + i * src_stride, SIZE); \
+		break; \
+	}
+
+static void copy_strided(u8* dst, u32 dst_stride, const u8* src, u32 src_stride, u32 element_size, u32 count)
+{
+	switch(element_size)
+	{
+		COPY_STRIDED_CASE(4)
+		COPY_STRIDED_CASE(8)
+		COPY_STRIDED_CASE(12)
+		COPY_STRIDED_CASE(16)
+		COPY_STRIDED_CASE(24)
+		COPY_STRIDED_CASE(32)
+		COPY_STRIDED_CASE(36)
+		COPY_STRIDED_CASE(48)
+		COPY_STRIDED_CASE(64)
+		default:
+		{
+			for(u32 i = 0; i < count; i++)
+				memcpy(dst + i * dst_stride, src + i * src_stride, element_size);
+			break;
+		}
+	}
+}
+
+#ifdef GLSLCOM_VERTEX_STREAM_SSE2
+/* returns true if the streams are a vec3 position at 0, a vec3 normal at 12 and a vec2 uv at 24 of a 32 byte vertex, all of them 32 bit floats */
+static bool is_p3n3t2(const glsl_vertex_stream_t* streams, u32 stream_count, u32 stride)
+{
+	return (stride == 32) && (stream_count == 3)
+		&& (streams[0].encoding == GLSL_COMPONENT_ENCODING_NATIVE) && (streams[1].encoding == GLSL_COMPONENT_ENCODING_NATIVE) && (streams[2].encoding == GLSL_COMPONENT_ENCODING_NATIVE)
+		&& (streams[0].type == GLSL_TYPE_VEC3) && (streams[0].offset == 0)
+		&& (streams[1].type == GLSL_TYPE_VEC3) && (streams[1].offset == 12)
+		&& (streams[2].type == GLSL_TYPE_VEC2) && (streams[2].offset == 24);
+}
+
+/* 4 vertices at a time: 3 + 3 + 2 loads are shuffled into 8 stores */
+static u32 interleave_p3n3t2_sse2(u8* dst, const f32* positions, const f32* normals, const f32* uvs, u32 count)
+{
+	u32 i = 0;
+	for(; (i + 4) <= count; i += 4)
+	{
+		__m128 p0 = _mm_loadu_ps(positions + i * 3 + 0);
+		__m128 p1 = _mm_loadu_ps(positions + i * 3 + 4);
+		__m128 p2 = _mm_loadu_ps(positions + i * 3 + 8);
+		__m128 n0 = _mm_loadu_ps(normals + i * 3 + 0);
+		__m128 n1 = _mm_loadu_ps(normals + i * 3 + 4);
+		__m128 n2 = _mm_loadu_ps(normals + i * 3 + 8);
+		__m128 t0 = _mm_loadu_ps(uvs + i * 2 + 0);
+		__m128 t1 = _mm_loadu_ps(uvs + i * 2 + 4);
+		f32* v = (f32*)(dst + i * 32);
+
+		__m128 a = _mm_shuffle_ps(p0, n0, _MM_SHUFFLE(0, 0, 2, 2));
+		_mm_storeu_ps(v + 0, _mm_shuffle_ps(p0, a, _MM_SHUFFLE(2, 0, 1, 0)));
+		_mm_storeu_ps(v + 4, _mm_shuffle_ps(n0, t0, _MM_SHUFFLE(1, 0, 2, 1)));
+
+		a = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 3, 3));
+		__m128 b = _mm_shuffle_ps(p1, n0, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(v + 8, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(v + 12, _mm_shuffle_ps(n1, t0, _MM_SHUFFLE(3, 2, 1, 0)));
+
+		a = _mm_shuffle_ps(p2, n1, _MM_SHUFFLE(2, 2, 0, 0));
+		_mm_storeu_ps(v + 16, _mm_shuffle_ps(p1, a, _MM_SHUFFLE(2, 0, 3, 2)));
+		a = _mm_shuffle_ps(n1, n2, _MM_SHUFFLE(0, 0, 3, 3));
+		_mm_storeu_ps(v + 20, _mm_shuffle_ps(a, t1, _MM_SHUFFLE(1, 0, 2, 0)));
+
+		a = _mm_shuffle_ps(p2, n2, _MM_SHUFFLE(1, 1, 3, 3));
+		_mm_storeu_ps(v + 24, _mm_shuffle_ps(p2, a, _MM_SHUFFLE(2, 0, 2, 1)));
+		_mm_storeu_ps(v + 28, _mm_shuffle_ps(n2, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+	}
+	return i;
+}
+
+/* reverse of interleave_p3n3t2_sse2() */
+static u32 deinterleave_p3n3t2_sse2(const u8* src, f32* positions, f32* normals, f32* uvs, u32 count)
+{
+	u32 i = 0;
+	for(; (i + 4) <= count; i += 4)
+	{
+		const f32* v = (const f32*)(src + i * 32);
+		__m128 v0 = _mm_loadu_ps(v + 0);
+		__m128 v1 = _mm_loadu_ps(v + 4);
+		__m128 v2 = _mm_loadu_ps(v + 8);
+		__m128 v3 = _mm_loadu_ps(v + 12);
+		__m128 v4 = _mm_loadu_ps(v + 16);
+		__m128 v5 = _mm_loadu_ps(v + 20);
+		__m128 v6 = _mm_loadu_ps(v + 24);
+		__m128 v7 = _mm_loadu_ps(v + 28);
+
+		__m128 a = _mm_shuffle_ps(v0, v2, _MM_SHUFFLE(0, 0, 2, 2));
+		_mm_storeu_ps(positions + i * 3 + 0, _mm_shuffle_ps(v0, a, _MM_SHUFFLE(2, 0, 1, 0)));
+		_mm_storeu_ps(positions + i * 3 + 4, _mm_shuffle_ps(v2, v4, _MM_SHUFFLE(1, 0, 2, 1)));
+		a = _mm_shuffle_ps(v4, v6, _MM_SHUFFLE(0, 0, 2, 2));
+		_mm_storeu_ps(positions + i * 3 + 8, _mm_shuffle_ps(a, v6, _MM_SHUFFLE(2, 1, 2, 0)));
+
+		a = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 3, 3));
+		__m128 b = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(normals + i * 3 + 0, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+		a = _mm_shuffle_ps(v4, v5, _MM_SHUFFLE(0, 0, 3, 3));
+		_mm_storeu_ps(normals + i * 3 + 4, _mm_shuffle_ps(v3, a, _MM_SHUFFLE(2, 0, 1, 0)));
+		a = _mm_shuffle_ps(v5, v6, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(normals + i * 3 + 8, _mm_shuffle_ps(a, v7, _MM_SHUFFLE(1, 0, 2, 0)));
+
+		_mm_storeu_ps(uvs + i * 2 + 0, _mm_shuffle_ps(v1, v3, _MM_SHUFFLE(3, 2, 3, 2)));
+		_mm_storeu_ps(uvs + i * 2 + 4, _mm_shuffle_ps(v5, v7, _MM_SHUFFLE(3, 2, 3, 2)));
+	}
+	return i;
+}
+#endif /* GLSLCOM_VERTEX_STREAM_SSE2 */
+
+/* arguments of one (de)interleaving, shared by all of its jobs */
+typedef struct vertex_stream_job_t
+{
+	u8* vertices;
+	u32 stride;
+	const glsl_vertex_stream_t* streams;
+	u32 stream_count;
+	u32 vertex_count;
+	u32 job_vertex_count;
+} vertex_stream_job_t;
+
+static void interleave_range(const vertex_stream_job_t* job, u32 first, u32 count)
+{
+	u8* dst = job->vertices + (u64)first * job->stride;
+	u32 done = 0;
+#ifdef GLSLCOM_VERTEX_STREAM_SSE2
+	if(is_p3n3t2(job->streams, job->stream_count, job->stride))
+		done = interleave_p3n3t2_sse2(dst, (const f32*)job->streams[0].data + (u64)first * 3, (const f32*)job->streams[1].data + (u64)first * 3, (const f32*)job->streams[2].data + (u64)first * 2, count);
+#endif /* GLSLCOM_VERTEX_STREAM_SSE2 */
+	for(u32 block = done; block < count; block += VERTEX_BLOCK_SIZE)
+	{
+		u32 block_count = ((count - block) < VERTEX_BLOCK_SIZE) ? (count - block) : VERTEX_BLOCK_SIZE;
+		for(u32 i = 0; i < job->stream_count; i++)
+		{
+			const glsl_vertex_stream_t* stream = &job->streams[i];
+			u32 element_size = sizeof_glsl_type_encoded(stream->type, stream->encoding);
+			copy_strided(dst + (u64)block * job->stride + stream->offset, job->stride, (const u8*)stream->data + (u64)(first + block) * element_size, element_size, element_size, block_count);
+		}
+	}
+}
+
+static void deinterleave_range(const vertex_stream_job_t* job, u32 first, u32 count)
+{
+	const u8* src = job->vertices + (u64)first * job->stride;
+	u32 done = 0;
+#ifdef GLSLCOM_VERTEX_STREAM_SSE2
+	if(is_p3n3t2(job->streams, job->stream_count, job->stride))
+		done = deinterleave_p3n3t2_sse2(src, (f32*)job->streams[0].data + (u64)first * 3, (f32*)job->streams[1].data + (u64)first * 3, (f32*)job->streams[2].data + (u64)first * 2, count);
+#endif /* GLSLCOM_VERTEX_STREAM_SSE2 */
+	for(u32 block = done; block < count; block += VERTEX_BLOCK_SIZE)
+	{
+		u32 block_count = ((count - block) < VERTEX_BLOCK_SIZE) ? (count - block) : VERTEX_BLOCK_SIZE;
+		for(u32 i = 0; i < job->stream_count; i++)
+		{
+			const glsl_vertex_stream_t* stream = &job->streams[i];
+			u32 element_size = sizeof_glsl_type_encoded(stream->type, stream->encoding);
+			copy_strided((u8*)stream->data + (u64)(first + block) * element_size, element_size, src + (u64)block * job->stride + stream->offset, job->stride, element_size, block_count);
+		}
+	}
+}
+
+static u32 get_job_count(const vertex_stream_job_t* job, u32 job_index, u32* out_first)
+{
+	u32 first = job_index * job->job_vertex_count;
+	*out_first = first;
+	return ((job->vertex_count - first) < job->job_vertex_count) ? (job->vertex_count - first) : job->job_vertex_count;
+}
+
+static void interleave_job(void* job_data, u32 job_index)
+{
+	u32 first;
+	u32 count = get_job_count(job_data, job_index, &first);
+	interleave_range(job_data, first, count);
+}
+
+static void deinterleave_job(void* job_data, u32 job_index)
+{
+	u32 first;
+	u32 count = get_job_count(job_data, job_index, &first);
+	deinterleave_range(job_data, first, count);
+}
+
+static void run_jobs(vertex_stream_job_t* job, glsl_job_fn_t job_fn, const glsl_job_dispatcher_t* dispatcher)
+{
+	u32 job_count = 1;
+	if((dispatcher != NULL) && (dispatcher->max_job_count > 1))
+	{
+		job_count = job->vertex_count / GLSL_VERTEX_STREAM_MIN_JOB_VERTEX_COUNT;
+		if(job_count > dispatcher->max_job_count)
+			job_count = dispatcher->max_job_count;
+	}
+	if(job_count <= 1)
+	{
+		job->job_vertex_count = job->vertex_count;
+		job_fn(job, 0);
+		return;
+	}
+	job->job_vertex_count = u32_round_next_multiple((job->vertex_count + job_count - 1) / job_count, VERTEX_JOB_GRANULARITY);
+	job_count = (job->vertex_count + job->job_vertex_count - 1) / job->job_vertex_count;
+	dispatcher->dispatch(dispatcher->user_data, job_fn, job, job_count);
+}
+
+#ifdef GLSLCOM_INSTRUMENTATION
+/* returns the number of bytes the streams of a single vertex hold */
+static u64 get_stream_vertex_size(const glsl_vertex_stream_t* streams, u32 stream_count)
+{
+	u64 size = 0;
+	for(u32 i = 0; i < stream_count; i++)
+		size += sizeof_glsl_type_encoded(streams[i].type, streams[i].encoding);
+	return size;
+}
+#endif /* GLSLCOM_INSTRUMENTATION */
+
+#ifdef GLSLCOM_DEBUG
+static void check_streams(const glsl_vertex_stream_t* streams, u32 stream_count, u32 stride)
+{
+	for(u32 i = 0; i < stream_count; i++)
+	{
+		if((streams[i].offset + sizeof_glsl_type_encoded(streams[i].type, streams[i].encoding)) > stride)
+			debug_log_fetal_error("[GLSLCommon] Vertex stream %u doesn't fit in a vertex of %u bytes", i, stride);
+	}
+}
+#endif /* GLSLCOM_DEBUG */
+
+GLSLCOM_API void glsl_vertex_interleave(void* dst, u32 dst_stride, const glsl_vertex_stream_t* streams, u32 stream_count, u32 vertex_count, const glsl_job_dispatcher_t* dispatcher)
+{
+#ifdef GLSLCOM_DEBUG
+	check_streams(streams, stream_count, dst_stride);
+#endif /* GLSLCOM_DEBUG */
+	GLSL_INSTRUMENT_BEGIN();
+	vertex_stream_job_t job = { dst, dst_stride, streams, stream_count, vertex_count, 0 };
+	run_jobs(&job, interleave_job, dispatcher);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_VERTEX_INTERLEAVE, (u64)dst_stride * vertex_count);
+}
+
+GLSLCOM_API void glsl_vertex_deinterleave(const void* src, u32 src_stride, const glsl_vertex_stream_t* streams, u32 stream_count, u32 vertex_count, const glsl_job_dispatcher_t* dispatcher)
+{
+#ifdef GLSLCOM_DEBUG
+	check_streams(streams, stream_count, src_stride);
+#endif /* GLSLCOM_DEBUG */
+	/* the vertices are only read, the cast just lets both directions share vertex_stream_job_t */
+	GLSL_INSTRUMENT_BEGIN();
+	vertex_stream_job_t job = { (u8*)src, src_stride, streams, stream_count, vertex_count, 0 };
+	run_jobs(&job, deinterleave_job, dispatcher);
+	GLSL_INSTRUMENT_END(GLSL_INSTRUMENT_API_VERTEX_DEINTERLEAVE, get_stream_vertex_size(streams, stream_count) * vertex_count);
+}
@@ -1,10 +1,1131 @@
+/* main: layout analysis of uniform and storage blocks
+ *
+ * $ main [--layout scalar|std140|std430] [--top <count>] [--summary] <file>...
+ *
+ * Reads struct and block declarations from GLSL-like files and prints, for each block and layout (the declared one first), the offset, size,
+ * alignment and array stride of every member along with the total size, the bytes (and percentage) lost to padding and the layout fingerprint
+ * (blocks with equal fingerprints are layout compatible, see glsl_fingerprint.h);
+ * then ranks the blocks of all files by the padding bytes of their declared layout and prints the worst --top (10 by default) of them,
+ * along with the size they would have with their members reordered by glsl_optimize_member_order().
+ * The declared layout is the one of the layout qualifiers (std140, std430 or scalar), otherwise std140 for uniform blocks (and 'block')
+ * and std430 for buffer and push_constant blocks; --layout analyses every block under the given layout instead.
+ *
+ *	#define MAX_LIGHTS 8
+ *	struct Light { vec3 position; float range; mat4 shadow[2]; };
+ *	layout(std140) uniform Lights { Light lights[MAX_LIGHTS]; vec3 ambient; } u_lights;
+ *	layout(std430, row_major) buffer Skinning { mat3x4 bones[64]; layout(column_major) mat4 world; };
+ *	block Material { f16vec4 color; float roughness, metallic; };
+ *
+ * 'uniform' and 'buffer' blocks (and 'block', for files which only describe layouts) are analysed, structs are only usable as member types;
+ * everything else (functions, samplers, qualifiers other than the layouts, row_major and column_major) is skipped;
+ * array lengths may be integer constant expressions of literals, integer #defines and global 'const int' (or uint) constants.
+ * A declaration with an error is reported and skipped, parsing resumes after the member or declaration the error is in.
+ * --summary prints only the ranking, which is what is wanted over a whole shader library. */
 
 #include <glslcommon/debug.h>
 #include <glslcommon/assert.h>
+#include <glslcommon/glsl_types.h>
+#include <glslcommon/glsl_layout_tree.h>
+#include <glslcommon/glsl_member_order.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TOKEN_LENGTH 128
+
+static const struct { const char* name; glsl_type_t type; } type_names[] =
+{
+	{ "float", GLSL_TYPE_FLOAT }, { "int", GLSL_TYPE_INT }, { "uint", GLSL_TYPE_UINT }, { "double", GLSL_TYPE_DOUBLE },
+	{ "vec2", GLSL_TYPE_VEC2 }, { "vec3", GLSL_TYPE_VEC3 }, { "vec4", GLSL_TYPE_VEC4 },
+	{ "ivec2", GLSL_TYPE_IVEC2 }, { "ivec3", GLSL_TYPE_IVEC3 }, { "ivec4", GLSL_TYPE_IVEC4 },
+	{ "uvec2", GLSL_TYPE_UVEC2 }, { "uvec3", GLSL_TYPE_UVEC3 }, { "uvec4", GLSL_TYPE_UVEC4 },
+	{ "dvec2", GLSL_TYPE_DVEC2 }, { "dvec3", GLSL_TYPE_DVEC3 }, { "dvec4", GLSL_TYPE_DVEC4 },
+	{ "mat2", GLSL_TYPE_MAT2 }, { "mat3", GLSL_TYPE_MAT3 }, { "mat4", GLSL_TYPE_MAT4 },
+	{ "mat2x2", GLSL_TYPE_MAT2 }, { "mat3x3", GLSL_TYPE_MAT3 }, { "mat4x4", GLSL_TYPE_MAT4 },
+	{ "mat2x3", GLSL_TYPE_MAT2X3 }, { "mat2x4", GLSL_TYPE_MAT2X4 }, { "mat3x2", GLSL_TYPE_MAT3X2 },
+	{ "mat3x4", GLSL_TYPE_MAT3X4 }, { "mat4x2", GLSL_TYPE_MAT4X2 }, { "mat4x3", GLSL_TYPE_MAT4X3 },
+	{ "dmat2", GLSL_TYPE_DMAT2 }, { "dmat3", GLSL_TYPE_DMAT3 }, { "dmat4", GLSL_TYPE_DMAT4 },
+	{ "int8_t", GLSL_TYPE_INT8 }, { "uint8_t", GLSL_TYPE_UINT8 }, { "int16_t", GLSL_TYPE_INT16 }, { "uint16_t", GLSL_TYPE_UINT16 },
+	{ "float16_t", GLSL_TYPE_FLOAT16 }, { "int64_t", GLSL_TYPE_INT64 }, { "uint64_t", GLSL_TYPE_UINT64 },
+	{ "f16vec2", GLSL_TYPE_F16VEC2 }, { "f16vec3", GLSL_TYPE_F16VEC3 }, { "f16vec4", GLSL_TYPE_F16VEC4 },
+	{ "i16vec2", GLSL_TYPE_I16VEC2 }, { "i16vec3", GLSL_TYPE_I16VEC3 }, { "i16vec4", GLSL_TYPE_I16VEC4 },
+	{ "u16vec2", GLSL_TYPE_U16VEC2 }, { "u16vec3", GLSL_TYPE_U16VEC3 }, { "u16vec4", GLSL_TYPE_U16VEC4 },
+	{ "i8vec2", GLSL_TYPE_I8VEC2 }, { "i8vec3", GLSL_TYPE_I8VEC3 }, { "i8vec4", GLSL_TYPE_I8VEC4 },
+	{ "u8vec2", GLSL_TYPE_U8VEC2 }, { "u8vec3", GLSL_TYPE_U8VEC3 }, { "u8vec4", GLSL_TYPE_U8VEC4 }
+};
+#define TYPE_NAME_COUNT (sizeof(type_names) / sizeof(type_names[0]))
+
+static const char* const layout_names[GLSL_MEMORY_LAYOUT_MAX] = { [GLSL_SCALAR] = "scalar", [GLSL_STD430] = "std430", [GLSL_STD140] = "std140" };
+
+/* qualifiers which may precede a member or a block declaration and don't affect the analysis */
+static const char* const skipped_qualifiers[] =
+{
+	"highp", "mediump", "lowp", "readonly", "writeonly", "coherent", "volatile", "restrict", "flat", "const", "shared", "packed", "invariant", "precise"
+};
+
+/* ---------------------- tokenizer ---------------------- */
+
+typedef enum token_kind_t
+{
+	TOKEN_END,
+	TOKEN_IDENTIFIER,
+	TOKEN_NUMBER,
+	TOKEN_PUNCTUATOR
+} token_kind_t;
+
+typedef struct token_t
+{
+	token_kind_t kind;
+	const char* start;
+	u32 length;
+	u32 line;
+} token_t;
+
+/* an integer #define or global constant */
+typedef struct define_t
+{
+	char* name;
+	s64 value;
+} define_t;
+
+/* what the qualifiers of a declaration (or a member) say */
+typedef struct qualifiers_t
+{
+	bool is_row_major;
+	bool is_push_constant;
+	/* GLSL_MEMORY_LAYOUT_MAX if none of std140, std430 and scalar is declared */
+	glsl_memory_layout_t layout;
+} qualifiers_t;
+
+/* a struct or block declaration, its members and names are owned by it */
+typedef struct declaration_t
+{
+	glsl_struct_desc_t desc;
+	u32 member_capacity;
+	bool is_block;
+	/* false if the declaration has an error, it is neither analysed nor usable as a member type */
+	bool is_valid;
+	/* layout of a block, declared or the default of its kind */
+	glsl_memory_layout_t layout;
+	/* true if the layout is declared by the layout qualifiers */
+	bool is_layout_declared;
+	u32 line;
+} declaration_t;
+
+typedef struct parser_t
+{
+	const char* path;
+	const char* cursor;
+	u32 line;
+	/* end of the last preprocessor line which has been parsed, so peeking past a directive doesn't record it twice */
+	const char* directive_end;
+	declaration_t** declarations;
+	u32 declaration_count;
+	u32 declaration_capacity;
+	define_t* defines;
+	u32 define_count;
+	u32 define_capacity;
+	bool has_error;
+} parser_t;
+
+static bool is_identifier_start(char c) { return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '_'); }
+static bool is_digit(char c) { return (c >= '0') && (c <= '9'); }
+
+static char* copy_string(const char* str, u32 length)
+{
+	char* copy = malloc(length + 1);
+	if(copy == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for a name");
+		return NULL;
+	}
+	memcpy(copy, str, length);
+	copy[length] = 0;
+	return copy;
+}
+
+static bool token_equals(const token_t* token, const char* str)
+{
+	return (token->kind != TOKEN_END) && (strlen(str) == token->length) && (memcmp(token->start, str, token->length) == 0);
+}
+
+static void parse_error(parser_t* parser, u32 line, const char* message, const token_t* token)
+{
+	if(token != NULL)
+		debug_log_error("[GLSLCommon] %s:%u: %s near \"%.*s\"", parser->path, line, message, (int)token->length, token->start);
+	else
+		debug_log_error("[GLSLCommon] %s:%u: %s", parser->path, line, message);
+	parser->has_error = true;
+}
+
+static void add_define(parser_t* parser, const char* name, u32 name_length, s64 value)
+{
+	if(parser->define_count == parser->define_capacity)
+	{
+		u32 capacity = (parser->define_capacity == 0) ? 16 : (parser->define_capacity * 2);
+		define_t* defines = realloc(parser->defines, sizeof(define_t) * capacity);
+		if(defines == NULL)
+		{
+			debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for defines");
+			return;
+		}
+		parser->defines = defines;
+		parser->define_capacity = capacity;
+	}
+	parser->defines[parser->define_count++] = (define_t) { copy_string(name, name_length), value };
+}
+
+/* the last definition wins */
+static const define_t* find_define(const parser_t* parser, const token_t* name)
+{
+	for(u32 i = parser->define_count; i > 0; i--)
+		if(token_equals(name, parser->defines[i - 1].name))
+			return &parser->defines[i - 1];
+	return NULL;
+}
+
+static token_t next_token(parser_t* parser);
+static bool parse_expression(parser_t* parser, u32 min_precedence, s64* out_value);
+
+/* records '#define NAME <integer constant expression>', every other preprocessor line is ignored */
+static void parse_directive(parser_t* parser, const char* begin, const char* end)
+{
+	const char* p = begin + 1;
+	while((p < end) && ((*p == ' ') || (*p == '\t')))
+		p++;
+	if(((end - p) < 7) || (strncmp(p, "define", 6) != 0) || ((p[6] != ' ') && (p[6] != '\t')))
+		return;
+	p += 7;
+	while((p < end) && ((*p == ' ') || (*p == '\t')))
+		p++;
+	const char* name = p;
+	while((p < end) && (is_identifier_start(*p) || is_digit(*p)))
+		p++;
+	u32 name_length = (u32)(p - name);
+	/* function-like macros aren't constants */
+	if((name_length == 0) || (p == end) || (*p == '('))
+		return;
+
+	/* the value is parsed by a parser of its own which shares the defines, its directive_end keeps it from ever recording one */
+	char* value_source = copy_string(p, (u32)(end - p));
+	if(value_source == NULL)
+		return;
+	parser_t value_parser = *parser;
+	value_parser.cursor = value_source;
+	value_parser.directive_end = value_source + (end - p);
+	s64 value;
+	if(parse_expression(&value_parser, 1, &value) && (next_token(&value_parser).kind == TOKEN_END))
+		add_define(parser, name, name_length, value);
+	free(value_source);
+}
+
+static token_t next_token(parser_t* parser)
+{
+	const char* p = parser->cursor;
+	for(;;)
+	{
+		while((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n'))
+		{
+			if(*p == '\n')
+				parser->line++;
+			p++;
+		}
+		if((p[0] == '/') && (p[1] == '/'))
+		{
+			while((*p != 0) && (*p != '\n'))
+				p++;
+		}
+		else if((p[0] == '/') && (p[1] == '*'))
+		{
+			p += 2;
+			while((*p != 0) && !((p[0] == '*') && (p[1] == '/')))
+			{
+				if(*p == '\n')
+					parser->line++;
+				p++;
+			}
+			if(*p != 0)
+				p += 2;
+		}
+		else if(*p == '#')
+		{
+			const char* begin = p;
+			while((*p != 0) && (*p != '\n'))
+				p++;
+			if(begin >= parser->directive_end)
+			{
+				parse_directive(parser, begin, p);
+				parser->directive_end = p;
+			}
+		}
+		else
+			break;
+	}
+
+	token_t token = { TOKEN_END, p, 0, parser->line };
+	if(is_identifier_start(*p))
+	{
+		while(is_identifier_start(*p) || is_digit(*p))
+			p++;
+		token.kind = TOKEN_IDENTIFIER;
+	}
+	else if(is_digit(*p))
+	{
+		while(is_identifier_start(*p) || is_digit(*p))
+			p++;
+		token.kind = TOKEN_NUMBER;
+	}
+	else if(*p != 0)
+	{
+		p++;
+		token.kind = TOKEN_PUNCTUATOR;
+	}
+	token.length = (u32)(p - token.start);
+	parser->cursor = p;
+	return token;
+}
+
+static token_t peek_token(parser_t* parser)
+{
+	const char* cursor = parser->cursor;
+	u32 line = parser->line;
+	token_t token = next_token(parser);
+	parser->cursor = cursor;
+	parser->line = line;
+	return token;
+}
+
+/* ---------------------- constant expressions ---------------------- */
+
+/* values of constant expressions are 32 bit, signed or unsigned */
+#define CONSTANT_MIN (-(s64)0x80000000)
+#define CONSTANT_MAX ((s64)0xffffffff)
+
+/* decimal, octal or hexadecimal integer literal with an optional 'u' suffix */
+static bool parse_number(const token_t* token, s64* out_value)
+{
+	char* end;
+	unsigned long long value = strtoull(token->start, &end, 0);
+	if((end < (token->start + token->length)) && ((*end == 'u') || (*end == 'U')))
+		end++;
+	if((end != (token->start + token->length)) || (value > (unsigned long long)CONSTANT_MAX))
+		return false;
+	*out_value = (s64)value;
+	return true;
+}
+
+/* returns the precedence of the binary operator which is the next token (higher binds tighter), 0 if it isn't one */
+static u32 peek_binary_operator(parser_t* parser)
+{
+	token_t token = peek_token(parser);
+	if(token.kind != TOKEN_PUNCTUATOR)
+		return 0;
+	char c = token.start[0];
+	switch(c)
+	{
+		/* '||', '^^' and '&&' are logical operators */
+		case '|': return (token.start[1] == c) ? 0 : 1;
+		case '^': return (token.start[1] == c) ? 0 : 2;
+		case '&': return (token.start[1] == c) ? 0 : 3;
+		/* only '<<' and '>>', the punctuators are single characters */
+		case '<':
+		case '>': return (token.start[1] == c) ? 4 : 0;
+		case '+':
+		case '-': return 5;
+		case '*':
+		case '/':
+		case '%': return 6;
+		default: return 0;
+	}
+}
+
+static bool apply_binary_operator(char symbol, s64 lhs, s64 rhs, s64* out_value)
+{
+	s64 value;
+	switch(symbol)
+	{
+		case '|': value = lhs | rhs; break;
+		case '^': value = lhs ^ rhs; break;
+		case '&': value = lhs & rhs; break;
+		case '<':
+		case '>':
+		{
+			if((rhs < 0) || (rhs > 31))
+				return false;
+			value = (symbol == '<') ? (s64)((u64)lhs << rhs) : (lhs >> rhs);
+			break;
+		}
+		case '+': value = lhs + rhs; break;
+		case '-': value = lhs - rhs; break;
+		case '*':
+		{
+			/* both operands fit in 33 bits, their product may not fit in 64 */
+			if((lhs != 0) && (llabs(rhs) > (CONSTANT_MAX / llabs(lhs))))
+				return false;
+			value = lhs * rhs;
+			break;
+		}
+		case '/':
+		case '%':
+		{
+			if(rhs == 0)
+				return false;
+			value = (symbol == '/') ? (lhs / rhs) : (lhs % rhs);
+			break;
+		}
+		default: return false;
+	}
+	*out_value = value;
+	return (value >= CONSTANT_MIN) && (value <= CONSTANT_MAX);
+}
+
+/* literal, #define or constant, parenthesized expression, or unary + - ~ applied to one of those */
+static bool parse_operand(parser_t* parser, s64* out_value)
+{
+	token_t token = peek_token(parser);
+	if(token_equals(&token, "("))
+	{
+		next_token(parser);
+		if(!parse_expression(parser, 1, out_value))
+			return false;
+		token_t close = peek_token(parser);
+		if(!token_equals(&close, ")"))
+			return false;
+		next_token(parser);
+		return true;
+	}
+	if(token_equals(&token, "-") || token_equals(&token, "+") || token_equals(&token, "~"))
+	{
+		next_token(parser);
+		s64 value;
+		if(!parse_operand(parser, &value))
+			return false;
+		*out_value = (token.start[0] == '-') ? -value : ((token.start[0] == '~') ? ~value : value);
+		return (*out_value >= CONSTANT_MIN) && (*out_value <= CONSTANT_MAX);
+	}
+	if(token.kind == TOKEN_NUMBER)
+	{
+		if(!parse_number(&token, out_value))
+			return false;
+		next_token(parser);
+		return true;
+	}
+	const define_t* define = (token.kind == TOKEN_IDENTIFIER) ? find_define(parser, &token) : NULL;
+	if(define == NULL)
+		return false;
+	next_token(parser);
+	*out_value = define->value;
+	return true;
+}
+
+/* parses an integer constant expression (operators of 'min_precedence' and higher), returns false if the next tokens aren't one
+ * or its value doesn't fit in 32 bits; the token it fails at isn't consumed, so a caller can resume from it */
+static bool parse_expression(parser_t* parser, u32 min_precedence, s64* out_value)
+{
+	s64 value;
+	if(!parse_operand(parser, &value))
+		return false;
+	for(;;)
+	{
+		u32 precedence = peek_binary_operator(parser);
+		if((precedence == 0) || (precedence < min_precedence))
+			break;
+		token_t symbol = next_token(parser);
+		/* the second character of a shift */
+		if(precedence == 4)
+			next_token(parser);
+		s64 rhs;
+		if(!parse_expression(parser, precedence + 1, &rhs) || !apply_binary_operator(symbol.start[0], value, rhs, &value))
+			return false;
+	}
+	*out_value = value;
+	return true;
+}
+
+/* ---------------------- qualifiers ---------------------- */
+
+/* skips the rest of 'layout(...)', the opening parenthesis has already been consumed;
+ * row_major, column_major, push_constant, std140, std430 and scalar are recorded in 'qualifiers' */
+static void parse_layout_qualifiers(parser_t* parser, qualifiers_t* qualifiers)
+{
+	u32 depth = 1;
+	while(depth > 0)
+	{
+		token_t token = next_token(parser);
+		if(token.kind == TOKEN_END)
+			return;
+		if(token_equals(&token, "("))
+			depth++;
+		else if(token_equals(&token, ")"))
+			depth--;
+		else if(token_equals(&token, "row_major"))
+			qualifiers->is_row_major = true;
+		else if(token_equals(&token, "column_major"))
+			qualifiers->is_row_major = false;
+		else if(token_equals(&token, "push_constant"))
+			qualifiers->is_push_constant = true;
+		else if(token_equals(&token, "std140"))
+			qualifiers->layout = GLSL_STD140;
+		else if(token_equals(&token, "std430"))
+			qualifiers->layout = GLSL_STD430;
+		else if(token_equals(&token, "scalar"))
+			qualifiers->layout = GLSL_SCALAR;
+	}
+}
+
+/* skips 'layout(...)' and the qualifiers which don't matter here, returns the first token after them;
+ * qualifiers: keeps its values unless the layout qualifiers say otherwise */
+static token_t next_token_skip_qualifiers(parser_t* parser, qualifiers_t* qualifiers)
+{
+	for(;;)
+	{
+		token_t token = next_token(parser);
+		if(token_equals(&token, "layout"))
+		{
+			token_t open = next_token(parser);
+			if(token_equals(&open, "("))
+				parse_layout_qualifiers(parser, qualifiers);
+			continue;
+		}
+		bool is_qualifier = false;
+		for(u32 i = 0; (i < (sizeof(skipped_qualifiers) / sizeof(skipped_qualifiers[0]))) && !is_qualifier; i++)
+			is_qualifier = token_equals(&token, skipped_qualifiers[i]);
+		if(!is_qualifier)
+			return token;
+	}
+}
+
+/* ---------------------- declarations ---------------------- */
+
+static void declaration_destroy(declaration_t* declaration)
+{
+	for(u32 i = 0; i < declaration->desc.member_count; i++)
+		free((char*)declaration->desc.members[i].name);
+	free((glsl_member_desc_t*)declaration->desc.members);
+	free((char*)declaration->desc.name);
+	free(declaration);
+}
+
+static const declaration_t* find_struct(const parser_t* parser, const token_t* name)
+{
+	for(u32 i = 0; i < parser->declaration_count; i++)
+	{
+		const declaration_t* declaration = parser->declarations[i];
+		if(!declaration->is_block && token_equals(name, declaration->desc.name))
+			return declaration;
+	}
+	return NULL;
+}
+
+static glsl_type_t find_type(const token_t* name)
+{
+	for(u32 i = 0; i < TYPE_NAME_COUNT; i++)
+		if(token_equals(name, type_names[i].name))
+			return type_names[i].type;
+	return GLSL_TYPE_UNDEFINED;
+}
+
+static const char* get_type_name(glsl_type_t type)
+{
+	for(u32 i = 0; i < TYPE_NAME_COUNT; i++)
+		if(type_names[i].type == type)
+			return type_names[i].name;
+	return "?";
+}
+
+/* parses '[N]...' after a member name, an unsized (runtime) array is analysed as one element */
+static bool parse_array_dimensions(parser_t* parser, glsl_member_desc_t* member)
+{
+	for(;;)
+	{
+		token_t open = peek_token(parser);
+		if(!token_equals(&open, "["))
+			break;
+		next_token(parser);
+		token_t length = peek_token(parser);
+		if(token_equals(&length, "]"))
+		{
+			next_token(parser);
+			if(member->array_dimension_count < GLSL_MAX_ARRAY_DIMENSIONS)
+				member->array_lengths[member->array_dimension_count++] = 1;
+			continue;
+		}
+		s64 value;
+		if(!parse_expression(parser, 1, &value))
+		{
+			parse_error(parser, length.line, "Array length is not an integer constant expression", &length);
+			return false;
+		}
+		token_t close = peek_token(parser);
+		if(!token_equals(&close, "]"))
+		{
+			parse_error(parser, close.line, "Expected ']' after an array length", &close);
+			return false;
+		}
+		next_token(parser);
+		if((value <= 0) || (member->array_dimension_count == GLSL_MAX_ARRAY_DIMENSIONS))
+		{
+			parse_error(parser, length.line, "Invalid array dimension", &length);
+			return false;
+		}
+		member->array_lengths[member->array_dimension_count++] = (u32)value;
+	}
+	return true;
+}
+
+/* skips the rest of the member (or declaration) a parse error is in, returns the ';' or '}' (outside of any nested braces) which ends it */
+static token_t skip_to_recovery_point(parser_t* parser)
+{
+	u32 depth = 0;
+	for(;;)
+	{
+		token_t token = next_token(parser);
+		if(token.kind == TOKEN_END)
+			return token;
+		if(token_equals(&token, "{"))
+			depth++;
+		else if(token_equals(&token, "}"))
+		{
+			if(depth == 0)
+				return token;
+			depth--;
+		}
+		else if(token_equals(&token, ";") && (depth == 0))
+			return token;
+	}
+}
+
+static bool add_member(declaration_t* declaration, const glsl_member_desc_t* member)
+{
+	if(declaration->desc.member_count == declaration->member_capacity)
+	{
+		u32 capacity = (declaration->member_capacity == 0) ? 8 : (declaration->member_capacity * 2);
+		glsl_member_desc_t* members = realloc((glsl_member_desc_t*)declaration->desc.members, sizeof(glsl_member_desc_t) * capacity);
+		if(members == NULL)
+		{
+			debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for members");
+			return false;
+		}
+		declaration->desc.members = members;
+		declaration->member_capacity = capacity;
+	}
+	((glsl_member_desc_t*)declaration->desc.members)[declaration->desc.member_count++] = *member;
+	return true;
+}
+
+/* parses the declarators of a member after its type 'type_token', up to and including the ';'; 'float a, b[2];' declares two members of the same type;
+ * returns false on a parse error, which is left at (or right after) the token it occurred at */
+static bool parse_member(parser_t* parser, declaration_t* declaration, const token_t* type_token, bool is_row_major)
+{
+	glsl_member_desc_t member = { 0 };
+	member.is_row_major = is_row_major;
+	member.type = find_type(type_token);
+	if(member.type == GLSL_TYPE_UNDEFINED)
+	{
+		const declaration_t* struct_declaration = find_struct(parser, type_token);
+		if(struct_declaration == NULL)
+		{
+			parse_error(parser, type_token->line, "Unknown member type", type_token);
+			return false;
+		}
+		if(!struct_declaration->is_valid)
+		{
+			parse_error(parser, type_token->line, "Member type is a struct with errors", type_token);
+			return false;
+		}
+		member.struct_desc = &struct_declaration->desc;
+	}
+	for(;;)
+	{
+		token_t name = peek_token(parser);
+		if(name.kind != TOKEN_IDENTIFIER)
+		{
+			parse_error(parser, name.line, "Expected a member name", &name);
+			return false;
+		}
+		next_token(parser);
+		glsl_member_desc_t declarator = member;
+		if(!parse_array_dimensions(parser, &declarator))
+			return false;
+		declarator.name = copy_string(name.start, name.length);
+		if(!add_member(declaration, &declarator))
+		{
+			free((char*)declarator.name);
+			return false;
+		}
+		token_t separator = peek_token(parser);
+		if(!token_equals(&separator, ";") && !token_equals(&separator, ","))
+		{
+			parse_error(parser, separator.line, "Expected ';' after a member", &separator);
+			return false;
+		}
+		next_token(parser);
+		if(token_equals(&separator, ";"))
+			return true;
+	}
+}
+
+/* parses '{ members } [instance name [dimensions]] ;' after 'struct Name' or 'uniform Name',
+ * is_row_major: matrix order of the members which don't declare one, from the layout qualifiers of a block;
+ * a member with an error is skipped up to its ';' and makes the declaration invalid, returns false if the file ends within the declaration */
+static bool parse_declaration_body(parser_t* parser, declaration_t* declaration, bool is_row_major)
+{
+	declaration->is_valid = true;
+	for(;;)
+	{
+		qualifiers_t qualifiers = { is_row_major, false, GLSL_MEMORY_LAYOUT_MAX };
+		token_t token = next_token_skip_qualifiers(parser, &qualifiers);
+		if(token_equals(&token, "}"))
+			break;
+		if(token.kind == TOKEN_END)
+		{
+			parse_error(parser, declaration->line, "Unterminated declaration", NULL);
+			declaration->is_valid = false;
+			return false;
+		}
+		/* a stray ';' declares nothing */
+		if(token_equals(&token, ";") || parse_member(parser, declaration, &token, qualifiers.is_row_major))
+			continue;
+		declaration->is_valid = false;
+		token_t end = skip_to_recovery_point(parser);
+		if(end.kind == TOKEN_END)
+			return false;
+		if(token_equals(&end, "}"))
+			break;
+	}
+	if(declaration->is_valid && (declaration->desc.member_count == 0))
+	{
+		parse_error(parser, declaration->line, "Empty declaration", NULL);
+		declaration->is_valid = false;
+	}
+	/* optional instance name (with dimensions, which don't change the layout of the block),
+	 * an identifier followed by anything else is left alone, it likely starts the next declaration after a missing ';' */
+	const char* cursor = parser->cursor;
+	u32 line = parser->line;
+	token_t token = next_token(parser);
+	token_t next = peek_token(parser);
+	if((token.kind == TOKEN_IDENTIFIER) && (token_equals(&next, ";") || token_equals(&next, "[")))
+	{
+		glsl_member_desc_t instance = { 0 };
+		if(!parse_array_dimensions(parser, &instance))
+			return skip_to_recovery_point(parser).kind != TOKEN_END;
+		token = peek_token(parser);
+	}
+	else
+	{
+		parser->cursor = cursor;
+		parser->line = line;
+	}
+	if(!token_equals(&token, ";"))
+	{
+		/* the token is left for the caller, it may well start the next declaration */
+		parse_error(parser, token.line, "Expected ';' after a declaration", &token);
+		return true;
+	}
+	next_token(parser);
+	return true;
+}
+
+static bool add_declaration(parser_t* parser, declaration_t* declaration)
+{
+	if(parser->declaration_count == parser->declaration_capacity)
+	{
+		u32 capacity = (parser->declaration_capacity == 0) ? 16 : (parser->declaration_capacity * 2);
+		declaration_t** declarations = realloc(parser->declarations, sizeof(declaration_t*) * capacity);
+		if(declarations == NULL)
+		{
+			debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for declarations");
+			return false;
+		}
+		parser->declarations = declarations;
+		parser->declaration_capacity = capacity;
+	}
+	parser->declarations[parser->declaration_count++] = declaration;
+	return true;
+}
+
+/* records 'const int NAME = <integer constant expression>;' (or uint) at global scope, 'type' has been consumed and the qualifiers before it skipped;
+ * anything else is left to the caller to skip */
+static void parse_constant(parser_t* parser)
+{
+	token_t name = peek_token(parser);
+	if(name.kind != TOKEN_IDENTIFIER)
+		return;
+	next_token(parser);
+	token_t assign = peek_token(parser);
+	if(!token_equals(&assign, "="))
+		return;
+	next_token(parser);
+	s64 value;
+	if(!parse_expression(parser, 1, &value))
+		return;
+	token_t end = peek_token(parser);
+	if(token_equals(&end, ";"))
+		add_define(parser, name.start, name.length, value);
+}
+
+/* collects every struct and block declared at global scope, everything else is skipped by brace depth;
+ * a declaration with an error is kept (invalid) and parsing goes on after it */
+static void parse_file(parser_t* parser)
+{
+	u32 depth = 0;
+	for(;;)
+	{
+		qualifiers_t qualifiers = { false, false, GLSL_MEMORY_LAYOUT_MAX };
+		token_t token = (depth == 0) ? next_token_skip_qualifiers(parser, &qualifiers) : next_token(parser);
+		if(token.kind == TOKEN_END)
+			break;
+		if(token_equals(&token, "{"))
+			depth++;
+		else if(token_equals(&token, "}"))
+			depth -= (depth > 0) ? 1 : 0;
+		if((depth > 0) || (token.kind != TOKEN_IDENTIFIER))
+			continue;
+
+		if(token_equals(&token, "int") || token_equals(&token, "uint"))
+		{
+			parse_constant(parser);
+			continue;
+		}
+		bool is_struct = token_equals(&token, "struct");
+		bool is_uniform = token_equals(&token, "uniform") || token_equals(&token, "block");
+		bool is_buffer = token_equals(&token, "buffer");
+		if(!is_struct && !is_uniform && !is_buffer)
+			continue;
+		/* 'uniform sampler2D albedo;' and the like are not blocks */
+		token_t name = next_token(parser);
+		token_t open = peek_token(parser);
+		if((name.kind != TOKEN_IDENTIFIER) || !token_equals(&open, "{"))
+			continue;
+		next_token(parser);
+
+		declaration_t* declaration = calloc(1, sizeof(declaration_t));
+		if(declaration == NULL)
+		{
+			debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for a declaration");
+			return;
+		}
+		declaration->desc.name = copy_string(name.start, name.length);
+		declaration->is_block = !is_struct;
+		declaration->line = name.line;
+		declaration->is_layout_declared = qualifiers.layout != GLSL_MEMORY_LAYOUT_MAX;
+		if(declaration->is_layout_declared)
+			declaration->layout = qualifiers.layout;
+		else
+			declaration->layout = (is_buffer || qualifiers.is_push_constant) ? GLSL_STD430 : GLSL_STD140;
+		bool is_complete = parse_declaration_body(parser, declaration, declaration->is_block && qualifiers.is_row_major);
+		if(!add_declaration(parser, declaration))
+		{
+			declaration_destroy(declaration);
+			return;
+		}
+		if(!is_complete)
+			break;
+	}
+}
+
+/* ---------------------- analysis ---------------------- */
+
+/* one block under its declared layout, for the ranking */
+typedef struct block_report_t
+{
+	char* location;
+	glsl_memory_layout_t layout;
+	u32 size;
+	u32 padding;
+	u32 reordered_size;
+} block_report_t;
+
+typedef struct report_list_t
+{
+	block_report_t* reports;
+	u32 count;
+	u32 capacity;
+} report_list_t;
+
+static u32 get_element_count(const glsl_layout_node_t* node)
+{
+	u32 count = 1;
+	for(u32 i = 0; i < node->array_dimension_count; i++)
+		count *= node->array_lengths[i];
+	return count;
+}
+
+/* bytes of actual data in a node, i.e. its tightly packed (scalar) size without any padding */
+static u32 get_payload_size(const glsl_layout_node_t* node)
+{
+	u32 element_size = 0;
+	if(node->child_count > 0)
+	{
+		for(u32 i = 0; i < node->child_count; i++)
+			element_size += get_payload_size(&node->children[i]);
+	}
+	else
+		element_size = sizeof_glsl_type(node->type, GLSL_SCALAR);
+	return element_size * get_element_count(node);
+}
+
+/* padded size of the block if its (top level) members were reordered, arrays of arrays are flattened as they are laid out the same */
+static u32 get_reordered_size(const glsl_layout_tree_t* tree)
+{
+	const glsl_layout_node_t* root = &tree->root;
+	glsl_type_layout_traits_t* traits = calloc(root->child_count, sizeof(glsl_type_layout_traits_t) + sizeof(u32));
+	if(traits == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for member traits");
+		return 0;
+	}
+	u32* order = (u32*)(traits + root->child_count);
+	for(u32 i = 0; i < root->child_count; i++)
+	{
+		const glsl_layout_node_t* node = &root->children[i];
+		traits[i].type = node->type;
+		traits[i].is_array = node->array_dimension_count > 0;
+		traits[i].array_length = get_element_count(node);
+		traits[i].is_row_major = node->is_row_major;
+		if(node->type == GLSL_TYPE_UNDEFINED)
+		{
+			traits[i].align = node->align;
+			traits[i].size = node->element_size;
+		}
+	}
+	u32 size = glsl_optimize_member_order(traits, root->child_count, tree->layout, order, NULL).size;
+	free(traits);
+	return size;
+}
+
+static void print_node(const glsl_layout_node_t* node, u32 base_offset, u32 depth)
+{
+	char type[MAX_TOKEN_LENGTH + GLSL_MAX_ARRAY_DIMENSIONS * 12];
+	int length = snprintf(type, sizeof(type), "%s%s", (node->is_row_major && (columnsof_glsl_type(node->type) > 1)) ? "row_major " : "", (node->type == GLSL_TYPE_UNDEFINED) ? "struct" : get_type_name(node->type));
+	for(u32 i = 0; (i < node->array_dimension_count) && (length > 0) && ((size_t)length < sizeof(type)); i++)
+		length += snprintf(type + length, sizeof(type) - (size_t)length, "[%u]", node->array_lengths[i]);
+	u32 offset = base_offset + node->offset;
+	if(node->array_dimension_count > 0)
+		printf("    %8u %8u %6u %8u  %*s%s %s\n", offset, node->size, node->align, node->array_strides[0], (int)(depth * 2), "", type, node->name);
+	else
+		printf("    %8u %8u %6u %8s  %*s%s %s\n", offset, node->size, node->align, "-", (int)(depth * 2), "", type, node->name);
+	/* the members of a struct are listed once, for its first element */
+	for(u32 i = 0; i < node->child_count; i++)
+		print_node(&node->children[i], offset, depth + 1);
+}
+
+static bool add_report(report_list_t* list, const char* path, const char* name, glsl_memory_layout_t layout, u32 size, u32 padding, u32 reordered_size)
+{
+	if(list->count == list->capacity)
+	{
+		u32 capacity = (list->capacity == 0) ? 64 : (list->capacity * 2);
+		block_report_t* reports = realloc(list->reports, sizeof(block_report_t) * capacity);
+		if(reports == NULL)
+		{
+			debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for block reports");
+			return false;
+		}
+		list->reports = reports;
+		list->capacity = capacity;
+	}
+	size_t length = strlen(path) + strlen(name) + 2;
+	char* location = malloc(length);
+	if(location == NULL)
+	{
+		debug_log_fetal_error("[GLSLCommon] Failed to allocate memory for a block report");
+		return false;
+	}
+	snprintf(location, length, "%s:%s", path, name);
+	list->reports[list->count++] = (block_report_t) { location, layout, size, padding, reordered_size };
+	return true;
+}
+
+/* prints the size, padding and fingerprint of a block under one layout, and the offset, size, alignment and array stride of every member */
+static void print_layout(const glsl_layout_tree_t* tree, const char* label, u32 padding, u32 reordered_size)
+{
+	u32 size = tree->root.size;
+	printf("  %s: size %u, align %u, padding %u bytes (%.1f%%)", label, size, tree->root.align, padding, (size > 0) ? (100.0 * padding / size) : 0.0);
+	if(reordered_size < size)
+		printf(", %u bytes if reordered", reordered_size);
+	printf(", fingerprint %016llx\n", (unsigned long long)tree->root.fingerprint);
+	printf("    %8s %8s %6s %8s  %s\n", "offset", "size", "align", "stride", "member");
+	for(u32 i = 0; i < tree->root.child_count; i++)
+		print_node(&tree->root.children[i], 0, 0);
+}
+
+/* analyses every valid block of 'path' under its declared layout (or 'forced_layout' unless it is GLSL_MEMORY_LAYOUT_MAX), which is what is ranked,
+ * then under the other layouts, which are printed the same way; returns false if the file couldn't be analysed or has errors */
+static bool analyse_file(const char* path, glsl_memory_layout_t forced_layout, bool is_summary, report_list_t* reports)
+{
+	FILE* file = fopen(path, "rb");
+	if(file == NULL)
+	{
+		debug_log_error("[GLSLCommon] Failed to open %s", path);
+		return false;
+	}
+	fseek(file, 0, SEEK_END);
+	long file_size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	char* source = (file_size >= 0) ? malloc((size_t)file_size + 1) : NULL;
+	if(source == NULL)
+	{
+		debug_log_error("[GLSLCommon] Failed to read %s", path);
+		fclose(file);
+		return false;
+	}
+	size_t read_size = fread(source, 1, (size_t)file_size, file);
+	source[read_size] = 0;
+	fclose(file);
+
+	parser_t parser = { .path = path, .cursor = source, .line = 1, .directive_end = source };
+	parse_file(&parser);
+
+	/* the layout trees of the file all live in one arena, released at once when the file is done */
+	glsl_arena_t* arena = glsl_arena_create(64 * 1024);
+	glsl_allocator_t allocator = glsl_arena_get_allocator(arena);
+	/* blocks with errors have been reported by the parser, every other block is still analysed */
+	for(u32 i = 0; i < parser.declaration_count; i++)
+	{
+		const declaration_t* declaration = parser.declarations[i];
+		if(!declaration->is_block || !declaration->is_valid)
+			continue;
+		glsl_memory_layout_t block_layout = (forced_layout == GLSL_MEMORY_LAYOUT_MAX) ? declaration->layout : forced_layout;
+		glsl_layout_tree_t* tree = glsl_layout_tree_create(&declaration->desc, block_layout, &allocator);
+		if(tree == NULL)
+		{
+			parse_error(&parser, declaration->line, "Invalid block", NULL);
+			continue;
+		}
+		if(!is_summary)
+			printf("%s:%u: block %s, %s%s\n", path, declaration->line, declaration->desc.name, layout_names[block_layout],
+				(forced_layout != GLSL_MEMORY_LAYOUT_MAX) ? " (--layout)" : (declaration->is_layout_declared ? " (declared)" : " (default)"));
+		u32 padding = tree->root.size - get_payload_size(&tree->root);
+		u32 reordered_size = get_reordered_size(tree);
+		add_report(reports, path, declaration->desc.name, block_layout, tree->root.size, padding, reordered_size);
+		if(is_summary)
+			continue;
+		print_layout(tree, layout_names[block_layout], padding, reordered_size);
+
+		/* the other layouts, for comparison only, they aren't ranked */
+		for(u32 layout = 0; layout < GLSL_MEMORY_LAYOUT_MAX; layout++)
+		{
+			if(layout == (u32)block_layout)
+				continue;
+			glsl_layout_tree_t* other_tree = glsl_layout_tree_create(&declaration->desc, (glsl_memory_layout_t)layout, &allocator);
+			if(other_tree == NULL)
+				continue;
+			char label[32];
+			snprintf(label, sizeof(label), "as %s", layout_names[layout]);
+			print_layout(other_tree, label, other_tree->root.size - get_payload_size(&other_tree->root), get_reordered_size(other_tree));
+		}
+	}
+	glsl_arena_destroy(arena);
+
+	for(u32 i = 0; i < parser.declaration_count; i++)
+		declaration_destroy(parser.declarations[i]);
+	free(parser.declarations);
+	for(u32 i = 0; i < parser.define_count; i++)
+		free(parser.defines[i].name);
+	free(parser.defines);
+	free(source);
+	return !parser.has_error;
+}
+
+/* most padding bytes first, then the largest blocks */
+static int compare_reports(const void* a, const void* b)
+{
+	const block_report_t* report_a = a;
+	const block_report_t* report_b = b;
+	if(report_a->padding != report_b->padding)
+		return (report_a->padding > report_b->padding) ? -1 : 1;
+	if(report_a->size != report_b->size)
+		return (report_a->size > report_b->size) ? -1 : 1;
+	return strcmp(report_a->location, report_b->location);
+}
+
+static void print_usage(void)
+{
+	printf("usage: main [--layout scalar|std140|std430] [--top <count>] [--summary] <file>...\n");
+}
 
 int main(int argc, char** argv)
 {
-	debug_log_info("GLSLCommon Repository!");
+	glsl_memory_layout_t forced_layout = GLSL_MEMORY_LAYOUT_MAX;
+	u32 top_count = 10;
+	bool is_summary = false;
+	u32 file_count = 0;
+	for(int i = 1; i < argc; i++)
+	{
+		if((strcmp(argv[i], "--layout") == 0) && ((i + 1) < argc))
+		{
+			const char* name = argv[++i];
+			forced_layout = GLSL_MEMORY_LAYOUT_MAX;
+			for(u32 layout = 0; layout < GLSL_MEMORY_LAYOUT_MAX; layout++)
+				if(strcmp(name, layout_names[layout]) == 0)
+					forced_layout = (glsl_memory_layout_t)layout;
+			if(forced_layout == GLSL_MEMORY_LAYOUT_MAX)
+			{
+				debug_log_error("[GLSLCommon] Unknown layout %s", name);
+				return 2;
+			}
+		}
+		else if((strcmp(argv[i], "--top") == 0) && ((i + 1) < argc))
+			top_count = (u32)strtoul(argv[++i], NULL, 10);
+		else if(strcmp(argv[i], "--summary") == 0)
+			is_summary = true;
+		else if((argv[i][0] == '-') && (argv[i][1] == '-'))
+		{
+			print_usage();
+			return 2;
+		}
+		else
+			file_count++;
+	}
+	if(file_count == 0)
+	{
+		print_usage();
+		return 2;
+	}
+
+	report_list_t reports = { 0 };
+	u32 failed_count = 0;
+	for(int i = 1; i < argc; i++)
+	{
+		/* skip the options and their values */
+		if((strcmp(argv[i], "--layout") == 0) || (strcmp(argv[i], "--top") == 0))
+		{
+			i++;
+			continue;
+		}
+		if(strcmp(argv[i], "--summary") == 0)
+			continue;
+		if(!analyse_file(argv[i], forced_layout, is_summary, &reports))
+			failed_count++;
+	}
+
+	if(reports.count > 0)
+		qsort(reports.reports, reports.count, sizeof(block_report_t), compare_reports);
+	u32 print_count = (top_count < reports.count) ? top_count : reports.count;
+	u64 total_size = 0;
+	u64 total_padding = 0;
+	for(u32 i = 0; i < reports.count; i++)
+	{
+		total_size += reports.reports[i].size;
+		total_padding += reports.reports[i].padding;
+	}
+	printf("\n%u blocks, %llu bytes, %llu bytes of padding (%.1f%%)\n", reports.count, (unsigned long long)total_size, (unsigned long long)total_padding,
+		(total_size > 0) ? (100.0 * (f64)total_padding / (f64)total_size) : 0.0);
+	if(print_count > 0)
+	{
+		printf("top %u by padding:\n", print_count);
+		printf("  %4s %8s %7s %8s %9s  %-6s  %s\n", "rank", "padding", "wasted", "size", "reordered", "layout", "block");
+		for(u32 i = 0; i < print_count; i++)
+		{
+			const block_report_t* report = &reports.reports[i];
+			printf("  %4u %8u %6.1f%% %8u %9u  %-6s  %s\n", i + 1, report->padding, (report->size > 0) ? (100.0 * report->padding / report->size) : 0.0,
+				report->size, report->reordered_size, layout_names[report->layout], report->location);
+		}
+	}
 
-	return 0;
-}
\ No newline at end of file
+	for(u32 i = 0; i < reports.count; i++)
+		free(reports.reports[i].location);
+	free(reports.reports);
+	return (failed_count > 0) ? 1 : 0;
+}